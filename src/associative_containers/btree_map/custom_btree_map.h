@@ -0,0 +1,604 @@
+#ifndef _ASSOCIATIVE_CONTAINERS_BTREE_MAP_CUSTOM_BTREE_MAP_H_
+#define _ASSOCIATIVE_CONTAINERS_BTREE_MAP_CUSTOM_BTREE_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../../misc/custom_btree.h"
+
+namespace custom {
+
+/**
+ * @brief Container to store pairs with unique keys that is based on the
+ * B-tree. It has the interface of @code Map, but keeps tens of pairs in one
+ * node, so lookups and ordered scans touch far less memory and every pair
+ * takes a few bytes of overhead instead of the separate node. In return every
+ * insertion and erasure invalidates all the iterators and references, pairs
+ * are moved between the nodes
+ *
+ * @tparam Key type of keys of pairs
+ * @tparam T values of pairs
+ * @tparam Compare defaults to @code std::less<Key> and sorts values in
+ * ascending order, but can be also @code std::greater<Key> for storing values
+ * in descending order
+ */
+template <class Key, class T, class Compare = std::less<Key>> class BTreeMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using btree = BTree__<key_type, value_type, PairFirstElement__<value_type>,
+                        Compare>;
+  using key_compare = typename btree::key_compare;
+  using key_identify = typename btree::key_identify;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using double_reference = value_type &&;
+  using iterator = typename btree::iterator;
+  using const_iterator = typename btree::const_iterator;
+  using size_type = typename btree::size_type;
+
+  BTreeMap() = default;
+  BTreeMap(const BTreeMap &other) = default;
+  BTreeMap(BTreeMap &&other) = default;
+  ~BTreeMap() = default;
+  explicit BTreeMap(const std::initializer_list<value_type> &items)
+      : tree_(items.begin(), items.end()) {}
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  BTreeMap(InputIt first, InputIt last) : tree_(first, last) {}
+
+  BTreeMap &operator=(const BTreeMap &other) = default;
+  BTreeMap &operator=(BTreeMap &&other) = default;
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - creates new one with default
+   * constructor and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](const key_type &key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - moves the key into the new pair
+   * with default constructed value and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](key_type &&key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  /**
+   * @brief Checks if there is value with given key and returns reference to it.
+   * If there is no value with given key - throws @code std::exception()
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &at(const key_type &key) {
+    auto is_contains = tree_.find(key);
+    if (is_contains == tree_.end())
+      throw std::exception();
+    return (*is_contains).second;
+  }
+
+  /**
+   * @brief Checks if there is value with given key and returns reference to it.
+   * If there is no value with given key - throws @code std::exception()
+   *
+   * @param key key to needed value
+   * @return read only reference to the value of the pair
+   */
+  const mapped_type &at(const key_type &key) const {
+    auto is_contains = tree_.find(key);
+    if (is_contains == tree_.end())
+      throw std::exception();
+    return (*is_contains).second;
+  }
+
+  /**
+   * @brief Returns iterator to the start of the container
+   *
+   * @return read/write iterator
+   */
+  iterator begin() { return tree_.begin(); }
+
+  /**
+   * @brief Returns iterator to the start of the container
+   *
+   * @return read only iterator
+   */
+  const_iterator begin() const { return tree_.begin(); }
+
+  /**
+   * @brief Returns iterator to the past-end of the container
+   *
+   * @return read/write iterator
+   */
+  iterator end() { return tree_.end(); }
+
+  /**
+   * @brief Returns iterator to the past-end of the container
+   *
+   * @return read only iterator
+   */
+  const_iterator end() const { return tree_.end(); }
+
+  /**
+   * @brief Checks if container is empty
+   *
+   * @return true is empty
+   * @return false otherwise
+   */
+  bool empty() const { return tree_.empty(); }
+
+  /**
+   * @brief Returns current size of the container
+   *
+   */
+  size_type size() const { return tree_.size(); }
+
+  /**
+   * @brief Returns theoretical maximum container size due to OS arcitecture
+   *
+   */
+  size_type max_size() const { return tree_.max_size(); }
+
+  /**
+   * @brief Returns amount of bytes taken by the nodes of the container,
+   * without the overhead of the memory allocator
+   *
+   */
+  size_type memory_usage() const { return tree_.memory_usage(); }
+
+  /**
+   * @brief Removes all stored values from the container
+   *
+   */
+  void clear() { tree_.clear(); }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const_reference value) {
+    return tree_.insert(value);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving it into the node. If the key is
+   * already in the container, the pair is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    return tree_.insert(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &value) {
+    return try_emplace(key, value);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving the value into the node. If the key
+   * is already in the container, nothing is moved
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key, mapped_type &&value) {
+    return try_emplace(key, std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new pair by moving the key and the value into the node.
+   * If the key is already in the container, nothing is moved
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(key_type &&key, mapped_type &&value) {
+    return try_emplace(std::move(key), std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new pair using the hint. If the pair belongs right
+   * before the hint, it is placed without the search from the root, so
+   * sorted data is inserted in constant time with the @code end() hint
+   *
+   * @param hint iterator to the element that follows the place of the pair
+   * @param value what to insert
+   * @return read/write iterator to the inserted pair or to the pair with the
+   * equal key that prevented the insertion
+   */
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value);
+  }
+
+  /**
+   * @brief Inserts a new pair using the hint by moving it into the node
+   *
+   * @param hint iterator to the element that follows the place of the pair
+   * @param value what to insert
+   * @return read/write iterator to the inserted pair or to the pair with the
+   * equal key that prevented the insertion
+   */
+  iterator insert(const_iterator hint, double_reference value) {
+    return tree_.insert(hint, std::move(value));
+  }
+
+  /**
+   * @brief Inserts all the elements of the range one by one, elements with
+   * the keys that are already in the container are skipped. Sorted ranges
+   * are appended without the search from the root
+   *
+   * @param first iterator to the first element of the range
+   * @param last iterator after the last element of the range
+   * @return amount of the inserted elements
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return tree_.insert(first, last);
+  }
+
+  /**
+   * @brief Inserts all the elements of the list
+   *
+   * @param items list of the elements
+   * @return amount of the inserted elements
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return tree_.insert(items.begin(), items.end());
+  }
+
+  /**
+   * @brief Inserts nev pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &value) {
+    auto insert_result = try_emplace(key, value);
+    if (!insert_result.second)
+      (*(insert_result.first)).second = value;
+    return insert_result;
+  }
+
+  /**
+   * @brief Inserts new pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key. The value is moved in both cases
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             mapped_type &&value) {
+    auto insert_result = try_emplace(key, std::move(value));
+    // the value is untouched if the key was already in the container
+    if (!insert_result.second)
+      (*(insert_result.first)).second = std::move(value);
+    return insert_result;
+  }
+
+  /**
+   * @brief Inserts new pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key. The key is moved only into the new pair, the value is moved in both
+   * cases
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(key_type &&key,
+                                             mapped_type &&value) {
+    auto insert_result = try_emplace(std::move(key), std::move(value));
+    if (!insert_result.second)
+      (*(insert_result.first)).second = std::move(value);
+    return insert_result;
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments right
+   * inside the node only if there is no pair with given key
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments right
+   * inside the node only if there is no pair with given key. The key is moved
+   * into the node only if the insertion takes place
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments and inserts it, if there
+   * is no pair with the same key
+   *
+   * @param args arguments of the pair constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the inserted
+   * pair or to the pair with the equal key and bool indicating if insertion
+   * took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.emplace(false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element that follows the place of the pair
+   * @param args arguments of the pair constructor
+   * @return read/write iterator to the inserted pair or to the pair with the
+   * equal key
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_.emplace_hint(hint, false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Removes value that stores where the pos points. Unlike @code Map
+   * returns the iterator to the next element, because the erasure
+   * invalidates the others
+   *
+   * @param pos iterator to the element
+   * @return iterator to the element that followed the removed one
+   */
+  iterator erase(const_iterator pos) { return tree_.erase(pos); }
+
+  /**
+   * @brief Removes all the elements of the range
+   *
+   * @param first iterator to the first element to remove
+   * @param last iterator after the last element to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
+  /**
+   * @brief Removes value with given key
+   *
+   * @param key key that needs to be deleted
+   * @return amount of the removed elements, 0 or 1
+   */
+  size_type erase(const key_type &key) { return tree_.erase_key(key); }
+
+  /**
+   * @brief Swaps contents and size of the container with other map
+   *
+   * @param other container to be swapped
+   */
+  void swap(BTreeMap &other) { tree_.swap(other.tree_); }
+
+  /**
+   * @brief Moves the elements with new keys from other container into this
+   * one, the elements with the keys that are already here stay in other
+   * container
+   *
+   * @param other container to be merged with
+   */
+  void merge(BTreeMap &other) { tree_.merge(other.tree_); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read/write iterator to the element
+   */
+  iterator find(const key_type &key) { return tree_.find(key); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read only iterator to the element
+   */
+  const_iterator find(const key_type &key) const { return tree_.find(key); }
+
+  /**
+   * @brief Checks if the map contains element with given key
+   *
+   * @return true if contains
+   * @return false otherwise
+   */
+  bool contains(const key_type &key) const { return tree_.contains(key); }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first pair
+   * that is not less than given key, second iterator points at the first pair
+   * that is greater than given key
+   *
+   * @param key key to search range for
+   * @return pair of read/write iterators
+   */
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    return tree_.equal_range(key);
+  }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first pair
+   * that is not less than given key, second iterator points at the first pair
+   * that is greater than given key
+   *
+   * @param key key to search range for
+   * @return pair of read only iterators
+   */
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type &key) const {
+    return tree_.equal_range(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first pair that is not less than given key
+   *
+   * @param key to search for
+   * @return read/write iterator
+   */
+  iterator lower_bound(const key_type &key) { return tree_.lower_bound(key); }
+
+  /**
+   * @brief Returns iterator to the first pair that is not less than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  const_iterator lower_bound(const key_type &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first pair that is greater than given key
+   *
+   * @param key to search for
+   * @return read/write iterator
+   */
+  iterator upper_bound(const key_type &key) { return tree_.upper_bound(key); }
+
+  /**
+   * @brief Returns iterator to the first pair that is greater than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  const_iterator upper_bound(const key_type &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Finds the pair by any object comparable with the keys, no
+   * temporary key is constructed. Enabled only for the transparent
+   * @code Compare such as @code std::less<>, as well as the overloads below
+   *
+   * @param key object to compare the keys with
+   * @return iterator to the pair or @code end() if there is no such key
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) {
+    return tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator find(const Lookup &key) const {
+    return tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return tree_.contains(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<const_iterator, const_iterator>
+  equal_range(const Lookup &key) const {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator lower_bound(const Lookup &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) {
+    return tree_.upper_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator upper_bound(const Lookup &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  template <class K, class M, class C, class Predicate>
+  friend typename BTreeMap<K, M, C>::size_type
+  erase_if(BTreeMap<K, M, C> &container, Predicate pred);
+
+private:
+  btree tree_;
+};
+
+/**
+ * @brief Removes all the elements that satisfy the predicate with one
+ * traversal of the container
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the pair and returns true if it has to be
+ * removed
+ * @return amount of the removed elements
+ */
+template <class K, class M, class C, class Predicate>
+typename BTreeMap<K, M, C>::size_type erase_if(BTreeMap<K, M, C> &container,
+                                               Predicate pred) {
+  return container.tree_.erase_if(pred);
+}
+
+} // namespace custom
+
+#endif // _ASSOCIATIVE_CONTAINERS_BTREE_MAP_CUSTOM_BTREE_MAP_H_
@@ -0,0 +1,347 @@
+#ifndef _ASSOCIATIVE_CONTAINERS_BTREE_SET_CUSTOM_BTREE_SET_H_
+#define _ASSOCIATIVE_CONTAINERS_BTREE_SET_CUSTOM_BTREE_SET_H_
+
+#include <utility>
+
+#include "../../misc/custom_btree.h"
+
+namespace custom {
+
+/**
+ * @brief Container that stores unique values in sorted order using B-tree. It
+ * has the interface of @code Set, but keeps tens of values in one node, so
+ * lookups and ordered scans touch far less memory and small values take a few
+ * bytes of overhead instead of the separate node. In return every insertion
+ * and erasure invalidates all the iterators
+ *
+ * @tparam Key type of value to be stored
+ * @tparam Compare defaults to @code std::less<Key> and sorts values in
+ * ascending order, but can be also @code std::greater<Key> for storing values
+ * in descending order
+ */
+template <class Key, class Compare = std::less<Key>> class BTreeSet {
+public:
+  using btree = BTree__<Key, Key, TypeOfValue__<Key>, Compare>;
+  using key_type = typename btree::key_type;
+  using value_type = typename btree::value_type;
+  using key_compare = typename btree::key_compare;
+  using reference = typename btree::reference;
+  using const_reference = typename btree::const_reference;
+  using double_reference = typename btree::double_reference;
+  using size_type = typename btree::size_type;
+  using const_iterator = typename btree::const_iterator;
+  using iterator = const_iterator;
+
+  BTreeSet() = default;
+  BTreeSet(const BTreeSet &other) = default;
+  BTreeSet(BTreeSet &&other) noexcept = default;
+  ~BTreeSet() = default;
+
+  explicit BTreeSet(const std::initializer_list<value_type> &items)
+      : tree_(items.begin(), items.end()) {}
+
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  BTreeSet(InputIt first, InputIt last) : tree_(first, last) {}
+
+  BTreeSet &operator=(const BTreeSet &other) = default;
+  BTreeSet &operator=(BTreeSet &&other) = default;
+
+  /**
+   * @brief Returns iterator to the start of set
+   *
+   * @return read only iterator
+   */
+  iterator begin() const { return tree_.begin(); }
+
+  /**
+   * @brief Returns iterator to the past-end of set
+   *
+   * @return read only iterator
+   */
+  iterator end() const { return tree_.end(); }
+
+  /**
+   * @brief Checks if container is empty
+   *
+   * @return true is empty
+   * @return false otherwise
+   */
+  bool empty() const { return tree_.empty(); }
+
+  /**
+   * @brief Returns current size of the container
+   *
+   */
+  size_type size() const { return tree_.size(); }
+
+  /**
+   * @brief Returns theoretical maximum container size due to OS arcitecture
+   *
+   */
+  size_type max_size() const { return tree_.max_size(); }
+
+  /**
+   * @brief Returns amount of bytes taken by the nodes of the container,
+   * without the overhead of the memory allocator
+   *
+   */
+  size_type memory_usage() const { return tree_.memory_usage(); }
+
+  /**
+   * @brief Removes all stored values from the container
+   *
+   */
+  void clear() { tree_.clear(); }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const_reference value) {
+    return tree_.insert(value);
+  }
+
+  /**
+   * @brief Inserts a new value into container by moving it into the node. If
+   * the value is already in the container, it is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    return tree_.insert(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint. If the value
+   * belongs right before the hint, it is placed without the search from the
+   * root, so sorted data is inserted in constant time with the @code end()
+   * hint
+   *
+   * @param hint iterator to the element that follows the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value or to the equal value
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value);
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint by moving it
+   * into the node
+   *
+   * @param hint iterator to the element that follows the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value or to the equal value
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, double_reference value) {
+    return tree_.insert(hint, std::move(value));
+  }
+
+  /**
+   * @brief Inserts all the values of the range one by one, values that are
+   * already in the container are skipped. Sorted ranges are appended without
+   * the search from the root
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator after the last value of the range
+   * @return amount of the inserted values
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return tree_.insert(first, last);
+  }
+
+  /**
+   * @brief Inserts all the values of the list
+   *
+   * @param items list of the values
+   * @return amount of the inserted values
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return tree_.insert(items.begin(), items.end());
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element that follows the place of the value
+   * @param args arguments of the value constructor
+   * @return iterator to the inserted value or to the equal value
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_.emplace_hint(hint, false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it, if there
+   * is no equal value in the container
+   *
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read only iterator to the inserted
+   * value or to the equal value and bool indicating if insertion took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.emplace(false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Removes value that stores where the pos points. Unlike @code Set
+   * returns the iterator to the next value, because the erasure invalidates
+   * the others
+   *
+   * @param pos iterator to the element
+   * @return iterator to the value that followed the removed one
+   */
+  iterator erase(iterator pos) { return tree_.erase(pos); }
+
+  /**
+   * @brief Removes all the values of the range
+   *
+   * @param first iterator to the first value to remove
+   * @param last iterator after the last value to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
+  /**
+   * @brief Removes the value equal to the key
+   *
+   * @param key value to remove
+   * @return amount of the removed values, 0 or 1
+   */
+  size_type erase(const key_type &key) { return tree_.erase_key(key); }
+
+  /**
+   * @brief Swaps contents and size of the container with other set
+   *
+   * @param other container to be swapped
+   */
+  void swap(BTreeSet &other) { tree_.swap(other.tree_); }
+
+  /**
+   * @brief Moves the values that are not in this container from other one,
+   * the rest stay in other container
+   *
+   * @param other container to be merged with
+   */
+  void merge(BTreeSet &other) { tree_.merge(other.tree_); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read only iterator to the element
+   */
+  iterator find(const key_type &key) const { return tree_.find(key); }
+
+  /**
+   * @brief Checks if the set contains element with given key
+   *
+   * @return true if contains
+   * @return false otherwise
+   */
+  bool contains(const key_type &key) const { return tree_.contains(key); }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first value
+   * that is not less than given key, second iterator points at the first value
+   * that is greater than given key
+   *
+   * @param key value to search range for
+   * @return pair of read only iterators
+   */
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return tree_.equal_range(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first value that is not less than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  iterator lower_bound(const key_type &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first value that is greater than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  iterator upper_bound(const key_type &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Finds the value equal to any object comparable with the keys, no
+   * temporary key is constructed. Enabled only for the transparent
+   * @code Compare such as @code std::less<>, as well as the overloads below
+   *
+   * @param key object to compare the values with
+   * @return read only iterator to the value or @code end() if there is no
+   * such value
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) const {
+    return tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return tree_.contains(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) const {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  template <class K, class C, class Predicate>
+  friend typename BTreeSet<K, C>::size_type
+  erase_if(BTreeSet<K, C> &container, Predicate pred);
+
+private:
+  btree tree_;
+};
+
+/**
+ * @brief Removes all the values that satisfy the predicate with one
+ * traversal of the container
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the value and returns true if it has to
+ * be removed
+ * @return amount of the removed values
+ */
+template <class K, class C, class Predicate>
+typename BTreeSet<K, C>::size_type erase_if(BTreeSet<K, C> &container,
+                                            Predicate pred) {
+  return container.tree_.erase_if(pred);
+}
+
+} // namespace custom
+
+#endif // _ASSOCIATIVE_CONTAINERS_BTREE_SET_CUSTOM_BTREE_SET_H_
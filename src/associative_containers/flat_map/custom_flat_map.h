@@ -0,0 +1,869 @@
+#ifndef _ASSOCIATIVE_CONTAINERS_FLAT_MAP_CUSTOM_FLAT_MAP_H_
+#define _ASSOCIATIVE_CONTAINERS_FLAT_MAP_CUSTOM_FLAT_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../../misc/custom_tree_traits.h"
+#include "../../sequence_containers/vector/custom_vector.h"
+
+namespace custom {
+
+/**
+ * @brief Container to store pairs with unique keys in two sorted
+ * @code Vector arrays, one for the keys and one for the values. It has the
+ * interface of @code Map, but the binary search reads only the dense array of
+ * the keys and scans are linear reads without any overhead per pair. Single
+ * insertions and erasures move the pairs after them, so the container suits
+ * the data that is built at once and then mostly read. Every modification
+ * invalidates the iterators
+ *
+ * Iterators point into both arrays, so they return the pair of the references
+ * @code std::pair<const Key &, T &> instead of the reference to the stored
+ * pair
+ *
+ * @tparam Key type of keys of pairs
+ * @tparam T values of pairs
+ * @tparam Compare defaults to @code std::less<Key> and sorts values in
+ * ascending order, but can be also @code std::greater<Key> for storing values
+ * in descending order
+ */
+template <class Key, class T, class Compare = std::less<Key>> class FlatMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using key_container_type = Vector<key_type>;
+  using mapped_container_type = Vector<mapped_type>;
+  using reference = std::pair<const key_type &, mapped_type &>;
+  using const_reference = std::pair<const key_type &, const mapped_type &>;
+  using size_type = typename key_container_type::size_type;
+  using difference_type = std::ptrdiff_t;
+
+  template <bool IsConst> class FlatMapIterator__ {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename FlatMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using mapped_pointer =
+        std::conditional_t<IsConst, const mapped_type *, mapped_type *>;
+    using reference =
+        std::conditional_t<IsConst, typename FlatMap::const_reference,
+                           typename FlatMap::reference>;
+    using pointer = void;
+
+    FlatMapIterator__() : key_(nullptr), value_(nullptr) {}
+    FlatMapIterator__(const key_type *key, mapped_pointer value)
+        : key_(key), value_(value) {}
+
+    // implicit just like the conversion of the standard iterators
+    template <bool C = IsConst, class = std::enable_if_t<C>>
+    FlatMapIterator__(const FlatMapIterator__<false> &other)
+        : key_(other.key_), value_(other.value_) {}
+
+    reference operator*() const { return reference(*key_, *value_); }
+    reference operator[](difference_type shift) const {
+      return *(*this + shift);
+    }
+
+    FlatMapIterator__ &operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+    FlatMapIterator__ operator++(int) {
+      FlatMapIterator__ tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+    FlatMapIterator__ &operator--() {
+      --key_;
+      --value_;
+      return *this;
+    }
+    FlatMapIterator__ operator--(int) {
+      FlatMapIterator__ tmp(*this);
+      --(*this);
+      return tmp;
+    }
+    FlatMapIterator__ &operator+=(difference_type shift) {
+      key_ += shift;
+      value_ += shift;
+      return *this;
+    }
+    FlatMapIterator__ &operator-=(difference_type shift) {
+      return *this += -shift;
+    }
+    FlatMapIterator__ operator+(difference_type shift) const {
+      return FlatMapIterator__(*this) += shift;
+    }
+    FlatMapIterator__ operator-(difference_type shift) const {
+      return FlatMapIterator__(*this) -= shift;
+    }
+    difference_type operator-(const FlatMapIterator__ &other) const {
+      return key_ - other.key_;
+    }
+
+    bool operator==(const FlatMapIterator__ &other) const {
+      return key_ == other.key_;
+    }
+    bool operator!=(const FlatMapIterator__ &other) const {
+      return key_ != other.key_;
+    }
+    bool operator<(const FlatMapIterator__ &other) const {
+      return key_ < other.key_;
+    }
+    bool operator>(const FlatMapIterator__ &other) const {
+      return key_ > other.key_;
+    }
+    bool operator<=(const FlatMapIterator__ &other) const {
+      return key_ <= other.key_;
+    }
+    bool operator>=(const FlatMapIterator__ &other) const {
+      return key_ >= other.key_;
+    }
+
+  private:
+    friend class FlatMap;
+    friend class FlatMapIterator__<true>;
+
+    const key_type *key_;
+    mapped_pointer value_;
+  };
+
+  using iterator = FlatMapIterator__<false>;
+  using const_iterator = FlatMapIterator__<true>;
+
+  FlatMap() = default;
+  FlatMap(const FlatMap &other) = default;
+  FlatMap(FlatMap &&other) noexcept = default;
+  ~FlatMap() = default;
+  explicit FlatMap(const std::initializer_list<value_type> &items) {
+    insert(items.begin(), items.end());
+  }
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  FlatMap(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  FlatMap &operator=(const FlatMap &other) = default;
+  FlatMap &operator=(FlatMap &&other) noexcept = default;
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - creates new one with default
+   * constructor and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](const key_type &key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - moves the key into the new pair
+   * with default constructed value and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](key_type &&key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  /**
+   * @brief Checks if there is value with given key and returns reference to it.
+   * If there is no value with given key - throws @code std::exception()
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &at(const key_type &key) {
+    auto is_contains = find(key);
+    if (is_contains == end())
+      throw std::exception();
+    return (*is_contains).second;
+  }
+
+  /**
+   * @brief Checks if there is value with given key and returns reference to it.
+   * If there is no value with given key - throws @code std::exception()
+   *
+   * @param key key to needed value
+   * @return read only reference to the value of the pair
+   */
+  const mapped_type &at(const key_type &key) const {
+    auto is_contains = find(key);
+    if (is_contains == end())
+      throw std::exception();
+    return (*is_contains).second;
+  }
+
+  /**
+   * @brief Returns iterator to the start of the container
+   *
+   * @return read/write iterator
+   */
+  iterator begin() { return position(0UL); }
+
+  /**
+   * @brief Returns iterator to the start of the container
+   *
+   * @return read only iterator
+   */
+  const_iterator begin() const { return position(0UL); }
+
+  /**
+   * @brief Returns iterator to the past-end of the container
+   *
+   * @return read/write iterator
+   */
+  iterator end() { return position(size()); }
+
+  /**
+   * @brief Returns iterator to the past-end of the container
+   *
+   * @return read only iterator
+   */
+  const_iterator end() const { return position(size()); }
+
+  /**
+   * @brief Checks if container is empty
+   *
+   * @return true is empty
+   * @return false otherwise
+   */
+  bool empty() const { return keys_.empty(); }
+
+  /**
+   * @brief Returns current size of the container
+   *
+   */
+  size_type size() const { return keys_.size(); }
+
+  /**
+   * @brief Returns theoretical maximum container size due to OS arcitecture
+   *
+   */
+  size_type max_size() const {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+
+  /**
+   * @brief Reserves memory for the pairs, so the insertions up to the given
+   * size don't reallocate the arrays
+   *
+   * @param size amount of the pairs
+   */
+  void reserve(size_type size) {
+    keys_.reserve(size);
+    values_.reserve(size);
+  }
+
+  /**
+   * @brief Frees the memory reserved for the pairs that aren't stored
+   *
+   */
+  void shrink_to_fit() {
+    keys_.shrink_to_fit();
+    values_.shrink_to_fit();
+  }
+
+  /**
+   * @brief Returns the sorted array of the keys
+   *
+   */
+  const key_container_type &keys() const { return keys_; }
+
+  /**
+   * @brief Returns the array of the values, every value has the index of its
+   * key
+   *
+   */
+  const mapped_container_type &values() const { return values_; }
+
+  /**
+   * @brief Removes all stored values from the container
+   *
+   */
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+
+  /**
+   * @brief Inserts a new value into container, the pairs after it are moved
+   * one position right
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving it into the arrays. If the key is
+   * already in the container, the pair is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &value) {
+    return try_emplace(key, value);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving the value into the array. If the key
+   * is already in the container, nothing is moved
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key, mapped_type &&value) {
+    return try_emplace(key, std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new pair using the hint. If the pair belongs right
+   * before the hint, the binary search is skipped
+   *
+   * @param hint iterator to the element that follows the place of the pair
+   * @param value what to insert
+   * @return read/write iterator to the inserted pair or to the pair with the
+   * equal key that prevented the insertion
+   */
+  iterator insert(const_iterator hint, const value_type &value) {
+    return insert_hint(hint, value.first, value.second);
+  }
+
+  /**
+   * @brief Inserts a new pair using the hint by moving it into the arrays
+   *
+   * @param hint iterator to the element that follows the place of the pair
+   * @param value what to insert
+   * @return read/write iterator to the inserted pair or to the pair with the
+   * equal key that prevented the insertion
+   */
+  iterator insert(const_iterator hint, value_type &&value) {
+    return insert_hint(hint, std::move(value.first), std::move(value.second));
+  }
+
+  /**
+   * @brief Inserts all the elements of the range at once. The batch is sorted
+   * and merged with the stored pairs in one pass, so it takes linear time
+   * instead of moving the arrays for every pair. Elements with the keys that
+   * are already in the container are skipped
+   *
+   * @param first iterator to the first element of the range
+   * @param last iterator after the last element of the range
+   * @return amount of the inserted elements
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    Vector<value_type> batch;
+    for (; first != last; ++first)
+      batch.push_back(value_type(*first));
+    return insert_batch(batch, nullptr);
+  }
+
+  /**
+   * @brief Inserts all the elements of the list at once
+   *
+   * @param items list of the elements
+   * @return amount of the inserted elements
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return insert(items.begin(), items.end());
+  }
+
+  /**
+   * @brief Inserts nev pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &value) {
+    auto insert_result = try_emplace(key, value);
+    if (!insert_result.second)
+      (*(insert_result.first)).second = value;
+    return insert_result;
+  }
+
+  /**
+   * @brief Inserts new pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key. The value is moved in both cases
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             mapped_type &&value) {
+    auto insert_result = try_emplace(key, std::move(value));
+    // the value is untouched if the key was already in the container
+    if (!insert_result.second)
+      (*(insert_result.first)).second = std::move(value);
+    return insert_result;
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments only if
+   * there is no pair with given key
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return emplace_key(key, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments only if
+   * there is no pair with given key. The key is moved into the array only if
+   * the insertion takes place
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return emplace_key(std::move(key), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments and inserts it, if there
+   * is no pair with the same key
+   *
+   * @param args arguments of the pair constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the inserted
+   * pair or to the pair with the equal key and bool indicating if insertion
+   * took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element that follows the place of the pair
+   * @param args arguments of the pair constructor
+   * @return read/write iterator to the inserted pair or to the pair with the
+   * equal key
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Removes value that stores where the pos points, the pairs after it
+   * are moved one position left
+   *
+   * @param pos iterator to the element
+   * @return iterator to the element that followed the removed one
+   */
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  /**
+   * @brief Removes all the elements of the range with one move of the pairs
+   * after it
+   *
+   * @param first iterator to the first element to remove
+   * @param last iterator after the last element to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    auto index = first - begin();
+    auto removed = last - first;
+    // moving the tail onto itself would empty the moved-from strings
+    if (!removed)
+      return position(static_cast<size_type>(index));
+    std::move(keys_.begin() + index + removed, keys_.end(),
+              keys_.begin() + index);
+    std::move(values_.begin() + index + removed, values_.end(),
+              values_.begin() + index);
+    while (removed--) {
+      keys_.pop_back();
+      values_.pop_back();
+    }
+    return position(static_cast<size_type>(index));
+  }
+
+  /**
+   * @brief Removes value with given key
+   *
+   * @param key key that needs to be deleted
+   * @return amount of the removed elements, 0 or 1
+   */
+  size_type erase(const key_type &key) {
+    iterator pos = find(key);
+    if (pos == end())
+      return 0UL;
+    erase(pos);
+    return 1UL;
+  }
+
+  /**
+   * @brief Swaps contents and size of the container with other map
+   *
+   * @param other container to be swapped
+   */
+  void swap(FlatMap &other) {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+  /**
+   * @brief Moves the elements with new keys from other container in one
+   * merging pass, the elements with the keys that are already here stay in
+   * other container
+   *
+   * @param other container to be merged with
+   */
+  void merge(FlatMap &other) {
+    if (this == &other)
+      return;
+    Vector<value_type> batch;
+    batch.reserve(other.size());
+    for (size_type i = 0UL; i < other.size(); ++i)
+      batch.push_back(value_type(std::move(other.keys_[i]),
+                                 std::move(other.values_[i])));
+    other.clear();
+    Vector<value_type> rest;
+    insert_batch(batch, &rest);
+    other.insert_batch(rest, nullptr);
+  }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read/write iterator to the element
+   */
+  iterator find(const key_type &key) { return position(find_index(key)); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read only iterator to the element
+   */
+  const_iterator find(const key_type &key) const {
+    return position(find_index(key));
+  }
+
+  /**
+   * @brief Checks if the map contains element with given key
+   *
+   * @return true if contains
+   * @return false otherwise
+   */
+  bool contains(const key_type &key) const { return find_index(key) < size(); }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first pair
+   * that is not less than given key, second iterator points at the first pair
+   * that is greater than given key
+   *
+   * @param key key to search range for
+   * @return pair of read/write iterators
+   */
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    return std::pair<iterator, iterator>{lower_bound(key), upper_bound(key)};
+  }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first pair
+   * that is not less than given key, second iterator points at the first pair
+   * that is greater than given key
+   *
+   * @param key key to search range for
+   * @return pair of read only iterators
+   */
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type &key) const {
+    return std::pair<const_iterator, const_iterator>{lower_bound(key),
+                                                     upper_bound(key)};
+  }
+
+  /**
+   * @brief Returns iterator to the first pair that is not less than given key
+   *
+   * @param key to search for
+   * @return read/write iterator
+   */
+  iterator lower_bound(const key_type &key) {
+    return position(lower_index(key));
+  }
+
+  /**
+   * @brief Returns iterator to the first pair that is not less than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  const_iterator lower_bound(const key_type &key) const {
+    return position(lower_index(key));
+  }
+
+  /**
+   * @brief Returns iterator to the first pair that is greater than given key
+   *
+   * @param key to search for
+   * @return read/write iterator
+   */
+  iterator upper_bound(const key_type &key) {
+    return position(upper_index(key));
+  }
+
+  /**
+   * @brief Returns iterator to the first pair that is greater than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  const_iterator upper_bound(const key_type &key) const {
+    return position(upper_index(key));
+  }
+
+  /**
+   * @brief Finds the pair by any object comparable with the keys, no
+   * temporary key is constructed. Enabled only for the transparent
+   * @code Compare such as @code std::less<>, as well as the overloads below
+   *
+   * @param key object to compare the keys with
+   * @return iterator to the pair or @code end() if there is no such key
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) {
+    return position(find_index(key));
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator find(const Lookup &key) const {
+    return position(find_index(key));
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return find_index(key) < size();
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) {
+    return std::pair<iterator, iterator>{position(lower_index(key)),
+                                         position(upper_index(key))};
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<const_iterator, const_iterator>
+  equal_range(const Lookup &key) const {
+    return std::pair<const_iterator, const_iterator>{
+        position(lower_index(key)), position(upper_index(key))};
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) {
+    return position(lower_index(key));
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator lower_bound(const Lookup &key) const {
+    return position(lower_index(key));
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) {
+    return position(upper_index(key));
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator upper_bound(const Lookup &key) const {
+    return position(upper_index(key));
+  }
+
+  template <class K, class M, class C, class Predicate>
+  friend typename FlatMap<K, M, C>::size_type
+  erase_if(FlatMap<K, M, C> &container, Predicate pred);
+
+private:
+  key_container_type keys_;
+  mapped_container_type values_;
+
+  iterator position(size_type index) {
+    return iterator(keys_.data() + index, values_.data() + index);
+  }
+  const_iterator position(size_type index) const {
+    return const_iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  // The binary search reads only the array of the keys
+  template <class Lookup> size_type lower_index(const Lookup &key) const {
+    return std::lower_bound(keys_.begin(), keys_.end(), key, key_compare()) -
+           keys_.begin();
+  }
+  template <class Lookup> size_type upper_index(const Lookup &key) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), key, key_compare()) -
+           keys_.begin();
+  }
+  // Index of the equal key or the size if there is no such key
+  template <class Lookup> size_type find_index(const Lookup &key) const {
+    size_type index = lower_index(key);
+    if (index < size() && !key_compare()(key, keys_[index]))
+      return index;
+    return size();
+  }
+
+  // Places the key and the value at the index, both arrays are moved right
+  template <class K, class... Args>
+  iterator emplace_at(size_type index, K &&key, Args &&...args) {
+    mapped_type value(std::forward<Args>(args)...);
+    keys_.insert(keys_.begin() + index, std::forward<K>(key));
+    try {
+      values_.insert(values_.begin() + index, std::move(value));
+    } catch (...) {
+      keys_.erase(keys_.begin() + index);
+      throw;
+    }
+    return position(index);
+  }
+
+  template <class K, class... Args>
+  std::pair<iterator, bool> emplace_key(K &&key, Args &&...args) {
+    size_type index = lower_index(key);
+    if (index < size() && !key_compare()(key, keys_[index]))
+      return std::pair<iterator, bool>{position(index), false};
+    return std::pair<iterator, bool>{
+        emplace_at(index, std::forward<K>(key), std::forward<Args>(args)...),
+        true};
+  }
+
+  template <class K, class M>
+  iterator insert_hint(const_iterator hint, K &&key, M &&value) {
+    // the key has to fit between the hint and the key before it
+    size_type index = static_cast<size_type>(hint - begin());
+    if ((!index || key_compare()(keys_[index - 1UL], key)) &&
+        (index == size() || key_compare()(key, keys_[index])))
+      return emplace_at(index, std::forward<K>(key), std::forward<M>(value));
+    return emplace_key(std::forward<K>(key), std::forward<M>(value)).first;
+  }
+
+  // Sorts the batch by the keys and merges it with the stored pairs into the
+  // new arrays. Pairs with the keys that are already stored or repeated in
+  // the batch are moved into the rejected array, if it is given
+  size_type insert_batch(Vector<value_type> &batch,
+                         Vector<value_type> *rejected) {
+    auto is_less = [](const value_type &left, const value_type &right) {
+      return key_compare()(left.first, right.first);
+    };
+    if (!std::is_sorted(batch.begin(), batch.end(), is_less))
+      std::stable_sort(batch.begin(), batch.end(), is_less);
+    key_container_type keys;
+    mapped_container_type values;
+    keys.reserve(size() + batch.size());
+    values.reserve(size() + batch.size());
+    size_type inserted = 0UL;
+    size_type i = 0UL;
+    for (auto j = batch.begin(); j != batch.end(); ++j) {
+      for (; i < size() && key_compare()(keys_[i], (*j).first); ++i) {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i]));
+      }
+      if ((i < size() && !key_compare()((*j).first, keys_[i])) ||
+          (!keys.empty() && !key_compare()(keys.back(), (*j).first))) {
+        if (rejected)
+          rejected->push_back(std::move(*j));
+      } else {
+        keys.push_back(std::move((*j).first));
+        values.push_back(std::move((*j).second));
+        ++inserted;
+      }
+    }
+    for (; i < size(); ++i) {
+      keys.push_back(std::move(keys_[i]));
+      values.push_back(std::move(values_[i]));
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+    return inserted;
+  }
+};
+
+/**
+ * @brief Removes all the elements that satisfy the predicate, the rest are
+ * moved to the front with one pass over the arrays
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the pair of the references to the key and
+ * the value and returns true if it has to be removed
+ * @return amount of the removed elements
+ */
+template <class K, class M, class C, class Predicate>
+typename FlatMap<K, M, C>::size_type erase_if(FlatMap<K, M, C> &container,
+                                              Predicate pred) {
+  using size_type = typename FlatMap<K, M, C>::size_type;
+  using const_reference = typename FlatMap<K, M, C>::const_reference;
+  auto &keys = container.keys_;
+  auto &values = container.values_;
+  size_type kept = 0UL;
+  for (size_type i = 0UL; i < keys.size(); ++i) {
+    if (pred(const_reference(keys[i], values[i])))
+      continue;
+    if (kept != i) {
+      keys[kept] = std::move(keys[i]);
+      values[kept] = std::move(values[i]);
+    }
+    ++kept;
+  }
+  size_type removed = keys.size() - kept;
+  while (keys.size() > kept) {
+    keys.pop_back();
+    values.pop_back();
+  }
+  return removed;
+}
+
+} // namespace custom
+
+#endif // _ASSOCIATIVE_CONTAINERS_FLAT_MAP_CUSTOM_FLAT_MAP_H_
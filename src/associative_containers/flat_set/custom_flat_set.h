@@ -0,0 +1,455 @@
+#ifndef _ASSOCIATIVE_CONTAINERS_FLAT_SET_CUSTOM_FLAT_SET_H_
+#define _ASSOCIATIVE_CONTAINERS_FLAT_SET_CUSTOM_FLAT_SET_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../../misc/custom_tree_traits.h"
+#include "../../sequence_containers/vector/custom_vector.h"
+
+namespace custom {
+
+/**
+ * @brief Container that stores unique values in sorted order in one
+ * @code Vector. It has the interface of @code Set, but the values lie
+ * contiguously, so lookups are binary searches over the cache lines of the
+ * array and scans are linear reads without any overhead per value. Single
+ * insertions and erasures move the values after them, so the container suits
+ * the data that is built at once and then mostly read. Every modification
+ * invalidates the iterators
+ *
+ * @tparam Key type of value to be stored
+ * @tparam Compare defaults to @code std::less<Key> and sorts values in
+ * ascending order, but can be also @code std::greater<Key> for storing values
+ * in descending order
+ */
+template <class Key, class Compare = std::less<Key>> class FlatSet {
+public:
+  using container_type = Vector<Key>;
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using double_reference = value_type &&;
+  using size_type = typename container_type::size_type;
+  using const_iterator = typename container_type::const_iterator;
+  using iterator = const_iterator;
+
+  FlatSet() = default;
+  FlatSet(const FlatSet &other) = default;
+  FlatSet(FlatSet &&other) noexcept = default;
+  ~FlatSet() = default;
+
+  explicit FlatSet(const std::initializer_list<value_type> &items) {
+    insert(items.begin(), items.end());
+  }
+
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  FlatSet(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  FlatSet &operator=(const FlatSet &other) = default;
+  FlatSet &operator=(FlatSet &&other) noexcept = default;
+
+  /**
+   * @brief Returns iterator to the start of set
+   *
+   * @return read only iterator
+   */
+  iterator begin() const { return keys_.begin(); }
+
+  /**
+   * @brief Returns iterator to the past-end of set
+   *
+   * @return read only iterator
+   */
+  iterator end() const { return keys_.end(); }
+
+  /**
+   * @brief Checks if container is empty
+   *
+   * @return true is empty
+   * @return false otherwise
+   */
+  bool empty() const { return keys_.empty(); }
+
+  /**
+   * @brief Returns current size of the container
+   *
+   */
+  size_type size() const { return keys_.size(); }
+
+  /**
+   * @brief Returns theoretical maximum container size due to OS arcitecture
+   *
+   */
+  size_type max_size() const { return keys_.max_size(); }
+
+  /**
+   * @brief Reserves memory for the values, so the insertions up to the given
+   * size don't reallocate the array
+   *
+   * @param size amount of the values
+   */
+  void reserve(size_type size) { keys_.reserve(size); }
+
+  /**
+   * @brief Frees the memory reserved for the values that aren't stored
+   *
+   */
+  void shrink_to_fit() { keys_.shrink_to_fit(); }
+
+  /**
+   * @brief Returns the sorted array of the values
+   *
+   */
+  const container_type &keys() const { return keys_; }
+
+  /**
+   * @brief Removes all stored values from the container
+   *
+   */
+  void clear() { keys_.clear(); }
+
+  /**
+   * @brief Inserts a new value into container, the values after it are moved
+   * one position right
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const_reference value) {
+    return insert_value(value);
+  }
+
+  /**
+   * @brief Inserts a new value into container by moving it into the array. If
+   * the value is already in the container, it is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    return insert_value(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint. If the value
+   * belongs right before the hint, the binary search is skipped
+   *
+   * @param hint iterator to the element that follows the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value or to the equal value
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, const_reference value) {
+    return insert_value(hint, value);
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint by moving it
+   * into the array
+   *
+   * @param hint iterator to the element that follows the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value or to the equal value
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, double_reference value) {
+    return insert_value(hint, std::move(value));
+  }
+
+  /**
+   * @brief Inserts all the values of the range at once. The batch is sorted
+   * and merged with the stored values in one pass, so it takes linear time
+   * instead of moving the array for every value. Values that are already in
+   * the container are skipped
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator after the last value of the range
+   * @return amount of the inserted values
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    container_type batch;
+    for (; first != last; ++first)
+      batch.push_back(*first);
+    return insert_batch(batch, nullptr);
+  }
+
+  /**
+   * @brief Inserts all the values of the list at once
+   *
+   * @param items list of the values
+   * @return amount of the inserted values
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return insert(items.begin(), items.end());
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element that follows the place of the value
+   * @param args arguments of the value constructor
+   * @return iterator to the inserted value or to the equal value
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return insert_value(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it, if there
+   * is no equal value in the container
+   *
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read only iterator to the inserted
+   * value or to the equal value and bool indicating if insertion took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert_value(value_type(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Removes value that stores where the pos points, the values after
+   * it are moved one position left
+   *
+   * @param pos iterator to the element
+   * @return iterator to the value that followed the removed one
+   */
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  /**
+   * @brief Removes all the values of the range with one move of the values
+   * after it
+   *
+   * @param first iterator to the first value to remove
+   * @param last iterator after the last value to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    auto index = first - begin();
+    auto target = keys_.begin() + index;
+    auto removed = last - first;
+    // moving the tail onto itself would empty the moved-from strings
+    if (!removed)
+      return begin() + index;
+    std::move(target + removed, keys_.end(), target);
+    while (removed--)
+      keys_.pop_back();
+    return begin() + index;
+  }
+
+  /**
+   * @brief Removes the value equal to the key
+   *
+   * @param key value to remove
+   * @return amount of the removed values, 0 or 1
+   */
+  size_type erase(const key_type &key) {
+    iterator pos = find(key);
+    if (pos == end())
+      return 0UL;
+    erase(pos);
+    return 1UL;
+  }
+
+  /**
+   * @brief Swaps contents and size of the container with other set
+   *
+   * @param other container to be swapped
+   */
+  void swap(FlatSet &other) { keys_.swap(other.keys_); }
+
+  /**
+   * @brief Moves the values that are not in this container from other one in
+   * one merging pass, the rest stay in other container
+   *
+   * @param other container to be merged with
+   */
+  void merge(FlatSet &other) {
+    if (this == &other)
+      return;
+    container_type rest;
+    insert_batch(other.keys_, &rest);
+    other.keys_.swap(rest);
+  }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read only iterator to the element
+   */
+  iterator find(const key_type &key) const { return find_value(key); }
+
+  /**
+   * @brief Checks if the set contains element with given key
+   *
+   * @return true if contains
+   * @return false otherwise
+   */
+  bool contains(const key_type &key) const { return find(key) != end(); }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first value
+   * that is not less than given key, second iterator points at the first value
+   * that is greater than given key
+   *
+   * @param key value to search range for
+   * @return pair of read only iterators
+   */
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return std::pair<iterator, iterator>{lower_bound(key), upper_bound(key)};
+  }
+
+  /**
+   * @brief Returns iterator to the first value that is not less than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  iterator lower_bound(const key_type &key) const {
+    return std::lower_bound(begin(), end(), key, key_compare());
+  }
+
+  /**
+   * @brief Returns iterator to the first value that is greater than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  iterator upper_bound(const key_type &key) const {
+    return std::upper_bound(begin(), end(), key, key_compare());
+  }
+
+  /**
+   * @brief Finds the value equal to any object comparable with the keys, no
+   * temporary key is constructed. Enabled only for the transparent
+   * @code Compare such as @code std::less<>, as well as the overloads below
+   *
+   * @param key object to compare the values with
+   * @return read only iterator to the value or @code end() if there is no
+   * such value
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) const {
+    return find_value(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return find_value(key) != end();
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) const {
+    return std::pair<iterator, iterator>{
+        std::lower_bound(begin(), end(), key, key_compare()),
+        std::upper_bound(begin(), end(), key, key_compare())};
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) const {
+    return std::lower_bound(begin(), end(), key, key_compare());
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) const {
+    return std::upper_bound(begin(), end(), key, key_compare());
+  }
+
+  template <class K, class C, class Predicate>
+  friend typename FlatSet<K, C>::size_type
+  erase_if(FlatSet<K, C> &container, Predicate pred);
+
+private:
+  container_type keys_;
+
+  template <class Lookup> iterator find_value(const Lookup &key) const {
+    iterator pos = std::lower_bound(begin(), end(), key, key_compare());
+    return pos != end() && !key_compare()(key, *pos) ? pos : end();
+  }
+
+  template <class Value>
+  std::pair<iterator, bool> insert_value(Value &&value) {
+    iterator pos = std::lower_bound(begin(), end(), value, key_compare());
+    if (pos != end() && !key_compare()(value, *pos))
+      return std::pair<iterator, bool>{pos, false};
+    auto index = pos - begin();
+    keys_.insert(keys_.begin() + index, std::forward<Value>(value));
+    return std::pair<iterator, bool>{begin() + index, true};
+  }
+
+  template <class Value>
+  iterator insert_value(const_iterator hint, Value &&value) {
+    // the value has to fit between the hint and the value before it
+    if ((hint == begin() || key_compare()(*(hint - 1), value)) &&
+        (hint == end() || key_compare()(value, *hint))) {
+      auto index = hint - begin();
+      keys_.insert(keys_.begin() + index, std::forward<Value>(value));
+      return begin() + index;
+    }
+    return insert_value(std::forward<Value>(value)).first;
+  }
+
+  // Sorts the batch and merges it with the stored values into the new array.
+  // Values that are already stored or repeated in the batch are moved into
+  // the rejected array, if it is given
+  size_type insert_batch(container_type &batch, container_type *rejected) {
+    if (!std::is_sorted(batch.begin(), batch.end(), key_compare()))
+      std::stable_sort(batch.begin(), batch.end(), key_compare());
+    container_type result;
+    result.reserve(keys_.size() + batch.size());
+    size_type inserted = 0UL;
+    auto i = keys_.begin();
+    for (auto j = batch.begin(); j != batch.end(); ++j) {
+      while (i != keys_.end() && key_compare()(*i, *j))
+        result.push_back(std::move(*i++));
+      if ((i != keys_.end() && !key_compare()(*j, *i)) ||
+          (!result.empty() && !key_compare()(result.back(), *j))) {
+        if (rejected)
+          rejected->push_back(std::move(*j));
+      } else {
+        result.push_back(std::move(*j));
+        ++inserted;
+      }
+    }
+    while (i != keys_.end())
+      result.push_back(std::move(*i++));
+    keys_.swap(result);
+    return inserted;
+  }
+};
+
+/**
+ * @brief Removes all the values that satisfy the predicate, the rest are
+ * moved to the front with one pass over the array
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the value and returns true if it has to
+ * be removed
+ * @return amount of the removed values
+ */
+template <class K, class C, class Predicate>
+typename FlatSet<K, C>::size_type erase_if(FlatSet<K, C> &container,
+                                           Predicate pred) {
+  auto &keys = container.keys_;
+  auto last = std::remove_if(keys.begin(), keys.end(), pred);
+  typename FlatSet<K, C>::size_type removed = keys.end() - last;
+  for (auto i = removed; i; --i)
+    keys.pop_back();
+  return removed;
+}
+
+} // namespace custom
+
+#endif // _ASSOCIATIVE_CONTAINERS_FLAT_SET_CUSTOM_FLAT_SET_H_
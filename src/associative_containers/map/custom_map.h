@@ -2,18 +2,13 @@
 #define _ASSOCIATIVE_CONTAINERS_MAP_CUSTOM_MAP_H_
 
 #include <stdexcept>
+#include <tuple>
+#include <utility>
 
 #include "../../misc/custom_binary_tree.h"
 
 namespace custom {
 
-// Specialization of tree iterator for first std::pair argument
-template <class Pair> struct PairFirstElement__ {
-  const typename Pair::first_type &operator()(const Pair &p) const {
-    return p.first;
-  }
-};
-
 /**
  * @brief Container to store pairs with unique keys that is based on the sorted
  * binary tree
@@ -23,39 +18,62 @@ template <class Pair> struct PairFirstElement__ {
  * @tparam Compare defaults to @code std::less<Key> and sorts values in
  * ascending order, but can be also @code std::greater<Key> for storing values
  * in descending order
+ * @tparam Allocator defaults to @code NodeAllocator__ that allocates every node
+ * separately, @code NodePool__ places nodes in the slabs of the container
+ * @tparam Ranked keeps subtree sizes in the nodes, so @code nth(),
+ * @code rank() and @code count_range() work in logarithmic time
  */
-template <class Key, class T, class Compare = std::less<Key>> class Map {
+template <class Key, class T, class Compare = std::less<Key>,
+          template <class> class Allocator = NodeAllocator__,
+          bool Ranked = false>
+class Map {
 public:
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
   using binary_tree =
       SortedBinaryTree__<key_type, value_type, PairFirstElement__<value_type>,
-                         Compare>;
+                         Compare, Allocator, Ranked>;
   using key_compare = typename binary_tree::key_compare;
   using key_identify = typename binary_tree::key_identify;
   using reference = value_type &;
-  using const_reference = const value_type;
+  using const_reference = const value_type &;
+  using double_reference = value_type &&;
   using iterator = typename binary_tree::iterator;
   using const_iterator = typename binary_tree::const_iterator;
   using size_type = typename binary_tree::size_type;
+  using node_type = typename binary_tree::node_handle;
+  using insert_return_type = typename binary_tree::insert_return_type;
 
   Map() = default;
   Map(const Map &other) = default;
   Map(Map &&other) = default;
   ~Map() = default;
   explicit Map(const std::initializer_list<value_type> &items) : tree_(items) {}
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  Map(InputIt first, InputIt last) : tree_(first, last) {}
 
   Map &operator=(const Map &other) = default;
   Map &operator=(Map &&other) = default;
 
   Map &operator=(const std::initializer_list<value_type> &items) {
-    tree_.clear();
-    for (auto i = items.begin(); i != items.end(); ++i)
-      tree_.insert(*i);
+    tree_.assign(items.begin(), items.end());
     return *this;
   }
 
+  /**
+   * @brief Replaces contents of the container with values from the range.
+   * Sorted ranges are linked into the balanced tree in linear time, other
+   * ranges are sorted first
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator to the past-end of the range
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    tree_.assign(first, last);
+  }
+
   /**
    * @brief Returns reference to the value of pair with given key. If there is
    * no pair with given key in the container - creates new one with default
@@ -65,7 +83,19 @@ public:
    * @return read/write reference to the value of the pair
    */
   mapped_type &operator[](const key_type &key) {
-    return (*tree_.insert({key, mapped_type()}).first).second;
+    return (*try_emplace(key).first).second;
+  }
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - moves the key into the new pair
+   * with default constructed value and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](key_type &&key) {
+    return (*try_emplace(std::move(key)).first).second;
   }
 
   /**
@@ -150,6 +180,14 @@ public:
    */
   void clear() { tree_.clear(); }
 
+  /**
+   * @brief Removes all stored values from the container in constant time. The
+   * values are destroyed and the memory is freed later by the background
+   * thread, @code custom::Reclaimer__::instance().wait() waits for it
+   *
+   */
+  void clear_async() { tree_.clear_async(); }
+
   /**
    * @brief Inserts a new value into container
    *
@@ -161,6 +199,105 @@ public:
     return tree_.insert(value);
   }
 
+  /**
+   * @brief Inserts a new pair into container by moving it into the node. If
+   * the key is already in the container, the pair is left untouched
+   *
+   * @param value pair key:value
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    return tree_.insert(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new pair into container using the hint. If the pair
+   * belongs right before or right after the hint, it is linked without the
+   * search from the root
+   *
+   * @param hint iterator to the element next to the place of the pair
+   * @param value pair to insert
+   * @return iterator to the inserted pair or to the pair with the same key
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value);
+  }
+
+  /**
+   * @brief Inserts a new pair into container using the hint by moving it into
+   * the node
+   *
+   * @param hint iterator to the element next to the place of the pair
+   * @param value pair to insert
+   * @return iterator to the inserted pair or to the pair with the same key
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, double_reference value) {
+    return tree_.insert(hint, std::move(value));
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element next to the place of the pair
+   * @param args arguments of the pair constructor
+   * @return iterator to the inserted pair
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_.emplace_hint(hint, false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments right inside the node and
+   * inserts it. If the key is already in the container, the node is freed
+   *
+   * @param args arguments of the pair constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the inserted
+   * pair or to the pair with the same key and bool indicating if insertion
+   * took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.emplace(false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments right
+   * inside the node only if there is no pair with given key. Nothing is
+   * allocated or constructed if the key is already in the container
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments right
+   * inside the node only if there is no pair with given key. The key is moved
+   * into the node only if the insertion takes place
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
   /**
    * @brief Inserts a new value into container
    *
@@ -171,7 +308,33 @@ public:
    */
   std::pair<iterator, bool> insert(const key_type &key,
                                    const mapped_type &value) {
-    return tree_.insert({key, value});
+    return try_emplace(key, value);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving the value into the node. If the key
+   * is already in the container, nothing is moved
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key, mapped_type &&value) {
+    return try_emplace(key, std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new pair by moving the key and the value into the node.
+   * If the key is already in the container, nothing is moved
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(key_type &&key, mapped_type &&value) {
+    return try_emplace(std::move(key), std::move(value));
   }
 
   /**
@@ -186,13 +349,51 @@ public:
    */
   std::pair<iterator, bool> insert_or_assign(const key_type &key,
                                              const mapped_type &value) {
-    auto insert_result = insert({key, value});
+    auto insert_result = try_emplace(key, value);
     if (!insert_result.second) {
       (*(insert_result.first)).second = value;
     }
     return insert_result;
   }
 
+  /**
+   * @brief Inserts new pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key. The value is moved in both cases
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             mapped_type &&value) {
+    auto insert_result = try_emplace(key, std::move(value));
+    // the value is untouched if the key was already in the container
+    if (!insert_result.second)
+      (*(insert_result.first)).second = std::move(value);
+    return insert_result;
+  }
+
+  /**
+   * @brief Inserts new pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key. The key is moved only into the new pair, the value is moved in both
+   * cases
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(key_type &&key,
+                                             mapped_type &&value) {
+    auto insert_result = try_emplace(std::move(key), std::move(value));
+    if (!insert_result.second)
+      (*(insert_result.first)).second = std::move(value);
+    return insert_result;
+  }
+
   /**
    * @brief Removes value that stores where the pos points
    *
@@ -200,12 +401,91 @@ public:
    */
   void erase(iterator pos) { tree_.erase(pos); }
 
+  /**
+   * @brief Removes all the elements of the range. The range is cut out of
+   * the tree at its ends and the parts around it are joined back, so it takes
+   * log(n) steps besides the removed elements
+   *
+   * @param first iterator to the first element to remove
+   * @param last iterator after the last element to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
   /**
    * @brief Removes value with given key
    *
    * @param key key that needs to be deleted
+   * @return amount of the removed elements, 0 or 1
    */
-  void erase(const key_type &key) { tree_.erase(tree_.find(key)); }
+  size_type erase(const key_type &key) {
+    iterator pos = tree_.find(key);
+    if (pos == end())
+      return 0UL;
+    tree_.erase(pos);
+    return 1UL;
+  }
+
+  /**
+   * @brief Unlinks the node of the element from the container and passes
+   * its ownership to the handle, nothing is copied or freed. With
+   * @code NodePool__ the pair is moved into a node of the handle instead,
+   * so the handle stays valid after the container is gone
+   *
+   * @param pos iterator to the element
+   * @return handle that owns the node
+   */
+  node_type extract(const_iterator pos) { return tree_.extract(pos); }
+
+  /**
+   * @brief Unlinks the node of the first element with given key from the
+   * container and passes its ownership to the handle. If there is no such
+   * key returns empty handle
+   *
+   * @param key key of the element
+   * @return handle that owns the node
+   */
+  node_type extract(const key_type &key) { return tree_.extract(key); }
+
+  /**
+   * @brief Inserts the node owned by the handle without allocation and
+   * without copying of the pair, unless the container uses
+   * @code NodePool__. If the key is already in the container, the node stays
+   * in the handle
+   *
+   * @param handle node extracted from the container of the same type
+   * @return iterator to the inserted or equal pair, indicator if the
+   * insertion took place and the handle with the node that wasn't inserted
+   */
+  insert_return_type insert(node_type &&handle) {
+    return tree_.insert(std::move(handle));
+  }
+
+  /**
+   * @brief Inserts all the elements of the range at once. The batch is sorted
+   * first and linked in key order, elements with the keys that are already in
+   * the container are skipped
+   *
+   * @param first iterator to the first element of the range
+   * @param last iterator after the last element of the range
+   * @return amount of the inserted elements
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return tree_.insert(first, last);
+  }
+
+  /**
+   * @brief Inserts all the elements of the list at once in key order
+   *
+   * @param items list of the elements
+   * @return amount of the inserted elements
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return tree_.insert(items.begin(), items.end());
+  }
 
   /**
    * @brief Swaps contents and size of the container with other map
@@ -221,6 +501,32 @@ public:
    */
   void merge(Map &other) { tree_.merge(other.tree_); }
 
+  /**
+   * @brief Moves all the elements that are not less than the key into the new
+   * container. Nodes are relinked without allocation in logarithmic time,
+   * but unless the container is @code Ranked the smaller part is also
+   * counted. Nodes are copied only if the containers use @code NodePool__
+   *
+   * @param key the smallest possible key of the new container
+   * @return container with the elements that are not less than the key
+   */
+  Map split(const key_type &key) {
+    Map greater;
+    tree_.split(key, greater.tree_);
+    return greater;
+  }
+
+  /**
+   * @brief Moves all the elements of other container to the end of this one in
+   * logarithmic time. Nodes are relinked without allocation, they are copied
+   * only if the containers use @code NodePool__. If the keys of the
+   * containers overlap - throws @code std::invalid_argument
+   *
+   * @param other container with the keys greater than all the keys of
+   * this one
+   */
+  void join(Map &other) { tree_.join(other.tree_); }
+
   /**
    * @brief Finds element in the container by the key and returns an iterator to
    * pair with given element. If element is not in the container returns @code
@@ -248,21 +554,230 @@ public:
   bool contains(const key_type &key) const { return tree_.contains(key); }
 
   /**
-   * @brief Inserts many elements at once
+   * @brief Finds element by the key starting the search from the hint. Search
+   * takes time logarithmic in the distance between the hint and the element
+   *
+   * @param hint iterator to the element near the searched one
+   * @param key key to search for
+   * @return iterator to the element or @code end() if there is no such key
+   */
+  iterator find(const_iterator hint, const key_type &key) {
+    return tree_.find(hint, key);
+  }
+
+  /**
+   * @brief Finds element by the key starting the search from the hint. Search
+   * takes time logarithmic in the distance between the hint and the element
+   *
+   * @param hint iterator to the element near the searched one
+   * @param key key to search for
+   * @return read only iterator to the element or @code end() if there is no
+   * such key
+   */
+  const_iterator find(const_iterator hint, const key_type &key) const {
+    return tree_.find(hint, key);
+  }
+
+  /**
+   * @brief Returns iterator to the element with given index in the sorted
+   * order. If index is out of range returns @code end(). Available only for
+   * ranked containers
+   *
+   * @param index position of the element starting from zero
+   * @return iterator to the element
+   */
+  iterator nth(size_type index) { return tree_.nth(index); }
+
+  /**
+   * @brief Returns iterator to the element with given index in the sorted
+   * order. If index is out of range returns @code end(). Available only for
+   * ranked containers
+   *
+   * @param index position of the element starting from zero
+   * @return read only iterator to the element
+   */
+  const_iterator nth(size_type index) const { return tree_.nth(index); }
+
+  /**
+   * @brief Returns count of the elements that are less than given key.
+   * Available only for ranked containers
+   *
+   * @param key value to compare with
+   */
+  size_type rank(const key_type &key) const { return tree_.rank(key); }
+
+  /**
+   * @brief Returns count of the elements that are not less than low and less
+   * than high. Available only for ranked containers
+   *
+   * @param low the smallest key of the range
+   * @param high past-end key of the range
+   */
+  size_type count_range(const key_type &low, const key_type &high) const {
+    return tree_.count_range(low, high);
+  }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first
+   * element with key that is not less than given key, second iterator points
+   * at the first element with key that is greater than given key
    *
-   * @param args sequence of already constructed elements
+   * @param key key to search range for
+   * @return pair of iterators
+   */
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    return tree_.equal_range(key);
+  }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first
+   * element with key that is not less than given key, second iterator points
+   * at the first element with key that is greater than given key
+   *
+   * @param key key to search range for
+   * @return pair of read only iterators
+   */
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type &key) const {
+    return tree_.equal_range(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first element with key that is not less
+   * than given key
+   *
+   * @param key to search for
+   * @return iterator to the element
+   */
+  iterator lower_bound(const key_type &key) { return tree_.lower_bound(key); }
+
+  /**
+   * @brief Returns iterator to the first element with key that is not less
+   * than given key
+   *
+   * @param key to search for
+   * @return read only iterator to the element
+   */
+  const_iterator lower_bound(const key_type &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first element with key that is greater than
+   * given key
+   *
+   * @param key to search for
+   * @return iterator to the element
+   */
+  iterator upper_bound(const key_type &key) { return tree_.upper_bound(key); }
+
+  /**
+   * @brief Returns iterator to the first element with key that is greater than
+   * given key
+   *
+   * @param key to search for
+   * @return read only iterator to the element
+   */
+  const_iterator upper_bound(const key_type &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Finds element by any value comparable with the keys, no temporary
+   * key is constructed, e.g. @code std::string_view for the string keys.
+   * Enabled only for the transparent @code Compare such as @code std::less<>,
+   * as well as the overloads below
+   *
+   * @param key value to compare the keys with
+   * @return iterator to the element or @code end() if there is no such key
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) {
+    return tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator find(const Lookup &key) const {
+    return tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return tree_.contains(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<const_iterator, const_iterator>
+  equal_range(const Lookup &key) const {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator lower_bound(const Lookup &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) {
+    return tree_.upper_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  const_iterator upper_bound(const Lookup &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Inserts many elements at once, every argument is constructed into
+   * the separate pair
+   *
+   * @param args sequence of the pairs or of the arguments of their
+   * constructors
    * @return Vector<std::pair<iterator, bool>> - iterators to the inserted
    * elements and indicators if the insertion took place
    */
   template <class... Args>
-  Vector<std::pair<const_iterator, bool>> emplace(Args &&...args) {
-    return tree_.emplace(false, args...);
+  Vector<std::pair<const_iterator, bool>> insert_many(Args &&...args) {
+    return tree_.insert_many(false, std::forward<Args>(args)...);
   }
 
+  template <class K, class M, class C, template <class> class A, bool R,
+            class Predicate>
+  friend typename Map<K, M, C, A, R>::size_type
+  erase_if(Map<K, M, C, A, R> &container, Predicate pred);
+
 private:
   binary_tree tree_;
 };
 
+/**
+ * @brief Removes all the elements that satisfy the predicate with one
+ * traversal of the container. If erasing them one by one costs more than
+ * relinking the nodes that stay into the balanced tree, they are relinked at
+ * once, so it takes linear time
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the element and returns true if it has to
+ * be removed
+ * @return amount of the removed elements
+ */
+template <class K, class M, class C, template <class> class A, bool R,
+          class Predicate>
+typename Map<K, M, C, A, R>::size_type
+erase_if(Map<K, M, C, A, R> &container, Predicate pred) {
+  return container.tree_.erase_if(pred);
+}
+
 } // namespace custom
 
 #endif // _ASSOCIATIVE_CONTAINERS_MAP_CUSTOM_MAP_H_
\ No newline at end of file
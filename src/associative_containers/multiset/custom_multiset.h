@@ -1,7 +1,9 @@
 #ifndef _ASSOCIATIVE_CONTAINERS_MULTISET_CUSTOM_MULTISET_H_
 #define _ASSOCIATIVE_CONTAINERS_MULTISET_CUSTOM_MULTISET_H_
 
+#include <iterator>
 #include <stdexcept>
+#include <utility>
 
 #include "../../misc/custom_binary_tree.h"
 
@@ -15,10 +17,18 @@ namespace custom {
  * @tparam Compare defaults to @code std::less<Key> and sorts values in
  * ascending order, but can be also @code std::greater<Key> for storing values
  * in descending order
+ * @tparam Allocator defaults to @code NodeAllocator__ that allocates every node
+ * separately, @code NodePool__ places nodes in the slabs of the container
+ * @tparam Ranked keeps subtree sizes in the nodes, so @code nth(),
+ * @code rank() and @code count_range() work in logarithmic time
  */
-template <class Key, class Compare = std::less<Key>> class Multiset {
+template <class Key, class Compare = std::less<Key>,
+          template <class> class Allocator = NodeAllocator__,
+          bool Ranked = false>
+class Multiset {
 public:
-  using binary_tree = SortedBinaryTree__<Key, Key, TypeOfValue__<Key>, Compare>;
+  using binary_tree = SortedBinaryTree__<Key, Key, TypeOfValue__<Key>, Compare,
+                                         Allocator, Ranked>;
   using key_type = typename binary_tree::key_type;
   using value_type = typename binary_tree::value_type;
   using key_compare = typename binary_tree::key_compare;
@@ -28,35 +38,42 @@ public:
   using size_type = typename binary_tree::size_type;
   using iterator = typename binary_tree::const_iterator;
   using const_iterator = iterator;
+  using node_type = typename binary_tree::node_handle;
 
   Multiset() = default;
   ~Multiset() = default;
 
-  Multiset(const Multiset &other) : Multiset() { *this = other; };
+  Multiset(const Multiset &other) = default;
 
   Multiset(Multiset &&) noexcept = default;
 
-  explicit Multiset(const std::initializer_list<value_type> &items) : tree_() {
-    *this = items;
-  }
+  explicit Multiset(const std::initializer_list<value_type> &items)
+      : tree_(items.begin(), items.end(), true) {}
 
-  Multiset &operator=(const Multiset &other) {
-    if (this != &other) {
-      tree_.clear();
-      for (auto &i : other)
-        tree_.insert(i, true);
-    }
-    return *this;
-  }
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  Multiset(InputIt first, InputIt last) : tree_(first, last, true) {}
+
+  Multiset &operator=(const Multiset &other) = default;
   Multiset &operator=(Multiset &&) noexcept = default;
 
   Multiset &operator=(const std::initializer_list<value_type> &items) {
-    tree_.clear();
-    for (auto &i : items)
-      tree_.insert(i, true);
+    tree_.assign(items.begin(), items.end(), true);
     return *this;
   }
 
+  /**
+   * @brief Replaces contents of the container with values from the range.
+   * Sorted ranges are linked into the balanced tree in linear time, other
+   * ranges are sorted first
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator to the past-end of the range
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    tree_.assign(first, last, true);
+  }
+
   /**
    * @brief Returns iterator to the start of set
    *
@@ -97,6 +114,14 @@ public:
    */
   void clear() { tree_.clear(); }
 
+  /**
+   * @brief Removes all stored values from the container in constant time. The
+   * values are destroyed and the memory is freed later by the background
+   * thread, @code custom::Reclaimer__::instance().wait() waits for it
+   *
+   */
+  void clear_async() { tree_.clear_async(); }
+
   /**
    * @brief Inserts a new value into container
    *
@@ -108,6 +133,65 @@ public:
     return (iterator)tree_.insert(value, true).first;
   }
 
+  /**
+   * @brief Inserts a new value into container by moving it into the node
+   *
+   * @param value what to insert
+   * @return read only iterator to where value was inserted
+   */
+  iterator insert(double_reference value) {
+    return tree_.insert(std::move(value), true).first;
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint. If the value
+   * belongs right before or right after the hint, it is linked without the
+   * search from the root
+   *
+   * @param hint iterator to the element next to the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value
+   */
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value, true);
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint by moving it
+   * into the node
+   *
+   * @param hint iterator to the element next to the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value
+   */
+  iterator insert(const_iterator hint, double_reference value) {
+    return tree_.insert(hint, std::move(value), true);
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element next to the place of the value
+   * @param args arguments of the value constructor
+   * @return iterator to the inserted value
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_.emplace_hint(hint, true, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments right inside the node
+   * and inserts it after all the equal values
+   *
+   * @param args arguments of the value constructor
+   * @return read only iterator to the inserted value
+   */
+  template <class... Args> iterator emplace(Args &&...args) {
+    return tree_.emplace(true, std::forward<Args>(args)...).first;
+  }
+
   /**
    * @brief Removes value that stores where the pos points
    *
@@ -115,6 +199,88 @@ public:
    */
   void erase(iterator pos) { tree_.erase(pos); }
 
+  /**
+   * @brief Removes all the values of the range. The range is cut out of
+   * the tree at its ends and the parts around it are joined back, so it takes
+   * log(n) steps besides the removed values
+   *
+   * @param first iterator to the first value to remove
+   * @param last iterator after the last value to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
+  /**
+   * @brief Removes all the values equal to the key
+   *
+   * @param key value to remove
+   * @return amount of the removed values
+   */
+  size_type erase(const key_type &key) {
+    size_type old_size = size();
+    auto range = tree_.equal_range(key);
+    tree_.erase(range.first, range.second);
+    return old_size - size();
+  }
+
+  /**
+   * @brief Unlinks the node of the element from the container and passes
+   * its ownership to the handle, nothing is copied or freed. With
+   * @code NodePool__ the value is moved into a node of the handle instead,
+   * so the handle stays valid after the container is gone
+   *
+   * @param pos iterator to the element
+   * @return handle that owns the node
+   */
+  node_type extract(const_iterator pos) { return tree_.extract(pos); }
+
+  /**
+   * @brief Unlinks the node of the first element with given key from the
+   * container and passes its ownership to the handle. If there is no such
+   * key returns empty handle
+   *
+   * @param key key of the element
+   * @return handle that owns the node
+   */
+  node_type extract(const key_type &key) { return tree_.extract(key); }
+
+  /**
+   * @brief Inserts the node owned by the handle without allocation and
+   * without copying of the value, unless the container uses
+   * @code NodePool__
+   *
+   * @param handle node extracted from the container of the same type
+   * @return read only iterator to the inserted value
+   */
+  iterator insert(node_type &&handle) {
+    return tree_.insert(std::move(handle), true).position;
+  }
+
+  /**
+   * @brief Inserts all the values of the range at once. The batch is sorted
+   * first and linked in key order, every value follows the equal values
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator after the last value of the range
+   * @return amount of the inserted values
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return tree_.insert(first, last, true);
+  }
+
+  /**
+   * @brief Inserts all the values of the list at once in key order
+   *
+   * @param items list of the values
+   * @return amount of the inserted values
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return tree_.insert(items.begin(), items.end(), true);
+  }
+
   /**
    * @brief Swaps contents and size of the container with other map
    *
@@ -129,6 +295,97 @@ public:
    */
   void merge(Multiset &other) { tree_.merge(other.tree_, true); }
 
+  /**
+   * @brief Moves all the values that are not less than the key into the new
+   * container. Nodes are relinked without allocation in logarithmic time,
+   * but unless the container is @code Ranked the smaller part is also
+   * counted. Nodes are copied only if the containers use @code NodePool__
+   *
+   * @param key the smallest possible key of the new container
+   * @return container with the values that are not less than the key
+   */
+  Multiset split(const key_type &key) {
+    Multiset greater;
+    tree_.split(key, greater.tree_);
+    return greater;
+  }
+
+  /**
+   * @brief Moves all the values of other container to the end of this one in
+   * logarithmic time. Nodes are relinked without allocation, they are copied
+   * only if the containers use @code NodePool__. If the keys of the
+   * containers overlap - throws @code std::invalid_argument
+   *
+   * @param other container with the values not less than all the values of
+   * this one
+   */
+  void join(Multiset &other) { tree_.join(other.tree_, true); }
+
+  /**
+   * @brief Returns a new container with the elements that are in this or in
+   * other container, every key is repeated as many times as in the container
+   * where it occurs more. Both containers are walked in order at the same time,
+   * so it takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Multiset set_union(const Multiset &other,
+                     size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kUnion, thread_count);
+  }
+
+  /**
+   * @brief Returns a new container with the elements that are in both
+   * containers, every key is repeated as many times as in the container where
+   * it occurs less. Both containers are walked in order at the same time, so it
+   * takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Multiset set_intersection(const Multiset &other,
+                            size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kIntersection, thread_count);
+  }
+
+  /**
+   * @brief Returns a new container with the elements of this container that are
+   * not in other container, every key loses as many copies as other container
+   * has. Both containers are walked in order at the same time, so it takes
+   * linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Multiset set_difference(const Multiset &other,
+                          size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kDifference, thread_count);
+  }
+
+  /**
+   * @brief Returns a new container with the elements that are only in one of
+   * the containers, every key is repeated as many times as the difference of
+   * its counts. Both containers are walked in order at the same time, so it
+   * takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Multiset set_symmetric_difference(const Multiset &other,
+                                    size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kSymmetricDifference,
+                         thread_count);
+  }
+
   /**
    * @brief Returns count of the elements with given key that stored in the
    * container
@@ -136,7 +393,11 @@ public:
    * @param key value to count
    */
   size_type count(const key_type &key) const {
-    return count_and_find_last(key).second;
+    if constexpr (Ranked)
+      return tree_.count(key);
+    else
+      return static_cast<size_type>(
+          std::distance(lower_bound(key), upper_bound(key)));
   }
 
   /**
@@ -155,6 +416,48 @@ public:
    */
   bool contains(const key_type &key) const { return tree_.contains(key); }
 
+  /**
+   * @brief Finds element by the key starting the search from the hint. Search
+   * takes time logarithmic in the distance between the hint and the element
+   *
+   * @param hint iterator to the element near the searched one
+   * @param key value to search for
+   * @return read only iterator to the element or @code end() if there is no
+   * such value
+   */
+  iterator find(const_iterator hint, const key_type &key) const {
+    return tree_.find(hint, key);
+  }
+
+  /**
+   * @brief Returns iterator to the element with given index in the sorted
+   * order. If index is out of range returns @code end(). Available only for
+   * ranked containers
+   *
+   * @param index position of the element starting from zero
+   * @return read only iterator to the element
+   */
+  iterator nth(size_type index) const { return tree_.nth(index); }
+
+  /**
+   * @brief Returns count of the elements that are less than given key.
+   * Available only for ranked containers
+   *
+   * @param key value to compare with
+   */
+  size_type rank(const key_type &key) const { return tree_.rank(key); }
+
+  /**
+   * @brief Returns count of the elements that are not less than low and less
+   * than high. Available only for ranked containers
+   *
+   * @param low the smallest key of the range
+   * @param high past-end key of the range
+   */
+  size_type count_range(const key_type &low, const key_type &high) const {
+    return tree_.count_range(low, high);
+  }
+
   /**
    * @brief Returns pair of iterators: first iterator points at the first value
    * that is not less than given key, second iterator points at the first value
@@ -164,7 +467,7 @@ public:
    * @return pair of read only iterators
    */
   std::pair<iterator, iterator> equal_range(const key_type &key) const {
-    return count_and_find_last(key).first;
+    return tree_.equal_range(key);
   }
 
   /**
@@ -174,7 +477,7 @@ public:
    * @return read only iterator
    */
   iterator lower_bound(const key_type &key) const {
-    return count_and_find_last(key).first.second;
+    return tree_.lower_bound(key);
   }
 
   /**
@@ -184,49 +487,100 @@ public:
    * @return read only iterator
    */
   iterator upper_bound(const key_type &key) const {
-    return (iterator)(++(count_and_find_last(key).first.first));
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Finds the first value equal to any object comparable with the
+   * keys, no temporary key is constructed. Enabled only for the transparent
+   * @code Compare such as @code std::less<>, as well as the overloads below
+   *
+   * @param key object to compare the values with
+   * @return read only iterator to the value or @code end() if there is no
+   * such value
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) const {
+    return (iterator)tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return tree_.contains(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  size_type count(const Lookup &key) const {
+    if constexpr (Ranked)
+      return tree_.count(key);
+    else
+      return static_cast<size_type>(
+          std::distance(lower_bound(key), upper_bound(key)));
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) const {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) const {
+    return tree_.upper_bound(key);
   }
 
   /**
-   * @brief Inserts many elements at once
+   * @brief Inserts many elements at once, every argument is constructed into
+   * the separate value
    *
-   * @param args sequence of already constructed elements
+   * @param args sequence of the values or of the arguments of their
+   * constructors
    * @return Vector<std::pair<iterator, bool>> - iterators to the inserted
    * elements and indicators if the insertion took place
    */
   template <typename... Args>
-  Vector<std::pair<iterator, bool>> emplace(Args &&...args) {
-    return tree_.emplace(true, args...);
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_.insert_many(true, std::forward<Args>(args)...);
   }
 
+  template <class K, class C, template <class> class A, bool R,
+            class Predicate>
+  friend typename Multiset<K, C, A, R>::size_type
+  erase_if(Multiset<K, C, A, R> &container, Predicate pred);
+
 private:
   binary_tree tree_;
 
-  std::pair<std::pair<iterator, iterator>, size_type>
-  count_and_find_last(const key_type &key) const {
-    size_type result = 0;
-    iterator first = tree_.find(key);
-    if (!first.data())
-      return std::pair<std::pair<iterator, iterator>, size_type>{
-          std::pair<iterator, iterator>{iterator(nullptr, tree_.root()),
-                                        iterator(nullptr, tree_.root())},
-          result};
-    ++result;
-    iterator el(first);
-    --el;
-    while (el.data() && *first == *el) {
-      ++result;
-      --el;
-    }
-    if (el.data())
-      ++el;
-    else
-      el = begin();
-    return std::pair<std::pair<iterator, iterator>, size_type>{
-        std::pair<iterator, iterator>{first, el}, result};
-  };
+  Multiset set_operation(const Multiset &other, SetOperation__ operation,
+                         size_type thread_count) const {
+    Multiset result;
+    result.tree_.assign_set_operation(tree_, other.tree_, operation,
+                                      thread_count);
+    return result;
+  }
 };
 
+/**
+ * @brief Removes all the values that satisfy the predicate with one
+ * traversal of the container. If erasing them one by one costs more than
+ * relinking the nodes that stay into the balanced tree, they are relinked at
+ * once, so it takes linear time
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the value and returns true if it has to
+ * be removed
+ * @return amount of the removed values
+ */
+template <class K, class C, template <class> class A, bool R, class Predicate>
+typename Multiset<K, C, A, R>::size_type
+erase_if(Multiset<K, C, A, R> &container, Predicate pred) {
+  return container.tree_.erase_if(pred);
+}
+
 } // namespace custom
 
 #endif // _ASSOCIATIVE_CONTAINERS_MULTISET_CUSTOM_MULTISET_H_
\ No newline at end of file
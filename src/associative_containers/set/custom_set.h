@@ -1,6 +1,8 @@
 #ifndef _ASSOCIATIVE_CONTAINERS_SET_CUSTOM_SET_H_
 #define _ASSOCIATIVE_CONTAINERS_SET_CUSTOM_SET_H_
 
+#include <utility>
+
 #include "../../misc/custom_binary_tree.h"
 
 namespace custom {
@@ -13,37 +15,61 @@ namespace custom {
  * @tparam Compare defaults to @code std::less<Key> and sorts values in
  * ascending order, but can be also @code std::greater<Key> for storing values
  * in descending order
+ * @tparam Allocator defaults to @code NodeAllocator__ that allocates every node
+ * separately, @code NodePool__ places nodes in the slabs of the container
+ * @tparam Ranked keeps subtree sizes in the nodes, so @code nth(),
+ * @code rank() and @code count_range() work in logarithmic time
  */
-template <class Key, class Compare = std::less<Key>> class Set {
+template <class Key, class Compare = std::less<Key>,
+          template <class> class Allocator = NodeAllocator__,
+          bool Ranked = false>
+class Set {
 public:
-  using binary_tree = SortedBinaryTree__<Key, Key, TypeOfValue__<Key>, Compare>;
+  using binary_tree = SortedBinaryTree__<Key, Key, TypeOfValue__<Key>, Compare,
+                                         Allocator, Ranked>;
   using key_type = typename binary_tree::key_type;
   using value_type = typename binary_tree::value_type;
   using reference = typename binary_tree::reference;
   using const_reference = typename binary_tree::const_reference;
+  using double_reference = typename binary_tree::double_reference;
   using size_type = typename binary_tree::size_type;
   using const_iterator = typename binary_tree::const_iterator;
   using iterator = const_iterator;
+  using node_type = typename binary_tree::node_handle;
+  using insert_return_type = typename binary_tree::insert_return_type;
 
   Set() = default;
   Set(const Set &other) = default;
   Set(Set &&other) noexcept = default;
   ~Set() = default;
 
-  explicit Set(const std::initializer_list<value_type> &items) : tree_() {
-    *this = items;
-  }
+  explicit Set(const std::initializer_list<value_type> &items)
+      : tree_(items.begin(), items.end()) {}
+
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  Set(InputIt first, InputIt last) : tree_(first, last) {}
 
   Set &operator=(const Set &other) = default;
   Set &operator=(Set &&other) = default;
 
   Set &operator=(const std::initializer_list<value_type> &items) {
-    tree_.clear();
-    for (const auto &i : items)
-      tree_.insert(i);
+    tree_.assign(items.begin(), items.end());
     return *this;
   }
 
+  /**
+   * @brief Replaces contents of the container with values from the range.
+   * Sorted ranges are linked into the balanced tree in linear time, other
+   * ranges are sorted first
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator to the past-end of the range
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    tree_.assign(first, last);
+  }
+
   /**
    * @brief Returns iterator to the start of set
    *
@@ -84,6 +110,14 @@ public:
    */
   void clear() { tree_.clear(); }
 
+  /**
+   * @brief Removes all stored values from the container in constant time. The
+   * values are destroyed and the memory is freed later by the background
+   * thread, @code custom::Reclaimer__::instance().wait() waits for it
+   *
+   */
+  void clear_async() { tree_.clear_async(); }
+
   /**
    * @brief Inserts a new value into container
    *
@@ -96,6 +130,73 @@ public:
     return std::pair<iterator, bool>{mid_res.first, mid_res.second};
   }
 
+  /**
+   * @brief Inserts a new value into container by moving it into the node. If
+   * the value is already in the container, it is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    auto mid_res = tree_.insert(std::move(value));
+    return std::pair<iterator, bool>{mid_res.first, mid_res.second};
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint. If the value
+   * belongs right before or right after the hint, it is linked without the
+   * search from the root
+   *
+   * @param hint iterator to the element next to the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value or to the equal value
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value);
+  }
+
+  /**
+   * @brief Inserts a new value into container using the hint by moving it
+   * into the node
+   *
+   * @param hint iterator to the element next to the place of the value
+   * @param value what to insert
+   * @return read only iterator to the inserted value or to the equal value
+   * that prevented the insertion
+   */
+  iterator insert(const_iterator hint, double_reference value) {
+    return tree_.insert(hint, std::move(value));
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it using the
+   * hint
+   *
+   * @param hint iterator to the element next to the place of the value
+   * @param args arguments of the value constructor
+   * @return iterator to the inserted value
+   */
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return tree_.emplace_hint(hint, false, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments right inside the node
+   * and inserts it. If the value is already in the container, the node is
+   * freed
+   *
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read only iterator to the inserted
+   * value or to the equal value and bool indicating if insertion took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    auto mid_res = tree_.emplace(false, std::forward<Args>(args)...);
+    return std::pair<iterator, bool>{mid_res.first, mid_res.second};
+  }
+
   /**
    * @brief Removes value that stores where the pos points
    *
@@ -103,6 +204,92 @@ public:
    */
   void erase(iterator pos) { tree_.erase(pos); }
 
+  /**
+   * @brief Removes all the values of the range. The range is cut out of
+   * the tree at its ends and the parts around it are joined back, so it takes
+   * log(n) steps besides the removed values
+   *
+   * @param first iterator to the first value to remove
+   * @param last iterator after the last value to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  }
+
+  /**
+   * @brief Removes the value equal to the key
+   *
+   * @param key value to remove
+   * @return amount of the removed values, 0 or 1
+   */
+  size_type erase(const key_type &key) {
+    iterator pos = find(key);
+    if (pos == end())
+      return 0UL;
+    tree_.erase(pos);
+    return 1UL;
+  }
+
+  /**
+   * @brief Unlinks the node of the element from the container and passes
+   * its ownership to the handle, nothing is copied or freed. With
+   * @code NodePool__ the value is moved into a node of the handle instead,
+   * so the handle stays valid after the container is gone
+   *
+   * @param pos iterator to the element
+   * @return handle that owns the node
+   */
+  node_type extract(const_iterator pos) { return tree_.extract(pos); }
+
+  /**
+   * @brief Unlinks the node of the first element with given key from the
+   * container and passes its ownership to the handle. If there is no such
+   * key returns empty handle
+   *
+   * @param key key of the element
+   * @return handle that owns the node
+   */
+  node_type extract(const key_type &key) { return tree_.extract(key); }
+
+  /**
+   * @brief Inserts the node owned by the handle without allocation and
+   * without copying of the value, unless the container uses
+   * @code NodePool__. If the key is already in the container, the node stays
+   * in the handle
+   *
+   * @param handle node extracted from the container of the same type
+   * @return iterator to the inserted or equal value, indicator if the
+   * insertion took place and the handle with the node that wasn't inserted
+   */
+  insert_return_type insert(node_type &&handle) {
+    return tree_.insert(std::move(handle));
+  }
+
+  /**
+   * @brief Inserts all the values of the range at once. The batch is sorted
+   * first and linked in key order, values that are already in the container
+   * are skipped
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator after the last value of the range
+   * @return amount of the inserted values
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return tree_.insert(first, last);
+  }
+
+  /**
+   * @brief Inserts all the values of the list at once in key order
+   *
+   * @param items list of the values
+   * @return amount of the inserted values
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return tree_.insert(items.begin(), items.end());
+  }
+
   /**
    * @brief Swaps contents and size of the container with other map
    *
@@ -117,6 +304,90 @@ public:
    */
   void merge(Set &other) { tree_.merge(other.tree_); }
 
+  /**
+   * @brief Moves all the values that are not less than the key into the new
+   * container. Nodes are relinked without allocation in logarithmic time,
+   * but unless the container is @code Ranked the smaller part is also
+   * counted. Nodes are copied only if the containers use @code NodePool__
+   *
+   * @param key the smallest possible key of the new container
+   * @return container with the values that are not less than the key
+   */
+  Set split(const key_type &key) {
+    Set greater;
+    tree_.split(key, greater.tree_);
+    return greater;
+  }
+
+  /**
+   * @brief Moves all the values of other container to the end of this one in
+   * logarithmic time. Nodes are relinked without allocation, they are copied
+   * only if the containers use @code NodePool__. If the keys of the
+   * containers overlap - throws @code std::invalid_argument
+   *
+   * @param other container with the values greater than all the values of
+   * this one
+   */
+  void join(Set &other) { tree_.join(other.tree_); }
+
+  /**
+   * @brief Returns a new container with the elements that are in this or in
+   * other container. Both containers are walked in order at the same time, so
+   * it takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Set set_union(const Set &other, size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kUnion, thread_count);
+  }
+
+  /**
+   * @brief Returns a new container with the elements that are in both
+   * containers. Both containers are walked in order at the same time, so it
+   * takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Set set_intersection(const Set &other, size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kIntersection, thread_count);
+  }
+
+  /**
+   * @brief Returns a new container with the elements of this container that are
+   * not in other container. Both containers are walked in order at the same
+   * time, so it takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Set set_difference(const Set &other, size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kDifference, thread_count);
+  }
+
+  /**
+   * @brief Returns a new container with the elements that are only in one of
+   * the containers. Both containers are walked in order at the same time, so it
+   * takes linear time
+   *
+   * @param other the second operand
+   * @param thread_count maximum count of threads, large containers are split
+   * into the key ranges that are processed in parallel
+   * @return container with the result
+   */
+  Set set_symmetric_difference(const Set &other,
+                               size_type thread_count = 1UL) const {
+    return set_operation(other, SetOperation__::kSymmetricDifference,
+                         thread_count);
+  }
+
   /**
    * @brief Finds element in the container by the key and returns an iterator to
    * it. If element is not in the container returns @code end()
@@ -134,21 +405,161 @@ public:
   bool contains(const key_type &key) const { return tree_.contains(key); }
 
   /**
-   * @brief Inserts many elements at once
+   * @brief Finds element by the key starting the search from the hint. Search
+   * takes time logarithmic in the distance between the hint and the element
+   *
+   * @param hint iterator to the element near the searched one
+   * @param key value to search for
+   * @return read only iterator to the element or @code end() if there is no
+   * such value
+   */
+  iterator find(const_iterator hint, const key_type &key) const {
+    return tree_.find(hint, key);
+  }
+
+  /**
+   * @brief Returns iterator to the element with given index in the sorted
+   * order. If index is out of range returns @code end(). Available only for
+   * ranked containers
+   *
+   * @param index position of the element starting from zero
+   * @return read only iterator to the element
+   */
+  iterator nth(size_type index) const { return tree_.nth(index); }
+
+  /**
+   * @brief Returns count of the elements that are less than given key.
+   * Available only for ranked containers
+   *
+   * @param key value to compare with
+   */
+  size_type rank(const key_type &key) const { return tree_.rank(key); }
+
+  /**
+   * @brief Returns count of the elements that are not less than low and less
+   * than high. Available only for ranked containers
+   *
+   * @param low the smallest key of the range
+   * @param high past-end key of the range
+   */
+  size_type count_range(const key_type &low, const key_type &high) const {
+    return tree_.count_range(low, high);
+  }
+
+  /**
+   * @brief Returns pair of iterators: first iterator points at the first value
+   * that is not less than given key, second iterator points at the first value
+   * that is greater than given key
+   *
+   * @param key value to search range for
+   * @return pair of read only iterators
+   */
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return tree_.equal_range(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first value that is not less than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  iterator lower_bound(const key_type &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  /**
+   * @brief Returns iterator to the first value that is greater than given key
+   *
+   * @param key to search for
+   * @return read only iterator
+   */
+  iterator upper_bound(const key_type &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Finds the value equal to any object comparable with the keys, no
+   * temporary key is constructed. Enabled only for the transparent
+   * @code Compare such as @code std::less<>, as well as the overloads below
    *
-   * @param args sequence of already constructed elements
+   * @param key object to compare the values with
+   * @return read only iterator to the value or @code end() if there is no
+   * such value
+   */
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator find(const Lookup &key) const {
+    return tree_.find(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  bool contains(const Lookup &key) const {
+    return tree_.contains(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  std::pair<iterator, iterator> equal_range(const Lookup &key) const {
+    return tree_.equal_range(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator lower_bound(const Lookup &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class Lookup, class C = Compare, class = RequireTransparent__<C>>
+  iterator upper_bound(const Lookup &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  /**
+   * @brief Inserts many elements at once, every argument is constructed into
+   * the separate value
+   *
+   * @param args sequence of the values or of the arguments of their
+   * constructors
    * @return Vector<std::pair<iterator, bool>> - iterators to the inserted
    * elements and indicators if the insertion took place
    */
   template <class... Args>
-  Vector<std::pair<iterator, bool>> emplace(Args &&...args) {
-    return tree_.emplace(false, args...);
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return tree_.insert_many(false, std::forward<Args>(args)...);
   }
 
+  template <class K, class C, template <class> class A, bool R,
+            class Predicate>
+  friend typename Set<K, C, A, R>::size_type
+  erase_if(Set<K, C, A, R> &container, Predicate pred);
+
 private:
   binary_tree tree_;
+
+  Set set_operation(const Set &other, SetOperation__ operation,
+                    size_type thread_count) const {
+    Set result;
+    result.tree_.assign_set_operation(tree_, other.tree_, operation,
+                                      thread_count);
+    return result;
+  }
 };
 
+/**
+ * @brief Removes all the values that satisfy the predicate with one
+ * traversal of the container. If erasing them one by one costs more than
+ * relinking the nodes that stay into the balanced tree, they are relinked at
+ * once, so it takes linear time
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the value and returns true if it has to
+ * be removed
+ * @return amount of the removed values
+ */
+template <class K, class C, template <class> class A, bool R, class Predicate>
+typename Set<K, C, A, R>::size_type
+erase_if(Set<K, C, A, R> &container, Predicate pred) {
+  return container.tree_.erase_if(pred);
+}
+
 } // namespace custom
 
 #endif // _ASSOCIATIVE_CONTAINERS_SET_CUSTOM_SET_H_
\ No newline at end of file
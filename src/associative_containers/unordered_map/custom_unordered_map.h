@@ -0,0 +1,488 @@
+#ifndef _ASSOCIATIVE_CONTAINERS_UNORDERED_MAP_CUSTOM_UNORDERED_MAP_H_
+#define _ASSOCIATIVE_CONTAINERS_UNORDERED_MAP_CUSTOM_UNORDERED_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../../misc/custom_hash_table.h"
+
+namespace custom {
+
+/**
+ * @brief Container to store pairs with unique keys in no particular order,
+ * based on the open addressing hash table. It has the interface of
+ * @code Map without the ordered lookups, but finds a key in constant time:
+ * the pairs are kept right in one array and the control bytes of a whole
+ * group of them are compared with the hash by one SIMD instruction. The
+ * growth of the table invalidates all the iterators and references, erasure
+ * invalidates only the ones to the erased pair
+ *
+ * @tparam Key type of keys of pairs
+ * @tparam T values of pairs
+ * @tparam Hash defaults to @code std::hash<Key>
+ * @tparam KeyEqual defaults to @code std::equal_to<Key>
+ */
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class UnorderedMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using table = HashTable__<key_type, value_type,
+                            PairFirstElement__<value_type>, Hash, KeyEqual>;
+  using hasher = typename table::hasher;
+  using key_equal = typename table::key_equal;
+  using key_identify = typename table::key_identify;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using double_reference = value_type &&;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+  using size_type = typename table::size_type;
+
+  UnorderedMap() = default;
+  UnorderedMap(const UnorderedMap &other) = default;
+  UnorderedMap(UnorderedMap &&other) = default;
+  ~UnorderedMap() = default;
+  explicit UnorderedMap(const std::initializer_list<value_type> &items)
+      : table_(items.begin(), items.end()) {}
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  UnorderedMap(InputIt first, InputIt last) : table_(first, last) {}
+
+  UnorderedMap &operator=(const UnorderedMap &other) = default;
+  UnorderedMap &operator=(UnorderedMap &&other) = default;
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - creates new one with default
+   * constructor and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](const key_type &key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  /**
+   * @brief Returns reference to the value of pair with given key. If there is
+   * no pair with given key in the container - moves the key into the new pair
+   * with default constructed value and returns reference to it
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &operator[](key_type &&key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  /**
+   * @brief Checks if there is value with given key and returns reference to it.
+   * If there is no value with given key - throws @code std::exception()
+   *
+   * @param key key to needed value
+   * @return read/write reference to the value of the pair
+   */
+  mapped_type &at(const key_type &key) {
+    auto is_contains = table_.find(key);
+    if (is_contains == table_.end())
+      throw std::exception();
+    return (*is_contains).second;
+  }
+
+  /**
+   * @brief Checks if there is value with given key and returns reference to it.
+   * If there is no value with given key - throws @code std::exception()
+   *
+   * @param key key to needed value
+   * @return read only reference to the value of the pair
+   */
+  const mapped_type &at(const key_type &key) const {
+    auto is_contains = table_.find(key);
+    if (is_contains == table_.end())
+      throw std::exception();
+    return (*is_contains).second;
+  }
+
+  /**
+   * @brief Returns iterator to the first pair of the container, the pairs go
+   * in the order of their slots
+   *
+   * @return read/write iterator
+   */
+  iterator begin() { return table_.begin(); }
+
+  /**
+   * @brief Returns iterator to the first pair of the container
+   *
+   * @return read only iterator
+   */
+  const_iterator begin() const { return table_.begin(); }
+
+  /**
+   * @brief Returns iterator to the past-end of the container
+   *
+   * @return read/write iterator
+   */
+  iterator end() { return table_.end(); }
+
+  /**
+   * @brief Returns iterator to the past-end of the container
+   *
+   * @return read only iterator
+   */
+  const_iterator end() const { return table_.end(); }
+
+  /**
+   * @brief Checks if container is empty
+   *
+   * @return true is empty
+   * @return false otherwise
+   */
+  bool empty() const { return table_.empty(); }
+
+  /**
+   * @brief Returns current size of the container
+   *
+   */
+  size_type size() const { return table_.size(); }
+
+  /**
+   * @brief Returns theoretical maximum container size due to OS arcitecture
+   *
+   */
+  size_type max_size() const { return table_.max_size(); }
+
+  /**
+   * @brief Returns amount of the slots of the table, it grows when 7/8 of
+   * them are taken
+   *
+   */
+  size_type capacity() const { return table_.capacity(); }
+
+  /**
+   * @brief Returns the ratio of the size to the amount of the slots
+   *
+   */
+  float load_factor() const { return table_.load_factor(); }
+
+  /**
+   * @brief Returns amount of bytes taken by the slots and the control bytes
+   * of the container, without the overhead of the memory allocator
+   *
+   */
+  size_type memory_usage() const { return table_.memory_usage(); }
+
+  /**
+   * @brief Removes all stored values from the container, the slots are kept
+   * for the next insertions
+   *
+   */
+  void clear() { table_.clear(); }
+
+  /**
+   * @brief Allocates the slots for at least count pairs, so that many
+   * insertions don't rehash the table
+   *
+   * @param count amount of the pairs to prepare the room for
+   */
+  void reserve(size_type count) { table_.reserve(count); }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const_reference value) {
+    return table_.insert(value);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving it into the slot. If the key is
+   * already in the container, the pair is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    return table_.insert(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &value) {
+    return try_emplace(key, value);
+  }
+
+  /**
+   * @brief Inserts a new pair by moving the value into the slot. If the key
+   * is already in the container, nothing is moved
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return std::pair<iterator, bool> - read/write iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const key_type &key, mapped_type &&value) {
+    return try_emplace(key, std::move(value));
+  }
+
+  /**
+   * @brief Inserts all the elements of the range one by one, elements with
+   * the keys that are already in the container are skipped
+   *
+   * @param first iterator to the first element of the range
+   * @param last iterator after the last element of the range
+   * @return amount of the inserted elements
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return table_.insert(first, last);
+  }
+
+  /**
+   * @brief Inserts all the elements of the list
+   *
+   * @param items list of the elements
+   * @return amount of the inserted elements
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return table_.insert(items.begin(), items.end());
+  }
+
+  /**
+   * @brief Inserts nev pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &value) {
+    auto insert_result = try_emplace(key, value);
+    if (!insert_result.second)
+      (*(insert_result.first)).second = value;
+    return insert_result;
+  }
+
+  /**
+   * @brief Inserts new pair with given key and value if there is no value with
+   * given key or changes value of the key if there already a pair with given
+   * key. The value is moved in both cases
+   *
+   * @param key key of the pair
+   * @param value value that corresponds to the given key
+   * @return read/write iterator to the pair with given key and indicator if new
+   * element was created
+   */
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             mapped_type &&value) {
+    auto insert_result = try_emplace(key, std::move(value));
+    // the value is untouched if the key was already in the container
+    if (!insert_result.second)
+      (*(insert_result.first)).second = std::move(value);
+    return insert_result;
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments right
+   * inside the slot only if there is no pair with given key
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return table_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs the value of the new pair from the arguments right
+   * inside the slot only if there is no pair with given key. The key is moved
+   * into the slot only if the insertion takes place
+   *
+   * @param key key of the pair
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the pair with
+   * given key and bool indicating if insertion took place
+   */
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return table_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Constructs a new pair from the arguments and inserts it, if there
+   * is no pair with the same key
+   *
+   * @param args arguments of the pair constructor
+   * @return std::pair<iterator, bool> - read/write iterator to the inserted
+   * pair or to the pair with the equal key and bool indicating if insertion
+   * took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Removes value that stores where the pos points. The other pairs
+   * stay in their slots
+   *
+   * @param pos iterator to the element
+   * @return iterator to the element that followed the removed one
+   */
+  iterator erase(const_iterator pos) {
+    iterator next(pos);
+    ++next;
+    table_.erase(pos);
+    return next;
+  }
+
+  /**
+   * @brief Removes all the elements of the range
+   *
+   * @param first iterator to the first element to remove
+   * @param last iterator after the last element to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last)
+      first = erase(first);
+    return iterator(last);
+  }
+
+  /**
+   * @brief Removes value with given key
+   *
+   * @param key key that needs to be deleted
+   * @return amount of the removed elements, 0 or 1
+   */
+  size_type erase(const key_type &key) { return table_.erase_key(key); }
+
+  /**
+   * @brief Swaps contents and size of the container with other map
+   *
+   * @param other container to be swapped
+   */
+  void swap(UnorderedMap &other) { table_.swap(other.table_); }
+
+  /**
+   * @brief Moves the elements with new keys from other container into this
+   * one, the elements with the keys that are already here stay in other
+   * container
+   *
+   * @param other container to be merged with
+   */
+  void merge(UnorderedMap &other) { table_.merge(other.table_); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read/write iterator to the element
+   */
+  iterator find(const key_type &key) { return table_.find(key); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read only iterator to the element
+   */
+  const_iterator find(const key_type &key) const { return table_.find(key); }
+
+  /**
+   * @brief Checks if the map contains element with given key
+   *
+   * @return true if contains
+   * @return false otherwise
+   */
+  bool contains(const key_type &key) const { return table_.contains(key); }
+
+  /**
+   * @brief Returns amount of the pairs with given key
+   *
+   * @return 0 or 1
+   */
+  size_type count(const key_type &key) const { return table_.count(key); }
+
+  /**
+   * @brief Finds the pair by any object that can be hashed and compared with
+   * the keys, no temporary key is constructed. Enabled only if both
+   * @code Hash and @code KeyEqual are transparent, as well as the overloads
+   * below. Equal objects must have the same hash as the equal keys
+   *
+   * @param key object to compare the keys with
+   * @return iterator to the pair or @code end() if there is no such key
+   */
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  iterator find(const Lookup &key) {
+    return table_.find(key);
+  }
+
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  const_iterator find(const Lookup &key) const {
+    return table_.find(key);
+  }
+
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  bool contains(const Lookup &key) const {
+    return table_.contains(key);
+  }
+
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  size_type count(const Lookup &key) const {
+    return table_.count(key);
+  }
+
+  template <class K, class M, class H, class E, class Predicate>
+  friend typename UnorderedMap<K, M, H, E>::size_type
+  erase_if(UnorderedMap<K, M, H, E> &container, Predicate pred);
+
+private:
+  table table_;
+};
+
+/**
+ * @brief Removes all the elements that satisfy the predicate with one
+ * traversal of the slots
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the pair and returns true if it has to be
+ * removed
+ * @return amount of the removed elements
+ */
+template <class K, class M, class H, class E, class Predicate>
+typename UnorderedMap<K, M, H, E>::size_type
+erase_if(UnorderedMap<K, M, H, E> &container, Predicate pred) {
+  return container.table_.erase_if(pred);
+}
+
+} // namespace custom
+
+#endif // _ASSOCIATIVE_CONTAINERS_UNORDERED_MAP_CUSTOM_UNORDERED_MAP_H_
@@ -0,0 +1,307 @@
+#ifndef _ASSOCIATIVE_CONTAINERS_UNORDERED_SET_CUSTOM_UNORDERED_SET_H_
+#define _ASSOCIATIVE_CONTAINERS_UNORDERED_SET_CUSTOM_UNORDERED_SET_H_
+
+#include <utility>
+
+#include "../../misc/custom_hash_table.h"
+
+namespace custom {
+
+/**
+ * @brief Container that stores unique values in no particular order, based
+ * on the open addressing hash table. It has the interface of @code Set
+ * without the ordered lookups, but finds a value in constant time: the values
+ * are kept right in one array and the control bytes of a whole group of them
+ * are compared with the hash by one SIMD instruction. The growth of the table
+ * invalidates all the iterators, erasure invalidates only the ones to the
+ * erased value
+ *
+ * @tparam Key type of value to be stored
+ * @tparam Hash defaults to @code std::hash<Key>
+ * @tparam KeyEqual defaults to @code std::equal_to<Key>
+ */
+template <class Key, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class UnorderedSet {
+public:
+  using table = HashTable__<Key, Key, TypeOfValue__<Key>, Hash, KeyEqual>;
+  using key_type = typename table::key_type;
+  using value_type = typename table::value_type;
+  using hasher = typename table::hasher;
+  using key_equal = typename table::key_equal;
+  using reference = typename table::reference;
+  using const_reference = typename table::const_reference;
+  using double_reference = typename table::double_reference;
+  using size_type = typename table::size_type;
+  using const_iterator = typename table::const_iterator;
+  using iterator = const_iterator;
+
+  UnorderedSet() = default;
+  UnorderedSet(const UnorderedSet &other) = default;
+  UnorderedSet(UnorderedSet &&other) noexcept = default;
+  ~UnorderedSet() = default;
+
+  explicit UnorderedSet(const std::initializer_list<value_type> &items)
+      : table_(items.begin(), items.end()) {}
+
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  UnorderedSet(InputIt first, InputIt last) : table_(first, last) {}
+
+  UnorderedSet &operator=(const UnorderedSet &other) = default;
+  UnorderedSet &operator=(UnorderedSet &&other) = default;
+
+  /**
+   * @brief Returns iterator to the first value of set, the values go in the
+   * order of their slots
+   *
+   * @return read only iterator
+   */
+  iterator begin() const { return table_.begin(); }
+
+  /**
+   * @brief Returns iterator to the past-end of set
+   *
+   * @return read only iterator
+   */
+  iterator end() const { return table_.end(); }
+
+  /**
+   * @brief Checks if container is empty
+   *
+   * @return true is empty
+   * @return false otherwise
+   */
+  bool empty() const { return table_.empty(); }
+
+  /**
+   * @brief Returns current size of the container
+   *
+   */
+  size_type size() const { return table_.size(); }
+
+  /**
+   * @brief Returns theoretical maximum container size due to OS arcitecture
+   *
+   */
+  size_type max_size() const { return table_.max_size(); }
+
+  /**
+   * @brief Returns amount of the slots of the table, it grows when 7/8 of
+   * them are taken
+   *
+   */
+  size_type capacity() const { return table_.capacity(); }
+
+  /**
+   * @brief Returns the ratio of the size to the amount of the slots
+   *
+   */
+  float load_factor() const { return table_.load_factor(); }
+
+  /**
+   * @brief Returns amount of bytes taken by the slots and the control bytes
+   * of the container, without the overhead of the memory allocator
+   *
+   */
+  size_type memory_usage() const { return table_.memory_usage(); }
+
+  /**
+   * @brief Removes all stored values from the container, the slots are kept
+   * for the next insertions
+   *
+   */
+  void clear() { table_.clear(); }
+
+  /**
+   * @brief Allocates the slots for at least count values, so that many
+   * insertions don't rehash the table
+   *
+   * @param count amount of the values to prepare the room for
+   */
+  void reserve(size_type count) { table_.reserve(count); }
+
+  /**
+   * @brief Inserts a new value into container
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(const_reference value) {
+    return table_.insert(value);
+  }
+
+  /**
+   * @brief Inserts a new value into container by moving it into the slot. If
+   * the value is already in the container, it is left untouched
+   *
+   * @param value what to insert
+   * @return std::pair<iterator, bool> - read only iterator to where value was
+   * inserted and bool indicating if insertion took place
+   */
+  std::pair<iterator, bool> insert(double_reference value) {
+    return table_.insert(std::move(value));
+  }
+
+  /**
+   * @brief Inserts all the values of the range one by one, values that are
+   * already in the container are skipped
+   *
+   * @param first iterator to the first value of the range
+   * @param last iterator after the last value of the range
+   * @return amount of the inserted values
+   */
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last) {
+    return table_.insert(first, last);
+  }
+
+  /**
+   * @brief Inserts all the values of the list
+   *
+   * @param items list of the values
+   * @return amount of the inserted values
+   */
+  size_type insert(std::initializer_list<value_type> items) {
+    return table_.insert(items.begin(), items.end());
+  }
+
+  /**
+   * @brief Constructs a new value from the arguments and inserts it, if there
+   * is no equal value in the container
+   *
+   * @param args arguments of the value constructor
+   * @return std::pair<iterator, bool> - read only iterator to the inserted
+   * value or to the equal value and bool indicating if insertion took place
+   */
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Removes value that stores where the pos points. The other values
+   * stay in their slots
+   *
+   * @param pos iterator to the element
+   * @return iterator to the value that followed the removed one
+   */
+  iterator erase(iterator pos) {
+    iterator next(pos);
+    ++next;
+    table_.erase(pos);
+    return next;
+  }
+
+  /**
+   * @brief Removes all the values of the range
+   *
+   * @param first iterator to the first value to remove
+   * @param last iterator after the last value to remove
+   * @return iterator to the element that followed the removed ones
+   */
+  iterator erase(iterator first, iterator last) {
+    while (first != last)
+      first = erase(first);
+    return last;
+  }
+
+  /**
+   * @brief Removes the value equal to the key
+   *
+   * @param key value to remove
+   * @return amount of the removed values, 0 or 1
+   */
+  size_type erase(const key_type &key) { return table_.erase_key(key); }
+
+  /**
+   * @brief Swaps contents and size of the container with other set
+   *
+   * @param other container to be swapped
+   */
+  void swap(UnorderedSet &other) { table_.swap(other.table_); }
+
+  /**
+   * @brief Moves the values that are not in this container from other one,
+   * the rest stay in other container
+   *
+   * @param other container to be merged with
+   */
+  void merge(UnorderedSet &other) { table_.merge(other.table_); }
+
+  /**
+   * @brief Finds element in the container by the key and returns an iterator to
+   * it. If element is not in the container returns @code end()
+   *
+   * @return read only iterator to the element
+   */
+  iterator find(const key_type &key) const { return table_.find(key); }
+
+  /**
+   * @brief Checks if the set contains element with given key
+   *
+   * @return true if contains
+   * @return false otherwise
+   */
+  bool contains(const key_type &key) const { return table_.contains(key); }
+
+  /**
+   * @brief Returns amount of the values equal to the key
+   *
+   * @return 0 or 1
+   */
+  size_type count(const key_type &key) const { return table_.count(key); }
+
+  /**
+   * @brief Finds the value equal to any object that can be hashed and
+   * compared with the values, no temporary key is constructed. Enabled only
+   * if both @code Hash and @code KeyEqual are transparent, as well as the
+   * overloads below. Equal objects must have the same hash as the equal values
+   *
+   * @param key object to compare the values with
+   * @return read only iterator to the value or @code end() if there is no
+   * such value
+   */
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  iterator find(const Lookup &key) const {
+    return table_.find(key);
+  }
+
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  bool contains(const Lookup &key) const {
+    return table_.contains(key);
+  }
+
+  template <class Lookup, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent__<H>, class = RequireTransparent__<E>>
+  size_type count(const Lookup &key) const {
+    return table_.count(key);
+  }
+
+  template <class K, class H, class E, class Predicate>
+  friend typename UnorderedSet<K, H, E>::size_type
+  erase_if(UnorderedSet<K, H, E> &container, Predicate pred);
+
+private:
+  table table_;
+};
+
+/**
+ * @brief Removes all the values that satisfy the predicate with one
+ * traversal of the slots
+ *
+ * @param container container to remove from
+ * @param pred predicate that takes the value and returns true if it has to
+ * be removed
+ * @return amount of the removed values
+ */
+template <class K, class H, class E, class Predicate>
+typename UnorderedSet<K, H, E>::size_type
+erase_if(UnorderedSet<K, H, E> &container, Predicate pred) {
+  return container.table_.erase_if(pred);
+}
+
+} // namespace custom
+
+#endif // _ASSOCIATIVE_CONTAINERS_UNORDERED_SET_CUSTOM_UNORDERED_SET_H_
@@ -0,0 +1,9 @@
+#include <benchmark/benchmark.h>
+
+#include "btree/btree_benchmarks.h"
+#include "flat_map/flat_map_benchmarks.h"
+#include "map/map_benchmarks.h"
+#include "set/set_benchmarks.h"
+#include "unordered_map/unordered_map_benchmarks.h"
+
+BENCHMARK_MAIN();
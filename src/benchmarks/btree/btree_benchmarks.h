@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "../../associative_containers/btree_map/custom_btree_map.h"
+#include "../../associative_containers/map/custom_map.h"
+
+using BTreeIntMap = custom::BTreeMap<std::uint64_t, std::uint64_t>;
+using TreeIntMap = custom::Map<std::uint64_t, std::uint64_t>;
+using StdIntMap = std::map<std::uint64_t, std::uint64_t>;
+
+static std::vector<std::uint64_t> ShuffledKeys(std::size_t count) {
+  std::vector<std::uint64_t> keys(count);
+  std::iota(keys.begin(), keys.end(), 0UL);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  return keys;
+}
+
+// Keys are inserted in random order, so the nodes of the binary trees are
+// spread over the heap the way they are in the long living containers
+template <class MapType>
+static MapType FillShuffled(const std::vector<std::uint64_t> &keys) {
+  MapType map;
+  for (std::uint64_t key : keys)
+    map.insert({key, key});
+  return map;
+}
+
+template <class MapType> static void BM_OrderedFind(benchmark::State &state) {
+  std::vector<std::uint64_t> keys =
+      ShuffledKeys(static_cast<std::size_t>(state.range()));
+  MapType map = FillShuffled<MapType>(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  for (auto _ : state) {
+    for (std::uint64_t key : keys)
+      benchmark::DoNotOptimize(map.find(key));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_OrderedRandomInsert(benchmark::State &state) {
+  std::vector<std::uint64_t> keys =
+      ShuffledKeys(static_cast<std::size_t>(state.range()));
+  for (auto _ : state) {
+    MapType map = FillShuffled<MapType>(keys);
+    benchmark::DoNotOptimize(map);
+    state.PauseTiming();
+    map.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType> static void BM_OrderedScan(benchmark::State &state) {
+  MapType map = FillShuffled<MapType>(
+      ShuffledKeys(static_cast<std::size_t>(state.range())));
+  for (auto _ : state) {
+    std::uint64_t sum = 0UL;
+    for (auto i = map.begin(); i != map.end(); ++i)
+      sum += (*i).second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+// Heap bytes taken by every entry, including the overhead of malloc
+template <class MapType>
+static void BM_OrderedMemory(benchmark::State &state) {
+  std::vector<std::uint64_t> keys =
+      ShuffledKeys(static_cast<std::size_t>(state.range()));
+  double bytes = 0.0;
+  for (auto _ : state) {
+#ifdef __GLIBC__
+    std::size_t before = mallinfo2().uordblks;
+    MapType map = FillShuffled<MapType>(keys);
+    bytes = static_cast<double>(mallinfo2().uordblks - before);
+    benchmark::DoNotOptimize(map);
+#endif
+  }
+  state.counters["bytes_per_entry"] = bytes / static_cast<double>(keys.size());
+}
+
+BENCHMARK_TEMPLATE(BM_OrderedFind, BTreeIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedFind, TreeIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedFind, StdIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedRandomInsert, BTreeIntMap)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedRandomInsert, TreeIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedRandomInsert, StdIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedScan, BTreeIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedScan, TreeIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedScan, StdIntMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_OrderedMemory, BTreeIntMap)
+    ->Arg(1 << 20)
+    ->Iterations(1);
+BENCHMARK_TEMPLATE(BM_OrderedMemory, TreeIntMap)->Arg(1 << 20)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_OrderedMemory, StdIntMap)->Arg(1 << 20)->Iterations(1);
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "../../associative_containers/btree_map/custom_btree_map.h"
+#include "../../associative_containers/flat_map/custom_flat_map.h"
+#include "../../associative_containers/map/custom_map.h"
+
+using FlatReadMap = custom::FlatMap<std::uint64_t, std::uint64_t>;
+using BTreeReadMap = custom::BTreeMap<std::uint64_t, std::uint64_t>;
+using TreeReadMap = custom::Map<std::uint64_t, std::uint64_t>;
+
+// Maps that are built once from the unsorted data and then only read
+static std::vector<std::pair<std::uint64_t, std::uint64_t>>
+ShuffledPairs(std::size_t count) {
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs(count);
+  for (std::size_t i = 0; i < count; ++i)
+    pairs[i] = {i * 2UL, i};
+  std::shuffle(pairs.begin(), pairs.end(), std::mt19937(42));
+  return pairs;
+}
+
+template <class MapType> static void BM_ReadMapBuild(benchmark::State &state) {
+  auto pairs = ShuffledPairs(static_cast<std::size_t>(state.range()));
+  for (auto _ : state) {
+    MapType map(pairs.begin(), pairs.end());
+    benchmark::DoNotOptimize(map);
+    state.PauseTiming();
+    map.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType> static void BM_ReadMapFind(benchmark::State &state) {
+  auto pairs = ShuffledPairs(static_cast<std::size_t>(state.range()));
+  MapType map(pairs.begin(), pairs.end());
+  std::shuffle(pairs.begin(), pairs.end(), std::mt19937(7));
+  for (auto _ : state) {
+    for (const auto &item : pairs)
+      benchmark::DoNotOptimize(map.find(item.first));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType> static void BM_ReadMapScan(benchmark::State &state) {
+  auto pairs = ShuffledPairs(static_cast<std::size_t>(state.range()));
+  MapType map(pairs.begin(), pairs.end());
+  for (auto _ : state) {
+    std::uint64_t sum = 0UL;
+    for (auto i = map.begin(); i != map.end(); ++i)
+      sum += (*i).second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+// Heap bytes taken by every entry, including the overhead of malloc
+template <class MapType>
+static void BM_ReadMapMemory(benchmark::State &state) {
+  auto pairs = ShuffledPairs(static_cast<std::size_t>(state.range()));
+  double bytes = 0.0;
+  for (auto _ : state) {
+#ifdef __GLIBC__
+    std::size_t before = mallinfo2().uordblks;
+    MapType map(pairs.begin(), pairs.end());
+    bytes = static_cast<double>(mallinfo2().uordblks - before);
+    benchmark::DoNotOptimize(map);
+#endif
+  }
+  state.counters["bytes_per_entry"] = bytes / static_cast<double>(pairs.size());
+}
+
+BENCHMARK_TEMPLATE(BM_ReadMapBuild, FlatReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapBuild, BTreeReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapBuild, TreeReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapFind, FlatReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapFind, BTreeReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapFind, TreeReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapScan, FlatReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapScan, BTreeReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapScan, TreeReadMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ReadMapMemory, FlatReadMap)->Arg(1 << 20)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_ReadMapMemory, BTreeReadMap)
+    ->Arg(1 << 20)
+    ->Iterations(1);
+BENCHMARK_TEMPLATE(BM_ReadMapMemory, TreeReadMap)->Arg(1 << 20)->Iterations(1);
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../associative_containers/map/custom_map.h"
+
+template <class MapType> static MapType FillMap(std::size_t count) {
+  MapType map;
+  for (std::size_t i = 0; i < count; ++i) {
+    int key = static_cast<int>((i * 7919UL) % count);
+    map.insert({key, key});
+  }
+  return map;
+}
+
+template <class MapType> static void BM_MapIteration(benchmark::State &state) {
+  const MapType map = FillMap<MapType>(static_cast<std::size_t>(state.range()));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (auto i = map.begin(); i != map.end(); ++i)
+      sum += (*i).second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_MapReverseIteration(benchmark::State &state) {
+  const MapType map = FillMap<MapType>(static_cast<std::size_t>(state.range()));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (auto i = map.end(); i != map.begin();)
+      sum += (*--i).second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_MapSortedInsert(benchmark::State &state) {
+  for (auto _ : state) {
+    MapType map;
+    for (int i = 0; i < state.range(); ++i)
+      map.insert({i, i});
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_MapSortedInsertWithHint(benchmark::State &state) {
+  for (auto _ : state) {
+    MapType map;
+    for (int i = 0; i < state.range(); ++i)
+      map.insert(map.end(), {i, i});
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+// Counting of the repeated keys, every key is already in the map
+template <class MapType> static void BM_MapCounter(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  MapType map;
+  for (std::size_t i = 0; i < count; ++i)
+    map["counter_of_the_key_" + std::to_string(i)] = 0;
+  for (auto _ : state) {
+    for (auto i = map.begin(); i != map.end(); ++i)
+      map[(*i).first]++;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+// Insertion of large payloads that are copied or moved into the nodes
+template <bool IsMoved>
+static void BM_MapInsertPayload(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  for (auto _ : state) {
+    custom::Map<int, std::vector<int>> map;
+    for (std::size_t i = 0; i < count; ++i) {
+      std::vector<int> payload(256, static_cast<int>(i));
+      if constexpr (IsMoved)
+        map.insert(static_cast<int>(i), std::move(payload));
+      else
+        map.insert(static_cast<int>(i), payload);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+using CustomMap = custom::Map<int, int>;
+using CustomPoolMap = custom::Map<int, int, std::less<int>, custom::NodePool__>;
+using StdMap = std::map<int, int>;
+
+// Hands the upper half of the map to another map and takes it back, either
+// by split and join or by copying of the elements
+template <bool IsRelinked>
+static void BM_MapSplitJoin(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  CustomMap map = FillMap<CustomMap>(count);
+  int middle = static_cast<int>(count / 2);
+  for (auto _ : state) {
+    if constexpr (IsRelinked) {
+      CustomMap greater = map.split(middle);
+      map.join(greater);
+    } else {
+      CustomMap greater;
+      auto first = map.lower_bound(middle);
+      for (auto i = first; i != map.end(); ++i)
+        greater.insert(greater.end(), *i);
+      map.erase(first, map.end());
+      for (const auto &item : greater)
+        map.insert(map.end(), item);
+    }
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+// Latency of the clear call for the caller, the map is filled outside of it
+template <bool IsAsync>
+static void BM_MapClear(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  for (auto _ : state) {
+    state.PauseTiming();
+    CustomMap map = FillMap<CustomMap>(count);
+    state.ResumeTiming();
+    if constexpr (IsAsync)
+      map.clear_async();
+    else
+      map.clear();
+    benchmark::DoNotOptimize(map);
+  }
+  custom::Reclaimer__::instance().wait();
+}
+
+using CustomStringMap = custom::Map<std::string, long>;
+using StdStringMap = std::map<std::string, long>;
+
+BENCHMARK_TEMPLATE(BM_MapIteration, CustomMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapIteration, CustomPoolMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapIteration, StdMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapReverseIteration, CustomMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapReverseIteration, StdMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapSortedInsert, CustomMap)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapSortedInsertWithHint, CustomMap)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapSortedInsertWithHint, CustomPoolMap)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapSortedInsertWithHint, StdMap)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapCounter, CustomStringMap)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapCounter, StdStringMap)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapInsertPayload, false)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapInsertPayload, true)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MapSplitJoin, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapSplitJoin, true)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapClear, false)
+    ->Range(1 << 10, 1 << 20)
+    ->Iterations(30);
+BENCHMARK_TEMPLATE(BM_MapClear, true)
+    ->Range(1 << 10, 1 << 20)
+    ->Iterations(30);
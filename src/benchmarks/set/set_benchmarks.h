@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../../associative_containers/set/custom_set.h"
+
+template <class SetType>
+static SetType FillSet(std::size_t count, int first, int step) {
+  SetType set;
+  for (std::size_t i = 0; i < count; ++i)
+    set.insert(first + static_cast<int>(i) * step);
+  return set;
+}
+
+template <class SetType> static void BM_SetMerge(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  for (auto _ : state) {
+    state.PauseTiming();
+    SetType set1 = FillSet<SetType>(count, 0, 2);
+    SetType set2 = FillSet<SetType>(count, 1, 2);
+    state.ResumeTiming();
+    set1.merge(set2);
+    benchmark::DoNotOptimize(set1);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range() * 2);
+}
+
+template <class SetType>
+static void BM_SetMergeSmall(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  for (auto _ : state) {
+    state.PauseTiming();
+    SetType set1 = FillSet<SetType>(count, 0, 2);
+    SetType set2 = FillSet<SetType>(count / 100, 1, 200);
+    state.ResumeTiming();
+    set1.merge(set2);
+    benchmark::DoNotOptimize(set1);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range() / 100);
+}
+
+// Intersection the way it was done before: lookup of every element
+static void BM_SetIntersectionByLookup(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  custom::Set<int> set1 = FillSet<custom::Set<int>>(count, 0, 2);
+  custom::Set<int> set2 = FillSet<custom::Set<int>>(count, 0, 3);
+  for (auto _ : state) {
+    custom::Set<int> result;
+    for (int value : set1)
+      if (set2.contains(value))
+        result.insert(result.end(), value);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range() * 2);
+}
+
+static void BM_SetIntersection(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range(0));
+  std::size_t threads = static_cast<std::size_t>(state.range(1));
+  custom::Set<int> set1 = FillSet<custom::Set<int>>(count, 0, 2);
+  custom::Set<int> set2 = FillSet<custom::Set<int>>(count, 0, 3);
+  for (auto _ : state) {
+    custom::Set<int> result = set1.set_intersection(set2, threads);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+static void BM_StdSetIntersection(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range());
+  std::set<int> set1 = FillSet<std::set<int>>(count, 0, 2);
+  std::set<int> set2 = FillSet<std::set<int>>(count, 0, 3);
+  for (auto _ : state) {
+    std::set<int> result;
+    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(),
+                          std::inserter(result, result.end()));
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range() * 2);
+}
+
+// Unsorted batch of the keys that are missing in the set of the given size
+static std::vector<int> MakeBatch(std::size_t count, std::size_t size) {
+  std::vector<int> batch(count);
+  for (std::size_t i = 0; i < count; ++i)
+    batch[i] = static_cast<int>(i * (size * 2 / count)) + 1;
+  std::shuffle(batch.begin(), batch.end(), std::mt19937(42));
+  return batch;
+}
+
+template <class SetType>
+static void BM_SetInsertOneByOne(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range(0));
+  std::size_t batch_size = static_cast<std::size_t>(state.range(1));
+  std::vector<int> batch = MakeBatch(batch_size, count);
+  SetType set = FillSet<SetType>(count, 0, 2);
+  for (auto _ : state) {
+    for (int value : batch)
+      set.insert(value);
+    benchmark::DoNotOptimize(set);
+    state.PauseTiming();
+    // the batch is removed, so every iteration starts with the same keys
+    for (int value : batch)
+      set.erase(set.find(value));
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+template <class SetType>
+static void BM_SetInsertRange(benchmark::State &state) {
+  std::size_t count = static_cast<std::size_t>(state.range(0));
+  std::size_t batch_size = static_cast<std::size_t>(state.range(1));
+  std::vector<int> batch = MakeBatch(batch_size, count);
+  SetType set = FillSet<SetType>(count, 0, 2);
+  for (auto _ : state) {
+    set.insert(batch.begin(), batch.end());
+    benchmark::DoNotOptimize(set);
+    state.PauseTiming();
+    // the batch is removed, so every iteration starts with the same keys
+    for (int value : batch)
+      set.erase(set.find(value));
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// Drops three quarters of the keys either by one range erase or by erasure
+// of every element found separately
+template <bool IsRange> static void BM_SetEraseWindow(benchmark::State &state) {
+  int count = static_cast<int>(state.range());
+  custom::Set<int> set = FillSet<custom::Set<int>>(count, 0, 1);
+  std::vector<int> window(count / 4 * 3);
+  std::iota(window.begin(), window.end(), count / 8);
+  for (auto _ : state) {
+    if constexpr (IsRange) {
+      set.erase(set.find(window.front()), set.find(window.back() + 1));
+    } else {
+      for (int value : window)
+        set.erase(set.find(value));
+    }
+    benchmark::DoNotOptimize(set);
+    state.PauseTiming();
+    set.insert(window.begin(), window.end());
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range() / 4 * 3);
+}
+
+using CustomSet = custom::Set<int>;
+using StdSet = std::set<int>;
+
+BENCHMARK_TEMPLATE(BM_SetMerge, CustomSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SetMerge, StdSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SetMergeSmall, CustomSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SetMergeSmall, StdSet)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SetIntersectionByLookup)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SetIntersection)->Ranges({{1 << 10, 1 << 20}, {1, 4}});
+BENCHMARK(BM_StdSetIntersection)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SetInsertOneByOne, CustomSet)
+    ->ArgsProduct({{1 << 20}, {1 << 10, 1 << 14, 1 << 17}});
+BENCHMARK_TEMPLATE(BM_SetInsertRange, CustomSet)
+    ->ArgsProduct({{1 << 20}, {1 << 10, 1 << 14, 1 << 17}});
+BENCHMARK_TEMPLATE(BM_SetInsertRange, StdSet)
+    ->ArgsProduct({{1 << 20}, {1 << 10, 1 << 14, 1 << 17}});
+BENCHMARK_TEMPLATE(BM_SetEraseWindow, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SetEraseWindow, true)->Range(1 << 10, 1 << 20);
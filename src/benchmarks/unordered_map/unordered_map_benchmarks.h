@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "../../associative_containers/unordered_map/custom_unordered_map.h"
+
+using CustomHashMap = custom::UnorderedMap<std::uint64_t, std::uint64_t>;
+using StdHashMap = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+// Random keys, the odd ones are never inserted and are used for the misses
+static std::vector<std::uint64_t> RandomHashKeys(std::size_t count,
+                                                 unsigned seed) {
+  std::mt19937_64 generator(seed);
+  std::vector<std::uint64_t> keys(count);
+  for (auto &key : keys)
+    key = generator() & ~1UL;
+  return keys;
+}
+
+template <class MapType>
+static void BM_HashInsert(benchmark::State &state) {
+  auto keys = RandomHashKeys(static_cast<std::size_t>(state.range()), 42U);
+  for (auto _ : state) {
+    MapType map;
+    for (auto key : keys)
+      map.insert({key, key});
+    benchmark::DoNotOptimize(map);
+    state.PauseTiming();
+    map.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_HashInsertReserved(benchmark::State &state) {
+  auto keys = RandomHashKeys(static_cast<std::size_t>(state.range()), 42U);
+  for (auto _ : state) {
+    MapType map;
+    map.reserve(keys.size());
+    for (auto key : keys)
+      map.insert({key, key});
+    benchmark::DoNotOptimize(map);
+    state.PauseTiming();
+    map.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_HashFindHit(benchmark::State &state) {
+  auto keys = RandomHashKeys(static_cast<std::size_t>(state.range()), 42U);
+  MapType map;
+  for (auto key : keys)
+    map.insert({key, key});
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  for (auto _ : state) {
+    for (auto key : keys)
+      benchmark::DoNotOptimize(map.find(key));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+template <class MapType>
+static void BM_HashFindMiss(benchmark::State &state) {
+  auto keys = RandomHashKeys(static_cast<std::size_t>(state.range()), 42U);
+  MapType map;
+  for (auto key : keys)
+    map.insert({key, key});
+  auto misses = RandomHashKeys(keys.size(), 9U);
+  for (auto &key : misses)
+    key |= 1UL;
+  for (auto _ : state) {
+    for (auto key : misses)
+      benchmark::DoNotOptimize(map.find(key));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range());
+}
+
+// Erases the oldest key and inserts a new one, so tombstones pile up
+template <class MapType>
+static void BM_HashChurn(benchmark::State &state) {
+  auto keys = RandomHashKeys(static_cast<std::size_t>(state.range()) * 2UL,
+                             42U);
+  std::size_t half = keys.size() / 2UL;
+  MapType map;
+  for (std::size_t i = 0; i < half; ++i)
+    map.insert({keys[i], keys[i]});
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < half; ++i) {
+      map.erase(keys[i]);
+      map.insert({keys[i + half], keys[i]});
+    }
+    for (std::size_t i = 0; i < half; ++i) {
+      map.erase(keys[i + half]);
+      map.insert({keys[i], keys[i]});
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range() * 2);
+}
+
+#ifdef __GLIBC__
+// The table is one large block, glibc serves such blocks by mmap and counts
+// them apart from the heap
+static std::size_t HashHeapBytes() {
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+#endif
+
+// Heap bytes taken by every entry, including the overhead of malloc
+template <class MapType>
+static void BM_HashMemory(benchmark::State &state) {
+  auto keys = RandomHashKeys(static_cast<std::size_t>(state.range()), 42U);
+  double bytes = 0.0;
+  for (auto _ : state) {
+#ifdef __GLIBC__
+    std::size_t before = HashHeapBytes();
+    MapType map;
+    for (auto key : keys)
+      map.insert({key, key});
+    bytes = static_cast<double>(HashHeapBytes() - before);
+    benchmark::DoNotOptimize(map);
+#endif
+  }
+  state.counters["bytes_per_entry"] = bytes / static_cast<double>(keys.size());
+}
+
+BENCHMARK_TEMPLATE(BM_HashInsert, CustomHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashInsert, StdHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashInsertReserved, CustomHashMap)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashInsertReserved, StdHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashFindHit, CustomHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashFindHit, StdHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashFindMiss, CustomHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashFindMiss, StdHashMap)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_HashChurn, CustomHashMap)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_HashChurn, StdHashMap)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_HashMemory, CustomHashMap)->Arg(1 << 20)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_HashMemory, StdHashMap)->Arg(1 << 20)->Iterations(1);
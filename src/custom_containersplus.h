@@ -1,7 +1,14 @@
 #ifndef _CUSTOM_STL_CONTAINERS_CUSTOM_CONTAINERSPLUS_H_
 #define _CUSTOM_STL_CONTAINERS_CUSTOM_CONTAINERSPLUS_H_
 
+#include "associative_containers/btree_map/custom_btree_map.h"
+#include "associative_containers/btree_multiset/custom_btree_multiset.h"
+#include "associative_containers/btree_set/custom_btree_set.h"
+#include "associative_containers/flat_map/custom_flat_map.h"
+#include "associative_containers/flat_set/custom_flat_set.h"
 #include "associative_containers/multiset/custom_multiset.h"
+#include "associative_containers/unordered_map/custom_unordered_map.h"
+#include "associative_containers/unordered_set/custom_unordered_set.h"
 #include "sequence_containers/array/custom_array.h"
 
 #endif // _CUSTOM_STL_CONTAINERS_CUSTOM_CONTAINERSPLUS_H_
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 namespace custom {
 
+// Common part of the node iterators. There are no virtual functions, so the
+// iterator is just a node pointer and can be kept in a register
 template <class T> class IIterator {
 public:
   using value_type = T;
@@ -13,18 +15,18 @@ public:
   using double_reference = value_type &&;
 
   explicit IIterator(const_pointer ptr) : ptr_((pointer)ptr) {}
-  virtual ~IIterator() = 0;
   bool operator==(const IIterator &other) const { return ptr_ == other.ptr_; };
   bool operator!=(const IIterator &other) const { return !(*this == other); };
   pointer data() { return ptr_; };
   const_pointer data() const { return ptr_; }
 
 protected:
+  // Iterators are never deleted through the pointer to this base
+  ~IIterator() = default;
+
   pointer ptr_;
 };
 
-template <class T> IIterator<T>::~IIterator() {}
-
 } // namespace custom
 
 #endif // _INTERFACES_CUSTOM_ITERATOR_H_
\ No newline at end of file
@@ -1,24 +1,51 @@
 #ifndef _MISC_CUSTOM_BINARY_TREE_H_
 #define _MISC_CUSTOM_BINARY_TREE_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 #include "../interfaces/custom_iterator.h"
 #include "../sequence_containers/vector/custom_vector.h"
+#include "custom_node_allocator.h"
+#include "custom_reclaimer.h"
+#include "custom_tree_traits.h"
 
 namespace custom {
 
-// For set and map functions return values compatibility
-template <class T> struct TypeOfValue__ {
-  const T &operator()(const T &t__) const { return t__; }
+// Operations of the set algebra. Equal elements are matched one to one, so
+// for the trees with repeated elements union keeps max(n, m) copies of the
+// key, intersection keeps min(n, m), difference keeps n - m and symmetric
+// difference keeps |n - m| of them
+enum class SetOperation__ {
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
 };
 
+// Size of the subtree that is stored in the nodes of the ranked trees only
+template <bool Ranked> struct SubtreeSize__ {
+  std::size_t subtree_size_ = 1UL;
+};
+
+template <> struct SubtreeSize__<false> {};
+
 template <class Key, class T, class Select = TypeOfValue__<Key>,
-          class Compare = std::less<Key>>
+          class Compare = std::less<Key>,
+          template <class> class Allocator = NodeAllocator__,
+          bool Ranked = false>
 class SortedBinaryTree__ {
 public:
   using key_type = Key;
@@ -38,56 +65,122 @@ public:
   SortedBinaryTree__(const SortedBinaryTree__ &other);
   SortedBinaryTree__(SortedBinaryTree__ &&other) noexcept;
   explicit SortedBinaryTree__(const std::initializer_list<value_type> &items);
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  SortedBinaryTree__(InputIt first, InputIt last,
+                     bool is_repeated_allowed = false);
 
   SortedBinaryTree__ &operator=(const SortedBinaryTree__ &other);
   SortedBinaryTree__ &operator=(SortedBinaryTree__ &&other);
   SortedBinaryTree__ &operator=(const std::initializer_list<value_type> &items);
 
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  void assign(InputIt first, InputIt last, bool is_repeated_allowed = false);
+
   bool empty() const;
   size_type size() const;
   size_type max_size() const;
 
-  bool contains(const key_type &key) const;
+  template <class Lookup> bool contains(const Lookup &key) const;
+  size_type height() const;
   void swap(SortedBinaryTree__ &other);
   void merge(SortedBinaryTree__ &other, bool is_repeated_allowed = false);
+  void split(const key_type &key, SortedBinaryTree__ &greater);
+  void join(SortedBinaryTree__ &other, bool is_repeated_allowed = false);
+  void assign_set_operation(const SortedBinaryTree__ &left,
+                            const SortedBinaryTree__ &right,
+                            SetOperation__ operation,
+                            size_type thread_count = 1UL);
   void clear();
+  void clear_async();
 
 private:
-  struct Node {
+  // Colors of the red-black tree nodes
+  enum class Color : std::uintptr_t { kBlack = 0U, kRed = 1U };
+
+  struct Node;
+
+  // Links of the node. Tree header has only links: its parent is the root,
+  // left and right are the smallest and the greatest nodes of the tree
+  struct NodeBase : SubtreeSize__<Ranked> {
+    using pointer = struct NodeBase *;
+    using node_pointer = struct Node *;
+
+    explicit NodeBase(pointer parent = nullptr)
+        : left_(nullptr), right_(nullptr),
+          parent_(reinterpret_cast<std::uintptr_t>(parent)) {}
+
+    pointer parent() const {
+      return reinterpret_cast<pointer>(parent_ & ~kColorMask);
+    }
+    Color color() const { return static_cast<Color>(parent_ & kColorMask); }
+    void set_parent(pointer parent) {
+      parent_ =
+          reinterpret_cast<std::uintptr_t>(parent) | (parent_ & kColorMask);
+    }
+    void set_color(Color color) {
+      parent_ = (parent_ & ~kColorMask) | static_cast<std::uintptr_t>(color);
+    }
+    void set_left(node_pointer left) { left_ = left; }
+    void set_right(node_pointer right) { right_ = right; }
+
+    node_pointer left_;
+    node_pointer right_;
+    // Parent pointer with the node color packed into the lowest bit, nodes are
+    // always aligned at least by pointer size so this bit is free
+    std::uintptr_t parent_;
+
+    constexpr static std::uintptr_t kColorMask = 1U;
+  };
+
+  struct Node : NodeBase {
     using pointer = struct Node *;
 
     ~Node() = default;
 
-    explicit Node(pointer parent = nullptr,
+    explicit Node(typename NodeBase::pointer parent = nullptr,
                   const_reference value = value_type())
-        : data_(value), key_(key_identify()(data_)), left_(nullptr),
-          right_(nullptr), parent_(parent) {}
+        : NodeBase(parent), data_(value) {}
 
-    const key_type &key() const { return key_; }
+    Node(typename NodeBase::pointer parent, double_reference value)
+        : NodeBase(parent), data_(std::move(value)) {}
+
+    // constructs the value right inside the node from any arguments
+    template <class... Args>
+    Node(typename NodeBase::pointer parent, std::in_place_t, Args &&...args)
+        : NodeBase(parent), data_(std::forward<Args>(args)...) {}
+
+    // the key is taken from the value on every access instead of being kept
+    // as a reference, that saves a pointer per node and a dependent load
+    const key_type &key() const { return key_identify()(data_); }
     reference value() { return data_; }
-    void set_parent(pointer parent) { parent_ = parent; }
-    void set_left(pointer left) { left_ = left; }
-    void set_right(pointer right) { right_ = right; }
 
     value_type data_;
-    const key_type &key_;
-    pointer left_;
-    pointer right_;
-    pointer parent_;
   };
 
+  using base_type = struct NodeBase;
+  using base_pointer = base_type *;
   using node_type = struct Node;
   using node_pointer = node_type *;
+  using allocator_type = Allocator<node_type>;
+  using handle_allocator_type = NodeAllocator__<node_type>;
+  // nodes of the tree can be passed to the node handles without a copy
+  constexpr static bool kRelinksHandleNodes =
+      std::is_same<allocator_type, handle_allocator_type>::value;
+
+  // A node holds nothing but the links and the value, so an entry of
+  // Map<int, int> or Set<std::uint64_t> takes 32 bytes, 40 bytes if Ranked
+  static_assert(sizeof(node_type) < sizeof(base_type) + sizeof(value_type) +
+                                        alignof(node_type),
+                "Tree node must not hold anything besides links and value");
 
 public:
-  class SortedBinaryTreeIterator__ : public IIterator<node_type> {
+  class SortedBinaryTreeIterator__ : public IIterator<base_type> {
   public:
-    using base = IIterator<node_type>;
+    using base = IIterator<base_type>;
     using iterator_category = std::bidirectional_iterator_tag;
     using difference_type = std::ptrdiff_t;
 
-    SortedBinaryTreeIterator__(node_pointer ptr, node_pointer root)
-        : base(ptr), tree_root_(root) {}
+    explicit SortedBinaryTreeIterator__(const base_type *ptr) : base(ptr) {}
 
     SortedBinaryTreeIterator__ &operator++();
     SortedBinaryTreeIterator__ operator++(int);
@@ -95,18 +188,16 @@ public:
     SortedBinaryTreeIterator__ operator--(int);
 
     bool operator==(const SortedBinaryTreeIterator__ &other) const {
-      return this->ptr_ == other.ptr_ && tree_root_ == other.tree_root_;
+      return this->ptr_ == other.ptr_;
     }
 
     bool operator!=(const SortedBinaryTreeIterator__ &other) const {
       return !(*this == other);
     }
 
-    reference operator*() { return this->ptr_->data_; }
-    node_pointer root() { return tree_root_; }
-
-  protected:
-    node_pointer tree_root_;
+    reference operator*() {
+      return static_cast<node_pointer>(this->ptr_)->data_;
+    }
   };
 
   using iterator = SortedBinaryTreeIterator__;
@@ -116,17 +207,76 @@ public:
     using iterator_category = typename iterator::iterator_category;
     using difference_type = typename iterator::difference_type;
 
-    SortedBinaryTreeConstIterator__(node_pointer ptr, node_pointer root)
-        : iterator(ptr, root) {}
+    explicit SortedBinaryTreeConstIterator__(const base_type *ptr)
+        : iterator(ptr) {}
 
-    explicit SortedBinaryTreeConstIterator__(const iterator &iter)
-        : iterator(iter) {}
+    // implicit just like the conversion of the standard iterators
+    SortedBinaryTreeConstIterator__(const iterator &iter) : iterator(iter) {}
 
-    const_reference operator*() const { return this->ptr_->data_; }
+    const_reference operator*() const {
+      return static_cast<node_pointer>(this->ptr_)->data_;
+    }
   };
 
   using const_iterator = SortedBinaryTreeConstIterator__;
 
+  // Owns the node extracted from the tree until it is inserted into another
+  // tree of the same type. The node of the handle is always allocated by
+  // NodeAllocator__, so the handle outlives any container. Trees that use it
+  // relink the node itself, pool-backed trees move the value between the
+  // node of the handle and a node of their pool
+  class NodeHandle__ {
+  public:
+    NodeHandle__() noexcept : node_(nullptr) {}
+    NodeHandle__(const NodeHandle__ &other) = delete;
+    NodeHandle__(NodeHandle__ &&other) noexcept : node_(other.release()) {}
+    ~NodeHandle__() { reset(); }
+
+    NodeHandle__ &operator=(const NodeHandle__ &other) = delete;
+    NodeHandle__ &operator=(NodeHandle__ &&other) noexcept {
+      if (this != &other) {
+        reset();
+        node_ = other.release();
+      }
+      return *this;
+    }
+
+    bool empty() const noexcept { return !node_; }
+    explicit operator bool() const noexcept { return node_; }
+    const key_type &key() const { return node_->key(); }
+    reference value() const { return node_->data_; }
+
+  private:
+    friend class SortedBinaryTree__;
+
+    explicit NodeHandle__(node_pointer node) noexcept : node_(node) {}
+
+    node_pointer release() noexcept {
+      node_pointer node = node_;
+      node_ = nullptr;
+      return node;
+    }
+
+    void reset() noexcept {
+      if (node_)
+        handle_allocator_type().destroy(release());
+    }
+
+    node_pointer node_;
+  };
+
+  using node_handle = NodeHandle__;
+
+  // Result of the node handle insertion: the node stays in the handle only if
+  // an equal key prevented the insertion
+  struct InsertReturn__ {
+    iterator position;
+    bool inserted;
+    node_handle node;
+  };
+
+  using insert_return_type = InsertReturn__;
+
   iterator begin();
   const_iterator begin() const;
   iterator end();
@@ -134,41 +284,168 @@ public:
 
   std::pair<iterator, bool> insert(const_reference value,
                                    bool is_repeated_allowed = false);
+  std::pair<iterator, bool> insert(double_reference value,
+                                   bool is_repeated_allowed = false);
+  iterator insert(iterator hint, const_reference value,
+                  bool is_repeated_allowed = false);
+  iterator insert(iterator hint, double_reference value,
+                  bool is_repeated_allowed = false);
+  insert_return_type insert(node_handle &&handle,
+                            bool is_repeated_allowed = false);
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last,
+                   bool is_repeated_allowed = false);
   void erase(iterator pos);
-  iterator find(const key_type &key);
-  const_iterator find(const key_type &key) const;
-
-  node_pointer root() const { return root_; }
+  iterator erase(iterator first, iterator last);
+  template <class Predicate> size_type erase_if(Predicate pred);
+  node_handle extract(iterator pos);
+  node_handle extract(const key_type &key);
+  template <class Lookup> iterator find(const Lookup &key);
+  template <class Lookup> const_iterator find(const Lookup &key) const;
+  iterator find(iterator hint, const key_type &key);
+  const_iterator find(iterator hint, const key_type &key) const;
+
+  template <class Lookup> iterator lower_bound(const Lookup &key);
+  template <class Lookup> const_iterator lower_bound(const Lookup &key) const;
+  template <class Lookup> iterator upper_bound(const Lookup &key);
+  template <class Lookup> const_iterator upper_bound(const Lookup &key) const;
+  template <class Lookup>
+  std::pair<iterator, iterator> equal_range(const Lookup &key);
+  template <class Lookup>
+  std::pair<const_iterator, const_iterator>
+  equal_range(const Lookup &key) const;
+
+  node_pointer root() const {
+    return static_cast<node_pointer>(header_.parent());
+  }
+
+  // Order statistics, available only for the ranked trees
+  iterator nth(size_type index);
+  const_iterator nth(size_type index) const;
+  size_type rank(const key_type &key) const;
+  template <class Lookup> size_type count(const Lookup &key) const;
+  size_type count_range(const key_type &low, const key_type &high) const;
 
   template <class... Args>
-  Vector<std::pair<const_iterator, bool>> emplace(bool is_repeated_allowed,
-                                                  Args &&...args);
+  std::pair<iterator, bool> emplace(bool is_repeated_allowed, Args &&...args);
+  template <class... Args>
+  iterator emplace_hint(iterator hint, bool is_repeated_allowed,
+                        Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <class... Args>
+  Vector<std::pair<const_iterator, bool>>
+  insert_many(bool is_repeated_allowed, Args &&...args);
 
 private:
-  node_pointer root_;
+  // Every thread of the parallel set operations takes at least that many
+  // elements, smaller inputs are processed by one thread
+  constexpr static size_type kMinElementsPerThread = 1UL << 14;
+
+  base_type header_;
   size_type size_;
+  allocator_type allocator_;
 
   value_type &at_helper(const key_type &key);
-  node_pointer find_suitable_node(const key_type &key) const;
-
-  std::pair<iterator, bool> insert_new_node(node_pointer node,
-                                            node_pointer suitable_node,
-                                            bool is_repeated_allowed = false);
+  template <class Lookup>
+  node_pointer find_node(const Lookup &key, node_pointer node) const;
+  // Parent for the new node with the key, or the node with the equal key and
+  // true if it is found and repeated keys aren't allowed
+  std::pair<node_pointer, bool>
+  find_suitable_node(const key_type &key, bool is_repeated_allowed) const;
+  node_pointer find_from_hint(iterator hint, const key_type &key) const;
+  bool is_position_for(base_pointer position, const key_type &key,
+                       bool is_repeated_allowed) const;
+  bool is_last_position_for(base_pointer position, const key_type &key,
+                            bool is_repeated_allowed) const;
+  template <class Lookup>
+  const base_type *lower_bound_node(const Lookup &key, const base_type *node,
+                                    const base_type *result) const;
+  template <class Lookup>
+  const base_type *upper_bound_node(const Lookup &key, const base_type *node,
+                                    const base_type *result) const;
+  template <class Lookup>
+  std::pair<const base_type *, const base_type *>
+  equal_range_nodes(const Lookup &key) const;
+
+  template <class Value>
+  std::pair<iterator, bool> insert_value(Value &&value,
+                                         bool is_repeated_allowed);
+  template <class Value>
+  iterator insert_value(iterator hint, Value &&value, bool is_repeated_allowed);
+  iterator insert_new_node(node_pointer node, node_pointer parent);
+  std::pair<iterator, bool> insert_created_node(node_pointer node,
+                                                bool is_repeated_allowed);
+  size_type insert_sorted_nodes(Vector<node_pointer> &nodes,
+                                bool is_repeated_allowed);
+  base_pointer position_from_hint(iterator hint, const key_type &key,
+                                  bool is_repeated_allowed) const;
+  iterator link_before(base_pointer position, node_pointer node);
+  iterator link_new_node(node_pointer node, node_pointer parent, bool is_left);
 
-  void erase_case_right_only(node_pointer save_ptr);
-  void erase_case_right_and_left(node_pointer save_ptr);
-  void erase_case_left_only(node_pointer save_ptr);
-  void erase_case_no_childs(node_pointer save_ptr);
   node_pointer repoint_for_erase(iterator pos);
-
-  void free_tree();
-
-  template <class... Args>
-  void emplace_helper(Vector<std::pair<const_iterator, bool>> &result,
-                      bool is_repeated_allowed, const_reference value,
-                      Args &&...rest);
-  void emplace_helper(Vector<std::pair<const_iterator, bool>> &result,
-                      bool is_repeated_allowed, const_reference value);
+  void reset_header();
+  void repoint_header();
+
+  static bool is_red(base_pointer node);
+  static bool is_header(base_pointer node);
+  static node_pointer minimum(node_pointer node);
+  static node_pointer maximum(node_pointer node);
+  static void rotate_left(node_pointer node, base_pointer header);
+  static void rotate_right(node_pointer node, base_pointer header);
+  static void transplant(node_pointer old_node, node_pointer new_node,
+                         base_pointer header);
+  static bool rebalance_after_insert(node_pointer node, base_pointer header);
+  static void rebalance_after_erase(node_pointer node, base_pointer parent,
+                                    base_pointer header);
+
+  // Unlinks the node, the nodes before and after it are joined into two
+  // separate trees with given black heights. Links of their roots to the
+  // parents are left stale
+  void split_around(node_pointer node, node_pointer &less,
+                    size_type &less_height, node_pointer &more,
+                    size_type &more_height);
+  static size_type black_height(node_pointer node);
+  static node_pointer join_trees(node_pointer left, size_type left_height,
+                                 node_pointer middle, node_pointer right,
+                                 size_type right_height, size_type &height);
+
+  static size_type subtree_size(const base_type *node);
+  static void update_subtree_size(base_pointer node);
+  static void shift_subtree_sizes(base_pointer node, base_pointer header,
+                                  bool is_growing);
+  node_pointer find_nth(size_type index) const;
+  template <class Lookup>
+  size_type count_before(const Lookup &key, bool is_inclusive) const;
+
+  void merge_by_insertion(SortedBinaryTree__ &other, bool is_repeated_allowed);
+  void merge_by_rebuild(SortedBinaryTree__ &other, bool is_repeated_allowed);
+
+  void collect_set_operation(const_iterator left, const_iterator left_end,
+                             const_iterator right, const_iterator right_end,
+                             SetOperation__ operation,
+                             Vector<node_pointer> &nodes);
+  void collect_in_parallel(const SortedBinaryTree__ &left,
+                           const SortedBinaryTree__ &right,
+                           SetOperation__ operation, size_type thread_count,
+                           Vector<node_pointer> &nodes);
+  static void collect_pivots(const base_type *node, size_type depth,
+                             Vector<const key_type *> &pivots);
+
+  // destroys all the nodes of the subtree and releases the allocator
+  static void free_tree(node_pointer node, allocator_type &allocator) noexcept;
+  // destroys the nodes of the subtree one by one and returns their amount,
+  // the other nodes of the allocator stay alive
+  size_type destroy_subtree(node_pointer node) noexcept;
+  void clone_tree(const SortedBinaryTree__ &other);
+
+  template <class InputIt>
+  void create_nodes(InputIt first, InputIt last, Vector<node_pointer> &nodes);
+  void sort_nodes(Vector<node_pointer> &nodes, bool is_repeated_allowed);
+  void link_sorted_nodes(Vector<node_pointer> &nodes);
+  static node_pointer link_balanced(node_pointer *nodes, size_type count,
+                                    base_pointer parent, size_type depth,
+                                    size_type red_depth);
 };
 
 #include "custom_binary_tree.tpp"
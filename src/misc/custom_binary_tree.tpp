@@ -1,492 +1,1904 @@
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C>::SortedBinaryTree__()
-    : root_(nullptr), size_(0UL) {}
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTree__()
+    : header_(), size_(0UL), allocator_() {
+  // header is red to tell it apart from the root in the iterator decrement
+  header_.set_color(Color::kRed);
+}
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C>::~SortedBinaryTree__() {
-  free_tree();
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R>::~SortedBinaryTree__() {
+  clear();
 }
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C>::SortedBinaryTree__(
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTree__(
     const SortedBinaryTree__ &other)
     : SortedBinaryTree__() {
-  for (auto i = other.begin(); i != other.end(); ++i)
-    (*this).insert(*i);
+  clone_tree(other);
 }
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C>::SortedBinaryTree__(
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTree__(
     SortedBinaryTree__ &&other) noexcept
     : SortedBinaryTree__() {
-  std::swap(root_, other.root_);
-  std::swap(size_, other.size_);
+  swap(other);
 }
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C>::SortedBinaryTree__(
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTree__(
     const std::initializer_list<value_type> &items)
     : SortedBinaryTree__() {
-  for (auto i = items.begin(); i != items.end(); ++i)
-    (*this).insert(*i);
+  assign(items.begin(), items.end());
 }
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C> &
-SortedBinaryTree__<K, T, S, C>::operator=(const SortedBinaryTree__ &other) {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class InputIt, class>
+SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTree__(
+    InputIt first, InputIt last, bool is_repeated_allowed)
+    : SortedBinaryTree__() {
+  assign(first, last, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R> &
+SortedBinaryTree__<K, T, S, C, A, R>::operator=(
+    const SortedBinaryTree__ &other) {
   if (this != &other) {
-    free_tree();
-    root_ = nullptr;
-    for (auto i = other.begin(); i != other.end(); ++i)
-      (*this).insert(*i);
+    clear();
+    clone_tree(other);
   }
   return *this;
 }
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C> &
-SortedBinaryTree__<K, T, S, C>::operator=(SortedBinaryTree__ &&other) {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R> &
+SortedBinaryTree__<K, T, S, C, A, R>::operator=(SortedBinaryTree__ &&other) {
   if (this != &other) {
-    free_tree();
-    root_ = nullptr;
-    std::swap(root_, other.root_);
-    std::swap(size_, other.size_);
+    clear();
+    swap(other);
   }
   return *this;
 }
 
-template <class K, class T, class S, class C>
-SortedBinaryTree__<K, T, S, C> &SortedBinaryTree__<K, T, S, C>::operator=(
+template <class K, class T, class S, class C, template <class> class A, bool R>
+SortedBinaryTree__<K, T, S, C, A, R> &
+SortedBinaryTree__<K, T, S, C, A, R>::operator=(
     const std::initializer_list<value_type> &items) {
-  free_tree();
-  for (auto i = items.begin(); i != items.end(); ++i)
-    (*this).insert(*i);
+  assign(items.begin(), items.end());
   return *this;
 }
 
-template <class K, class T, class S, class C>
-bool SortedBinaryTree__<K, T, S, C>::empty() const {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class InputIt, class>
+void SortedBinaryTree__<K, T, S, C, A, R>::assign(InputIt first, InputIt last,
+                                                  bool is_repeated_allowed) {
+  clear();
+  Vector<node_pointer> nodes;
+  create_nodes(first, last, nodes);
+  sort_nodes(nodes, is_repeated_allowed);
+  link_sorted_nodes(nodes);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class InputIt>
+void SortedBinaryTree__<K, T, S, C, A, R>::create_nodes(
+    InputIt first, InputIt last, Vector<node_pointer> &nodes) {
+  if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                typename std::iterator_traits<
+                                    InputIt>::iterator_category>::value)
+    nodes.reserve(static_cast<size_type>(std::distance(first, last)));
+  try {
+    for (; first != last; ++first)
+      nodes.push_back(allocator_.create(nullptr, *first));
+  } catch (...) {
+    for (node_pointer node : nodes)
+      allocator_.destroy(node);
+    throw;
+  }
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+bool SortedBinaryTree__<K, T, S, C, A, R>::empty() const {
   return size_ == 0UL;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::size_type
-SortedBinaryTree__<K, T, S, C>::size() const {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::size() const {
   return size_;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::size_type
-SortedBinaryTree__<K, T, S, C>::max_size() const {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::max_size() const {
   return std::numeric_limits<difference_type>().max() / sizeof(node_type);
 }
 
-template <class K, class T, class S, class C>
-bool SortedBinaryTree__<K, T, S, C>::contains(const key_type &key) const {
-  node_pointer ptr = find_suitable_node(key);
-  return ptr && ptr->key() == key;
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+bool SortedBinaryTree__<K, T, S, C, A, R>::contains(const Lookup &key) const {
+  return find_node(key, root()) != nullptr;
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::swap(SortedBinaryTree__ &other) {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::swap(SortedBinaryTree__ &other) {
   if (this != &other) {
-    std::swap(root_, other.root_);
+    std::swap(header_, other.header_);
     std::swap(size_, other.size_);
+    allocator_.swap(other.allocator_);
+    repoint_header();
+    other.repoint_header();
   }
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::merge(SortedBinaryTree__ &other,
-                                           bool is_repeated_allowed) {
-  auto i = other.begin();
-  while (i.data()) {
-    if (is_repeated_allowed || find(key_identify()(*i)) == end()) {
-      iterator save = ++i;
-      if (!i.data())
-        i = --other.end();
-      else
-        --i;
-      other.repoint_for_erase(i);
-      i.data()->set_left(nullptr);
-      i.data()->set_right(nullptr);
-      i.data()->set_parent(nullptr);
-      insert_new_node(i.data(), find_suitable_node(i.data()->key()),
-                      is_repeated_allowed);
-      i = save;
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::merge(SortedBinaryTree__ &other,
+                                                 bool is_repeated_allowed) {
+  if (this == &other || other.empty())
+    return;
+  // linking of every node separately takes m * log(n + m) steps, merging of
+  // the sorted sequences with the rebuild of both trees takes n + m steps
+  size_type total = size_ + other.size_;
+  size_type depth = 1UL;
+  while ((2UL << depth) <= total)
+    ++depth;
+  if (other.size_ * depth < total)
+    merge_by_insertion(other, is_repeated_allowed);
+  else
+    merge_by_rebuild(other, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::merge_by_insertion(
+    SortedBinaryTree__ &other, bool is_repeated_allowed) {
+  iterator i = other.begin();
+  while (i != other.end()) {
+    auto suitable = find_suitable_node(key_identify()(*i), is_repeated_allowed);
+    if (suitable.second) {
+      // the key is already here, so the node stays in the other tree
+      ++i;
       continue;
     }
-    ++i;
+    iterator next = i;
+    ++next;
+    node_pointer node = nullptr;
+    if (allocator_ == other.allocator_) {
+      node = other.repoint_for_erase(i);
+    } else {
+      // node belongs to the other allocator, so it has to be recreated
+      node = allocator_.create(nullptr, std::move_if_noexcept(*i));
+      other.erase(i);
+    }
+    insert_new_node(node, suitable.first);
+    i = next;
+  }
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::merge_by_rebuild(
+    SortedBinaryTree__ &other, bool is_repeated_allowed) {
+  // both trees are walked in order at the same time, nodes are relinked only
+  // when all the sorted sequences are ready
+  bool is_shared = allocator_ == other.allocator_;
+  Vector<node_pointer> merged, rest, moved, copies;
+  merged.reserve(size_ + other.size_);
+  rest.reserve(other.size_);
+  if (!is_shared) {
+    moved.reserve(other.size_);
+    copies.reserve(other.size_);
+  }
+  iterator own = begin(), their = other.begin();
+  try {
+    while (their != other.end()) {
+      node_pointer node = static_cast<node_pointer>(their.data());
+      // equal nodes of this tree go first just like with insertion
+      if (own != end() && !key_compare()(node->key(), key_identify()(*own))) {
+        merged.push_back(static_cast<node_pointer>(own.data()));
+        ++own;
+      } else if (!is_repeated_allowed && !merged.empty() &&
+                 !key_compare()(merged.back()->key(), node->key())) {
+        rest.push_back(node);
+        ++their;
+      } else {
+        if (is_shared) {
+          merged.push_back(node);
+        } else {
+          // nodes are recreated before any relinking, the values that were
+          // moved into them go back if a later creation fails
+          copies.push_back(allocator_.create(
+              nullptr, std::move_if_noexcept(node->value())));
+          merged.push_back(copies.back());
+          moved.push_back(node);
+        }
+        ++their;
+      }
+    }
+  } catch (...) {
+    for (size_type i = 0UL; i < copies.size(); ++i) {
+      // values that may throw on move were copied, the sources are intact
+      if constexpr (std::is_nothrow_move_constructible<value_type>::value) {
+        value_type *source = std::addressof(moved[i]->data_);
+        source->~value_type();
+        new (source) value_type(std::move(copies[i]->data_));
+      }
+      allocator_.destroy(copies[i]);
+    }
+    throw;
+  }
+  for (; own != end(); ++own)
+    merged.push_back(static_cast<node_pointer>(own.data()));
+  for (node_pointer node : moved)
+    other.allocator_.destroy(node);
+
+  reset_header();
+  link_sorted_nodes(merged);
+  other.reset_header();
+  other.link_sorted_nodes(rest);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::split(const key_type &key,
+                                                 SortedBinaryTree__ &greater) {
+  if (this == &greater)
+    return;
+  greater.clear();
+  iterator first = lower_bound(key);
+  if (first == end())
+    return;
+  if (first == begin()) {
+    swap(greater);
+    return;
+  }
+  if (allocator_ != greater.allocator_) {
+    // nodes belong to this allocator, so the greater part has to be copied
+    greater.assign(first, end(), true);
+    erase(first, end());
+    return;
+  }
+  size_type greater_size = 0UL;
+  if constexpr (!R) {
+    // without subtree sizes the smaller part is counted, walking from the
+    // boundary in both directions at once
+    iterator forward = first, backward = first;
+    while (forward != end() && backward != begin()) {
+      ++forward;
+      --backward;
+      ++greater_size;
+    }
+    if (forward != end())
+      greater_size = size_ - greater_size;
+  }
+  node_pointer less_min = header_.left_, greater_max = header_.right_;
+  node_pointer greater_min = static_cast<node_pointer>(first.data());
+  node_pointer less_max = static_cast<node_pointer>((--first).data());
+
+  // the first greater node is cut out with the parts around it and becomes
+  // the smallest node of the greater part again
+  node_pointer less = nullptr, more = nullptr;
+  size_type less_height = 0UL, more_height = 0UL;
+  split_around(greater_min, less, less_height, more, more_height);
+  more = join_trees(nullptr, 0UL, greater_min, more, more_height, more_height);
+  if constexpr (R)
+    greater_size = subtree_size(more);
+
+  header_.set_parent(less);
+  header_.set_left(less_min);
+  header_.set_right(less_max);
+  less->set_parent(&header_);
+  size_ -= greater_size;
+  greater.header_.set_parent(more);
+  greater.header_.set_left(greater_min);
+  greater.header_.set_right(greater_max);
+  more->set_parent(&greater.header_);
+  greater.size_ = greater_size;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::split_around(
+    node_pointer node, node_pointer &less, size_type &less_height,
+    node_pointer &more, size_type &more_height) {
+  // the path to the root is walked from the node up: every ancestor with its
+  // outer subtree is joined to the part it belongs to, black heights of these
+  // subtrees grow along the path, so all the joins take log(n) steps
+  less = node->left_;
+  more = node->right_;
+  less_height = more_height = black_height(less);
+  size_type child_height = less_height + (is_red(node) ? 0UL : 1UL);
+  base_pointer child = node;
+  for (base_pointer next = node->parent(); next != &header_;) {
+    node_pointer parent = static_cast<node_pointer>(next);
+    next = parent->parent();
+    size_type height = child_height + (is_red(parent) ? 0UL : 1UL);
+    if (parent->right_ == child)
+      less = join_trees(parent->left_, child_height, parent, less, less_height,
+                        less_height);
+    else
+      more = join_trees(more, more_height, parent, parent->right_,
+                        child_height, more_height);
+    child = parent;
+    child_height = height;
+  }
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::join(SortedBinaryTree__ &other,
+                                                bool is_repeated_allowed) {
+  if (this == &other || other.empty())
+    return;
+  if (!empty()) {
+    const key_type &max = header_.right_->key();
+    const key_type &min = other.header_.left_->key();
+    if (is_repeated_allowed ? key_compare()(min, max)
+                            : !key_compare()(max, min))
+      throw std::invalid_argument(
+          "SortedBinaryTree__::join: keys of the other tree must follow the "
+          "keys of this tree");
+  }
+  if (allocator_ != other.allocator_) {
+    merge(other, is_repeated_allowed);
+    return;
+  }
+  if (empty()) {
+    swap(other);
+    return;
+  }
+  // the smallest node of the other tree links both trees together
+  node_pointer other_max = other.header_.right_;
+  size_type other_size = other.size_;
+  node_pointer middle = other.repoint_for_erase(other.begin());
+  size_type height = 0UL;
+  node_pointer joined =
+      join_trees(root(), black_height(root()), middle, other.root(),
+                 black_height(other.root()), height);
+  header_.set_parent(joined);
+  header_.set_right(other_max);
+  joined->set_parent(&header_);
+  size_ += other_size;
+  other.reset_header();
+  other.size_ = 0UL;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::assign_set_operation(
+    const SortedBinaryTree__ &left, const SortedBinaryTree__ &right,
+    SetOperation__ operation, size_type thread_count) {
+  // both trees are walked in order at the same time and the result is linked
+  // from the sorted sequence of the new nodes, so it takes n + m steps
+  clear();
+  Vector<node_pointer> nodes;
+  size_type total = left.size_ + right.size_;
+  thread_count = std::min(thread_count, total / kMinElementsPerThread);
+  // only stateless allocators can create nodes from several threads at once
+  if (std::is_empty<allocator_type>::value && thread_count > 1UL) {
+    collect_in_parallel(left, right, operation, thread_count, nodes);
+  } else {
+    try {
+      collect_set_operation(left.begin(), left.end(), right.begin(),
+                            right.end(), operation, nodes);
+    } catch (...) {
+      for (node_pointer node : nodes)
+        allocator_.destroy(node);
+      throw;
+    }
+  }
+  link_sorted_nodes(nodes);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::collect_set_operation(
+    const_iterator left, const_iterator left_end, const_iterator right,
+    const_iterator right_end, SetOperation__ operation,
+    Vector<node_pointer> &nodes) {
+  bool is_left_kept = operation != SetOperation__::kIntersection;
+  bool is_right_kept = operation == SetOperation__::kUnion ||
+                       operation == SetOperation__::kSymmetricDifference;
+  bool is_common_kept = operation == SetOperation__::kUnion ||
+                        operation == SetOperation__::kIntersection;
+  while (left != left_end && right != right_end) {
+    if (key_compare()(key_identify()(*left), key_identify()(*right))) {
+      if (is_left_kept)
+        nodes.push_back(allocator_.create(nullptr, *left));
+      ++left;
+    } else if (key_compare()(key_identify()(*right), key_identify()(*left))) {
+      if (is_right_kept)
+        nodes.push_back(allocator_.create(nullptr, *right));
+      ++right;
+    } else {
+      if (is_common_kept)
+        nodes.push_back(allocator_.create(nullptr, *left));
+      ++left;
+      ++right;
+    }
+  }
+  for (; is_left_kept && left != left_end; ++left)
+    nodes.push_back(allocator_.create(nullptr, *left));
+  for (; is_right_kept && right != right_end; ++right)
+    nodes.push_back(allocator_.create(nullptr, *right));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::collect_in_parallel(
+    const SortedBinaryTree__ &left, const SortedBinaryTree__ &right,
+    SetOperation__ operation, size_type thread_count,
+    Vector<node_pointer> &nodes) {
+  // keys of the top levels of the bigger tree split both trees into the
+  // key ranges of the similar size, every range is processed by its own
+  // thread and the results are joined in order
+  size_type depth = 0UL;
+  while ((2UL << depth) <= thread_count)
+    ++depth;
+  Vector<const key_type *> pivots;
+  collect_pivots(left.size_ < right.size_ ? right.root() : left.root(), depth,
+                 pivots);
+  size_type count = pivots.size() + 1UL;
+  Vector<Vector<node_pointer>> parts(count);
+  Vector<std::exception_ptr> errors(count);
+  auto collect_part = [&](size_type index) {
+    try {
+      // lower bound keeps all the equal elements in the same range
+      collect_set_operation(
+          index ? left.lower_bound(*pivots[index - 1UL]) : left.begin(),
+          index + 1UL < count ? left.lower_bound(*pivots[index]) : left.end(),
+          index ? right.lower_bound(*pivots[index - 1UL]) : right.begin(),
+          index + 1UL < count ? right.lower_bound(*pivots[index])
+                              : right.end(),
+          operation, parts[index]);
+    } catch (...) {
+      errors[index] = std::current_exception();
+    }
+  };
+  Vector<std::thread> threads;
+  threads.reserve(count - 1UL);
+  for (size_type i = 1UL; i < count; ++i) {
+    try {
+      threads.push_back(std::thread(collect_part, i));
+    } catch (...) {
+      // no more threads available, the rest is done by the current one
+      collect_part(i);
+    }
+  }
+  collect_part(0UL);
+  for (std::thread &thread : threads)
+    thread.join();
+
+  size_type total = 0UL;
+  std::exception_ptr error;
+  for (size_type i = 0UL; i < count; ++i) {
+    total += parts[i].size();
+    if (!error)
+      error = errors[i];
+  }
+  try {
+    if (error)
+      std::rethrow_exception(error);
+    nodes.reserve(total);
+  } catch (...) {
+    for (Vector<node_pointer> &part : parts)
+      for (node_pointer node : part)
+        allocator_.destroy(node);
+    throw;
+  }
+  for (Vector<node_pointer> &part : parts)
+    for (node_pointer node : part)
+      nodes.push_back(node);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::collect_pivots(
+    const base_type *node, size_type depth, Vector<const key_type *> &pivots) {
+  if (node && depth) {
+    const node_type *current = static_cast<const node_type *>(node);
+    collect_pivots(current->left_, depth - 1UL, pivots);
+    pivots.push_back(&current->key());
+    collect_pivots(current->right_, depth - 1UL, pivots);
   }
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::clear() {
-  free_tree();
-  root_ = nullptr;
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::clear() {
+  free_tree(root(), allocator_);
+  reset_header();
+  size_ = 0UL;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::SortedBinaryTreeIterator__ &
-SortedBinaryTree__<K, T, S, C>::iterator::operator++() {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::clear_async() {
+  if (empty())
+    return clear();
+  // the nodes and the allocator that owns them are detached at once and the
+  // tree is left empty with a new allocator
+  Reclaimer__::instance().reclaim(
+      [root = root(), allocator = std::move(allocator_)]() mutable noexcept {
+        free_tree(root, allocator);
+      });
+  allocator_ = allocator_type();
+  reset_header();
+  size_ = 0UL;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTreeIterator__ &
+SortedBinaryTree__<K, T, S, C, A, R>::iterator::operator++() {
   /* forward traversing order
                8
          4           12
       2     6     10      14
     1  3  5  7  9   11  13  15
   */
-  if (tree_root_) {
-    if (!this->ptr_) {
-      this->ptr_ = tree_root_;
-      while (this->ptr_->right_)
-        this->ptr_ = this->ptr_->right_;
-    } else if ((!this->ptr_->parent_ ||
-                this->ptr_ == this->ptr_->parent_->right_) &&
-               !this->ptr_->right_) {
-      while (this->ptr_->parent_ && this->ptr_->parent_->right_ == this->ptr_)
-        this->ptr_ = this->ptr_->parent_;
-      if (!this->ptr_->parent_)
-        this->ptr_ = nullptr;
-      else
-        this->ptr_ = this->ptr_->parent_;
-    } else {
-      if (this->ptr_->right_) {
-        this->ptr_ = this->ptr_->right_;
-        while (this->ptr_->left_)
-          this->ptr_ = this->ptr_->left_;
-      } else {
-        if (this->ptr_ == this->ptr_->parent_->left_)
-          this->ptr_ = this->ptr_->parent_;
-        else
-          this->ptr_ = this->ptr_->parent_->parent_;
-      }
-    }
+  base_pointer node = this->ptr_;
+  if (node->right_) {
+    node = minimum(node->right_);
   } else {
-    this->ptr_ = nullptr;
+    base_pointer parent = node->parent();
+    while (node == parent->right_) {
+      node = parent;
+      parent = parent->parent();
+    }
+    // the greatest node is the root without right subtree, so the loop above
+    // has already stopped on the header
+    if (node->right_ != parent)
+      node = parent;
   }
+  this->ptr_ = node;
   return *this;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::SortedBinaryTreeIterator__
-SortedBinaryTree__<K, T, S, C>::iterator::operator++(int) {
-  const_iterator temp(*this);
-  ++this;
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTreeIterator__
+SortedBinaryTree__<K, T, S, C, A, R>::iterator::operator++(int) {
+  SortedBinaryTreeIterator__ temp(*this);
+  ++(*this);
   return temp;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::SortedBinaryTreeIterator__ &
-SortedBinaryTree__<K, T, S, C>::iterator::operator--() {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTreeIterator__ &
+SortedBinaryTree__<K, T, S, C, A, R>::iterator::operator--() {
   /* reverse traversing order
                   8
             12         4
       14       10   6        2
   15     13  11  9 7  5    3   1
   */
-  if (tree_root_) {
-    if (!this->ptr_) {
-      ++(*this);
-    } else if (this->ptr_->left_) {
-      this->ptr_ = this->ptr_->left_;
-      while (this->ptr_->right_)
-        this->ptr_ = this->ptr_->right_;
-    } else if (this->ptr_->parent_ &&
-               this->ptr_->parent_->right_ == this->ptr_) {
-      this->ptr_ = this->ptr_->parent_;
-    } else {
-      while (this->ptr_->parent_ && this->ptr_->parent_->right_ != this->ptr_)
-        this->ptr_ = this->ptr_->parent_;
-      if (this->ptr_->parent_)
-        this->ptr_ = this->ptr_->parent_;
-      else
-        this->ptr_ = nullptr;
-    }
+  base_pointer node = this->ptr_;
+  if (is_header(node)) {
+    // end() steps back to the greatest node kept in the header
+    node = node->right_;
+  } else if (node->left_) {
+    node = maximum(node->left_);
   } else {
-    this->ptr_ = nullptr;
+    base_pointer parent = node->parent();
+    while (node == parent->left_) {
+      node = parent;
+      parent = parent->parent();
+    }
+    node = parent;
   }
+  this->ptr_ = node;
   return *this;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::SortedBinaryTreeIterator__
-SortedBinaryTree__<K, T, S, C>::iterator::operator--(int) {
-  const_iterator temp(*this);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::SortedBinaryTreeIterator__
+SortedBinaryTree__<K, T, S, C, A, R>::iterator::operator--(int) {
+  SortedBinaryTreeIterator__ temp(*this);
   --(*this);
   return temp;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::iterator
-SortedBinaryTree__<K, T, S, C>::begin() {
-  if (root_) {
-    node_pointer ptr = root_;
-    while (ptr->left_)
-      ptr = ptr->left_;
-    return iterator(ptr, root_);
-  }
-  return iterator(nullptr, root_);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::begin() {
+  return iterator(header_.left_ ? header_.left_ : &header_);
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::const_iterator
-SortedBinaryTree__<K, T, S, C>::begin() const {
-  if (root_) {
-    node_pointer ptr = root_;
-    while (ptr->left_)
-      ptr = ptr->left_;
-    return const_iterator(ptr, root_);
-  }
-  return const_iterator(nullptr, root_);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::begin() const {
+  return const_iterator(header_.left_ ? header_.left_ : &header_);
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::iterator
-SortedBinaryTree__<K, T, S, C>::end() {
-  return iterator(nullptr, root_);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::end() {
+  return iterator(&header_);
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::const_iterator
-SortedBinaryTree__<K, T, S, C>::end() const {
-  return const_iterator(nullptr, root_);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::end() const {
+  return const_iterator(&header_);
 }
 
-template <class K, class T, class S, class C>
-std::pair<typename SortedBinaryTree__<K, T, S, C>::iterator, bool>
-SortedBinaryTree__<K, T, S, C>::insert_new_node(node_pointer node,
-                                                node_pointer suitable_node,
-                                                bool is_repeated_allowed) {
-  if (!root_) {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::insert_new_node(node_pointer node,
+                                                      node_pointer parent) {
+  if (!root()) {
     // insertion in empty tree
-    root_ = node;
+    header_.set_parent(node);
+    header_.set_left(node);
+    header_.set_right(node);
+    node->set_parent(&header_);
+    node->set_left(nullptr);
+    node->set_right(nullptr);
+    node->set_color(Color::kBlack);
+    update_subtree_size(node);
     ++size_;
-    return std::pair<iterator, bool>{iterator(root_, root_), true};
-  }
-  if (key_identify()(node->value()) == suitable_node->key() &&
-      !is_repeated_allowed)
-    // found node with given node's key
-    return std::pair<iterator, bool>{iterator(suitable_node, root_), false};
-  if (key_identify()(node->value()) == suitable_node->key() &&
-      is_repeated_allowed) {
-    // insert anyway for multiset
-    node_pointer new_subtree = node;
-    node->set_parent(suitable_node);
-    ++size_;
-    if (suitable_node->left_)
-      suitable_node->left_->parent_ = new_subtree;
-    new_subtree->right_ = nullptr;
-    new_subtree->left_ = suitable_node->left_;
-    suitable_node->left_ = new_subtree;
-    return std::pair<iterator, bool>{iterator(new_subtree, root_), true};
-  }
-
-  // sorting new node in other cases
-  if (key_compare()(key_identify()(node->value()), suitable_node->key())) {
-    suitable_node->left_ = node;
-    node->set_parent(suitable_node);
-    suitable_node = suitable_node->left_;
+    return iterator(node);
+  }
+  // equal keys go to the right, so the node follows all the nodes with its key
+  return link_new_node(node, parent, key_compare()(node->key(), parent->key()));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::link_new_node(node_pointer node,
+                                                    node_pointer parent,
+                                                    bool is_left) {
+  // parent must not have a child on the chosen side
+  if (is_left) {
+    parent->set_left(node);
+    if (parent == header_.left_)
+      header_.set_left(node);
   } else {
-    suitable_node->right_ = node;
-    node->set_parent(suitable_node);
-    suitable_node = suitable_node->right_;
+    parent->set_right(node);
+    if (parent == header_.right_)
+      header_.set_right(node);
   }
+  node->set_parent(parent);
+  node->set_left(nullptr);
+  node->set_right(nullptr);
+  update_subtree_size(node);
+  shift_subtree_sizes(parent, &header_, true);
+  rebalance_after_insert(node, &header_);
   ++size_;
-  return std::pair<iterator, bool>{iterator(suitable_node, root_), true};
-}
-
-template <class K, class T, class S, class C>
-std::pair<typename SortedBinaryTree__<K, T, S, C>::iterator, bool>
-SortedBinaryTree__<K, T, S, C>::insert(const_reference value,
-                                       bool is_repeated_allowed) {
-  node_pointer suitable_node = find_suitable_node(key_identify()(value));
-  node_pointer new_node = suitable_node;
-  if (!suitable_node || is_repeated_allowed ||
-      suitable_node->key() != key_identify()(value))
-    // if node with given key does not exist - allocate memory for it
-    new_node = new node_type(nullptr, value);
-  return insert_new_node(new_node, suitable_node, is_repeated_allowed);
-}
-
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::erase_case_right_only(
-    node_pointer save_ptr) {
-  // just pop up right node on the current node place
-  if (save_ptr == root_) {
-    root_ = save_ptr->right_;
-    root_->parent_ = nullptr;
-  } else if (save_ptr->parent_) {
-    if (save_ptr->parent_->right_ == save_ptr)
-      save_ptr->parent_->right_ = save_ptr->right_;
-    else
-      save_ptr->parent_->left_ = save_ptr->right_;
-    if (save_ptr->right_)
-      save_ptr->right_->parent_ = save_ptr->parent_;
-  } else {
-    root_ = nullptr;
-  }
-}
-
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::erase_case_right_and_left(
-    node_pointer save_ptr) {
-  // repoint current node right subtree
-  node_pointer right_end = save_ptr->left_;
-  while (right_end->right_)
-    right_end = right_end->right_;
-  right_end->right_ = save_ptr->right_;
-  if (save_ptr->right_)
-    save_ptr->right_->parent_ = right_end;
-  if (save_ptr == root_) {
-    root_ = save_ptr->left_;
-    root_->parent_ = nullptr;
-  } else {
-    if (save_ptr->parent_->right_ == save_ptr)
-      save_ptr->parent_->right_ = save_ptr->left_;
-    else
-      save_ptr->parent_->left_ = save_ptr->left_;
-    save_ptr->left_->parent_ = save_ptr->parent_;
+  return iterator(node);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::insert(const_reference value,
+                                             bool is_repeated_allowed) {
+  return insert_value(value, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::insert(double_reference value,
+                                             bool is_repeated_allowed) {
+  return insert_value(std::move(value), is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::insert(iterator hint,
+                                             const_reference value,
+                                             bool is_repeated_allowed) {
+  return insert_value(hint, value, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::insert(iterator hint,
+                                             double_reference value,
+                                             bool is_repeated_allowed) {
+  return insert_value(hint, std::move(value), is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class InputIt, class>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::insert(InputIt first, InputIt last,
+                                             bool is_repeated_allowed) {
+  Vector<node_pointer> nodes;
+  create_nodes(first, last, nodes);
+  sort_nodes(nodes, is_repeated_allowed);
+  return insert_sorted_nodes(nodes, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::insert_sorted_nodes(
+    Vector<node_pointer> &nodes, bool is_repeated_allowed) {
+  // the same choice as in merge: a small batch is linked node by node, a
+  // large one is merged with the tree and everything is relinked
+  size_type total = size_ + nodes.size();
+  size_type depth = 1UL;
+  while ((2UL << depth) <= total)
+    ++depth;
+  size_type inserted = 0UL;
+  if (nodes.size() * depth < total) {
+    // every node is tried right after the previous one first, so the keys
+    // that fall between the same neighbours of the tree skip the descent
+    iterator next = end();
+    for (node_pointer node : nodes) {
+      if (is_last_position_for(next.data(), node->key(),
+                               is_repeated_allowed)) {
+        next = link_before(next.data(), node);
+        ++inserted;
+      } else {
+        std::pair<iterator, bool> result =
+            insert_created_node(node, is_repeated_allowed);
+        next = result.first;
+        inserted += result.second;
+      }
+      ++next;
+    }
+    return inserted;
+  }
+  Vector<node_pointer> merged;
+  merged.reserve(total);
+  iterator own = begin();
+  for (node_pointer node : nodes) {
+    // equal nodes of this tree go first just like with insertion
+    for (; own != end() && !key_compare()(node->key(), key_identify()(*own));
+         ++own)
+      merged.push_back(static_cast<node_pointer>(own.data()));
+    if (!is_repeated_allowed && !merged.empty() &&
+        !key_compare()(merged.back()->key(), node->key())) {
+      allocator_.destroy(node);
+    } else {
+      merged.push_back(node);
+      ++inserted;
+    }
   }
+  for (; own != end(); ++own)
+    merged.push_back(static_cast<node_pointer>(own.data()));
+  reset_header();
+  link_sorted_nodes(merged);
+  return inserted;
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::erase_case_left_only(
-    node_pointer save_ptr) {
-  // just repoint parent of current node
-  save_ptr->left_->parent_ = save_ptr->parent_;
-  if (save_ptr == root_) {
-    root_ = save_ptr->left_;
-  } else {
-    if (save_ptr->parent_->left_ == save_ptr)
-      save_ptr->parent_->left_ = save_ptr->left_;
-    else
-      save_ptr->parent_->right_ = save_ptr->left_;
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Value>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::insert_value(Value &&value,
+                                                   bool is_repeated_allowed) {
+  auto suitable =
+      find_suitable_node(key_identify()(value), is_repeated_allowed);
+  if (suitable.second)
+    return std::pair<iterator, bool>{iterator(suitable.first), false};
+  // the node is allocated and the value is moved only if the key is new
+  return std::pair<iterator, bool>{
+      insert_new_node(allocator_.create(nullptr, std::forward<Value>(value)),
+                      suitable.first),
+      true};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Value>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::insert_value(iterator hint,
+                                                   Value &&value,
+                                                   bool is_repeated_allowed) {
+  base_pointer position =
+      position_from_hint(hint, key_identify()(value), is_repeated_allowed);
+  if (!position)
+    return insert_value(std::forward<Value>(value), is_repeated_allowed).first;
+  return link_before(position,
+                     allocator_.create(nullptr, std::forward<Value>(value)));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::base_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::position_from_hint(
+    iterator hint, const key_type &key, bool is_repeated_allowed) const {
+  // returns the node that has to follow the key or nullptr if the key
+  // belongs neither right before nor right after the hint
+  base_pointer position = hint.data();
+  if (is_position_for(position, key, is_repeated_allowed))
+    return position;
+  if (position != &header_ &&
+      is_position_for((++hint).data(), key, is_repeated_allowed))
+    return hint.data();
+  return nullptr;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::link_before(base_pointer position,
+                                                  node_pointer node) {
+  // new node is linked right before the position without any descent
+  if (!root())
+    return insert_new_node(node, nullptr);
+  if (position == &header_)
+    return link_new_node(node, header_.right_, false);
+  node_pointer next = static_cast<node_pointer>(position);
+  if (!next->left_)
+    return link_new_node(node, next, true);
+  return link_new_node(node, maximum(next->left_), false);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+bool SortedBinaryTree__<K, T, S, C, A, R>::is_position_for(
+    base_pointer position, const key_type &key,
+    bool is_repeated_allowed) const {
+  // checks that the key fits between the position and its previous node
+  if (position != &header_) {
+    const key_type &next = static_cast<node_pointer>(position)->key();
+    if (is_repeated_allowed ? key_compare()(next, key)
+                            : !key_compare()(key, next))
+      return false;
+  }
+  if (root() && position != header_.left_) {
+    iterator previous(position);
+    node_pointer prev = static_cast<node_pointer>((--previous).data());
+    if (is_repeated_allowed ? key_compare()(key, prev->key())
+                            : !key_compare()(prev->key(), key))
+      return false;
   }
+  return true;
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::erase_case_no_childs(
-    node_pointer save_ptr) {
-  // lower node or root - simple deletion of the node
-  if (save_ptr == root_)
-    root_ = nullptr;
-  else {
-    if (save_ptr->parent_->right_ == save_ptr)
-      save_ptr->parent_->right_ = nullptr;
-    else
-      save_ptr->parent_->left_ = nullptr;
+template <class K, class T, class S, class C, template <class> class A, bool R>
+bool SortedBinaryTree__<K, T, S, C, A, R>::is_last_position_for(
+    base_pointer position, const key_type &key,
+    bool is_repeated_allowed) const {
+  // unlike the hint check, the key must follow all the equal keys, so the
+  // order of the repeated elements is the same as with plain insertion
+  if (position != &header_ &&
+      !key_compare()(key, static_cast<node_pointer>(position)->key()))
+    return false;
+  if (root() && position != header_.left_) {
+    iterator previous(position);
+    node_pointer prev = static_cast<node_pointer>((--previous).data());
+    if (is_repeated_allowed ? key_compare()(key, prev->key())
+                            : !key_compare()(prev->key(), key))
+      return false;
   }
+  return true;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::node_pointer
-SortedBinaryTree__<K, T, S, C>::repoint_for_erase(iterator pos) {
-  node_pointer save_ptr = pos.data();
-  if (!save_ptr->left_ && save_ptr->right_)
-    erase_case_right_only(save_ptr);
-  else if (save_ptr->right_)
-    erase_case_right_and_left(save_ptr);
-  else if (save_ptr->left_)
-    erase_case_left_only(save_ptr);
-  else
-    erase_case_no_childs(save_ptr);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::repoint_for_erase(iterator pos) {
+  node_pointer save_ptr = static_cast<node_pointer>(pos.data());
+  if (size_ == 1UL) {
+    reset_header();
+    size_ = 0UL;
+    return save_ptr;
+  }
+  // the smallest and the greatest nodes are replaced by their neighbours
+  if (save_ptr == header_.left_)
+    header_.set_left(static_cast<node_pointer>((++iterator(pos)).data()));
+  if (save_ptr == header_.right_)
+    header_.set_right(static_cast<node_pointer>((--iterator(pos)).data()));
+  // ancestors of the node that leaves its place lose one descendant
+  shift_subtree_sizes(save_ptr->left_ && save_ptr->right_
+                          ? minimum(save_ptr->right_)->parent()
+                          : save_ptr->parent(),
+                      &header_, false);
+
+  node_pointer replacement = nullptr;
+  base_pointer replacement_parent = nullptr;
+  Color removed_color = save_ptr->color();
+  if (!save_ptr->left_) {
+    // just pop up right node on the current node place
+    replacement = save_ptr->right_;
+    replacement_parent = save_ptr->parent();
+    transplant(save_ptr, save_ptr->right_, &header_);
+  } else if (!save_ptr->right_) {
+    // just pop up left node on the current node place
+    replacement = save_ptr->left_;
+    replacement_parent = save_ptr->parent();
+    transplant(save_ptr, save_ptr->left_, &header_);
+  } else {
+    // relink the closest greater node on the current node place
+    node_pointer successor = minimum(save_ptr->right_);
+    removed_color = successor->color();
+    replacement = successor->right_;
+    if (successor->parent() == save_ptr) {
+      replacement_parent = successor;
+    } else {
+      replacement_parent = successor->parent();
+      transplant(successor, successor->right_, &header_);
+      successor->set_right(save_ptr->right_);
+      successor->right_->set_parent(successor);
+    }
+    transplant(save_ptr, successor, &header_);
+    successor->set_left(save_ptr->left_);
+    successor->left_->set_parent(successor);
+    successor->set_color(save_ptr->color());
+    update_subtree_size(successor);
+  }
+  if (removed_color == Color::kBlack)
+    rebalance_after_erase(replacement, replacement_parent, &header_);
   --size_;
   return save_ptr;
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::erase(iterator pos) {
-  // making sure that we're deleting node in this exact tree
-  if (pos.root() == root() && pos.data()) {
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::erase(iterator pos) {
+  if (pos != end()) {
     node_pointer save_ptr = repoint_for_erase(pos);
-    delete save_ptr;
+    allocator_.destroy(save_ptr);
+  }
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::erase(iterator first, iterator last) {
+  if (first == last)
+    return last;
+  if (first == begin() && last == end()) {
+    clear();
+    return end();
+  }
+  node_pointer first_node = static_cast<node_pointer>(first.data());
+  node_pointer min = header_.left_, max = header_.right_;
+  if (first == begin())
+    min = static_cast<node_pointer>(last.data());
+  if (last == end())
+    max = static_cast<node_pointer>((--iterator(first)).data());
+
+  // the range is cut out around its ends and the parts before and after it
+  // are joined back, so the tree is fixed in log(n) steps besides the erased
+  // nodes: the last node goes between the parts again
+  node_pointer less = nullptr, more = nullptr, root = nullptr;
+  size_type less_height = 0UL, more_height = 0UL, height = 0UL;
+  if (last == end()) {
+    split_around(first_node, less, less_height, more, more_height);
+    root = less;
+  } else {
+    node_pointer last_node = static_cast<node_pointer>(last.data());
+    split_around(last_node, less, less_height, more, more_height);
+    node_pointer after = more;
+    size_type after_height = more_height;
+    header_.set_parent(less);
+    less->set_parent(&header_);
+    split_around(first_node, less, less_height, more, more_height);
+    root = join_trees(less, less_height, last_node, after, after_height,
+                      height);
+  }
+  size_type erased = destroy_subtree(more) + 1UL;
+  allocator_.destroy(first_node);
+
+  root->set_color(Color::kBlack);
+  root->set_parent(&header_);
+  header_.set_parent(root);
+  header_.set_left(min);
+  header_.set_right(max);
+  size_ -= erased;
+  return last;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Predicate>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::erase_if(Predicate pred) {
+  Vector<node_pointer> nodes;
+  nodes.reserve(size_);
+  for (iterator i = begin(); i != end(); ++i)
+    nodes.push_back(static_cast<node_pointer>(i.data()));
+  // the predicate may throw, so the tree is not changed until it is called
+  // for all the values. Nodes that stay are moved to the front in order
+  size_type kept = 0UL;
+  for (size_type i = 0UL; i < nodes.size(); ++i) {
+    if (!pred(static_cast<const_reference>(nodes[i]->data_)))
+      std::swap(nodes[kept++], nodes[i]);
+  }
+  size_type erased = nodes.size() - kept;
+  // every erasure from the ranked tree fixes the sizes up to the root, so
+  // the rest is relinked in n steps unless the erasures take fewer, just
+  // like with the merge. Without the sizes erasure rebalances the tree in
+  // amortized constant time and the rest is relinked only if most is erased
+  size_type depth = 1UL;
+  while (R && (2UL << depth) <= nodes.size())
+    ++depth;
+  if (erased * depth <= kept) {
+    for (size_type i = kept; i < nodes.size(); ++i)
+      erase(iterator(nodes[i]));
+    return erased;
+  }
+  while (nodes.size() > kept) {
+    allocator_.destroy(nodes.back());
+    nodes.pop_back();
+  }
+  reset_header();
+  link_sorted_nodes(nodes);
+  return erased;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::insert_return_type
+SortedBinaryTree__<K, T, S, C, A, R>::insert(node_handle &&handle,
+                                             bool is_repeated_allowed) {
+  if (handle.empty())
+    return insert_return_type{end(), false, node_handle()};
+  auto suitable = find_suitable_node(handle.key(), is_repeated_allowed);
+  if (suitable.second)
+    return insert_return_type{iterator(suitable.first), false,
+                              std::move(handle)};
+  node_pointer node = nullptr;
+  if constexpr (kRelinksHandleNodes) {
+    node = handle.release();
+  } else {
+    // the value moves into the pool, the handle keeps its node on exception
+    node = allocator_.create(nullptr, std::move(handle.value()));
+    handle.reset();
+  }
+  return insert_return_type{insert_new_node(node, suitable.first), true,
+                            node_handle()};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_handle
+SortedBinaryTree__<K, T, S, C, A, R>::extract(iterator pos) {
+  if (pos == end())
+    return node_handle();
+  if constexpr (kRelinksHandleNodes) {
+    return node_handle(repoint_for_erase(pos));
+  } else {
+    // the pool can be destroyed before the handle, so the value is moved
+    // into the node of the handle before the tree changes
+    node_pointer owned = handle_allocator_type().create(
+        nullptr, std::move_if_noexcept(*pos));
+    allocator_.destroy(repoint_for_erase(pos));
+    return node_handle(owned);
   }
 }
 
-template <class K, class T, class S, class C>
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_handle
+SortedBinaryTree__<K, T, S, C, A, R>::extract(const key_type &key) {
+  // the first of the equal nodes is extracted
+  iterator pos = lower_bound(key);
+  if (pos == end() ||
+      key_compare()(key, static_cast<node_pointer>(pos.data())->key()))
+    return node_handle();
+  return extract(pos);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class... Args>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::emplace(bool is_repeated_allowed,
+                                              Args &&...args) {
+  // the key is known only after the value is constructed
+  return insert_created_node(
+      allocator_.create(nullptr, std::in_place, std::forward<Args>(args)...),
+      is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class... Args>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::emplace_hint(iterator hint,
+                                                   bool is_repeated_allowed,
+                                                   Args &&...args) {
+  node_pointer node =
+      allocator_.create(nullptr, std::in_place, std::forward<Args>(args)...);
+  base_pointer position =
+      position_from_hint(hint, node->key(), is_repeated_allowed);
+  if (!position)
+    return insert_created_node(node, is_repeated_allowed).first;
+  return link_before(position, node);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class... Args>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::try_emplace(const key_type &key,
+                                                  Args &&...args) {
+  // the node is allocated only if the key is not in the tree yet
+  auto suitable = find_suitable_node(key, false);
+  if (suitable.second)
+    return std::pair<iterator, bool>{iterator(suitable.first), false};
+  return std::pair<iterator, bool>{
+      insert_new_node(allocator_.create(nullptr, std::in_place,
+                                        std::forward<Args>(args)...),
+                      suitable.first),
+      true};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
 template <class... Args>
-Vector<std::pair<typename SortedBinaryTree__<K, T, S, C>::const_iterator, bool>>
-SortedBinaryTree__<K, T, S, C>::emplace(bool is_repeated_allowed,
-                                        Args &&...args) {
+Vector<std::pair<
+    typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator, bool>>
+SortedBinaryTree__<K, T, S, C, A, R>::insert_many(bool is_repeated_allowed,
+                                                  Args &&...args) {
   Vector<std::pair<const_iterator, bool>> result;
-  emplace_helper(result, is_repeated_allowed, args...);
+  result.reserve(sizeof...(Args));
+  (result.push_back(std::pair<const_iterator, bool>(
+       emplace(is_repeated_allowed, std::forward<Args>(args)))),
+   ...);
   return result;
 }
 
-template <class K, class T, class S, class C>
-template <class... Args>
-void SortedBinaryTree__<K, T, S, C>::emplace_helper(
-    Vector<std::pair<const_iterator, bool>> &result, bool is_repeated_allowed,
-    const_reference value, Args &&...args) {
-  auto mid_res = insert(value, is_repeated_allowed);
-  result.push_back(
-      std::pair<const_iterator, bool>{mid_res.first, mid_res.second});
-  emplace_helper(result, is_repeated_allowed, args...);
-}
-
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::emplace_helper(
-    Vector<std::pair<const_iterator, bool>> &result, bool is_repeated_allowed,
-    const_reference value) {
-  auto mid_res = insert(value, is_repeated_allowed);
-  result.push_back(
-      std::pair<const_iterator, bool>{mid_res.first, mid_res.second});
-}
-
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::iterator
-SortedBinaryTree__<K, T, S, C>::find(const key_type &key) {
-  node_pointer ptr = find_suitable_node(key);
-  if (ptr && ptr->key() == key)
-    return iterator(ptr, root_);
-  else
-    return end();
+template <class K, class T, class S, class C, template <class> class A, bool R>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::insert_created_node(
+    node_pointer node, bool is_repeated_allowed) {
+  auto suitable = find_suitable_node(node->key(), is_repeated_allowed);
+  if (suitable.second) {
+    allocator_.destroy(node);
+    return std::pair<iterator, bool>{iterator(suitable.first), false};
+  }
+  return std::pair<iterator, bool>{insert_new_node(node, suitable.first),
+                                   true};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::find(const Lookup &key) {
+  node_pointer ptr = find_node(key, root());
+  return ptr ? iterator(ptr) : end();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::find(const Lookup &key) const {
+  node_pointer ptr = find_node(key, root());
+  return ptr ? const_iterator(ptr) : end();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::find(iterator hint, const key_type &key) {
+  node_pointer ptr = find_from_hint(hint, key);
+  return ptr ? iterator(ptr) : end();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::find(iterator hint,
+                                           const key_type &key) const {
+  node_pointer ptr = find_from_hint(hint, key);
+  return ptr ? const_iterator(ptr) : end();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::find_from_hint(
+    iterator hint, const key_type &key) const {
+  // climbs from the hint to the closest ancestor whose subtree holds the key,
+  // so the search takes time logarithmic in the distance from the hint
+  if (!root())
+    return nullptr;
+  node_pointer node = hint.data() == &header_
+                          ? header_.right_
+                          : static_cast<node_pointer>(hint.data());
+  bool is_less = key_compare()(key, node->key());
+  if (!is_less && !key_compare()(node->key(), key))
+    return node;
+  while (node != root()) {
+    node_pointer parent = static_cast<node_pointer>(node->parent());
+    bool is_bounded = is_less ? node == parent->right_ &&
+                                    !key_compare()(key, parent->key())
+                              : node == parent->left_ &&
+                                    !key_compare()(parent->key(), key);
+    node = parent;
+    if (is_bounded)
+      break;
+  }
+  return find_node(key, node);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::lower_bound(const Lookup &key) {
+  return iterator(lower_bound_node(key, root(), &header_));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::lower_bound(const Lookup &key) const {
+  return const_iterator(lower_bound_node(key, root(), &header_));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::upper_bound(const Lookup &key) {
+  return iterator(upper_bound_node(key, root(), &header_));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::upper_bound(const Lookup &key) const {
+  return const_iterator(upper_bound_node(key, root(), &header_));
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::iterator,
+          typename SortedBinaryTree__<K, T, S, C, A, R>::iterator>
+SortedBinaryTree__<K, T, S, C, A, R>::equal_range(const Lookup &key) {
+  auto nodes = equal_range_nodes(key);
+  return std::pair<iterator, iterator>{iterator(nodes.first),
+                                       iterator(nodes.second)};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator,
+          typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator>
+SortedBinaryTree__<K, T, S, C, A, R>::equal_range(const Lookup &key) const {
+  auto nodes = equal_range_nodes(key);
+  return std::pair<const_iterator, const_iterator>{
+      const_iterator(nodes.first), const_iterator(nodes.second)};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+const typename SortedBinaryTree__<K, T, S, C, A, R>::base_type *
+SortedBinaryTree__<K, T, S, C, A, R>::lower_bound_node(
+    const Lookup &key, const base_type *node, const base_type *result) const {
+  // the last node where the descent turned left is the first not less node
+  while (node) {
+    const node_type *current = static_cast<const node_type *>(node);
+    if (!key_compare()(current->key(), key)) {
+      result = node;
+      node = current->left_;
+    } else {
+      node = current->right_;
+    }
+  }
+  return result;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+const typename SortedBinaryTree__<K, T, S, C, A, R>::base_type *
+SortedBinaryTree__<K, T, S, C, A, R>::upper_bound_node(
+    const Lookup &key, const base_type *node, const base_type *result) const {
+  // the last node where the descent turned left is the first greater node
+  while (node) {
+    const node_type *current = static_cast<const node_type *>(node);
+    if (key_compare()(key, current->key())) {
+      result = node;
+      node = current->left_;
+    } else {
+      node = current->right_;
+    }
+  }
+  return result;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+std::pair<const typename SortedBinaryTree__<K, T, S, C, A, R>::base_type *,
+          const typename SortedBinaryTree__<K, T, S, C, A, R>::base_type *>
+SortedBinaryTree__<K, T, S, C, A, R>::equal_range_nodes(
+    const Lookup &key) const {
+  // both bounds share the path until the first node with equal key, then the
+  // descent splits into its left and right subtrees
+  const base_type *node = root();
+  const base_type *result = &header_;
+  while (node) {
+    const node_type *current = static_cast<const node_type *>(node);
+    if (key_compare()(current->key(), key)) {
+      node = current->right_;
+    } else if (key_compare()(key, current->key())) {
+      result = node;
+      node = current->left_;
+    } else {
+      return std::pair<const base_type *, const base_type *>{
+          lower_bound_node(key, current->left_, node),
+          upper_bound_node(key, current->right_, result)};
+    }
+  }
+  return std::pair<const base_type *, const base_type *>{result, result};
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::free_tree(
+    node_pointer node, allocator_type &allocator) noexcept {
+  if constexpr (allocator_type::kReleasesAll &&
+                std::is_trivially_destructible<node_type>::value) {
+    // nothing to do with nodes, all the memory will be released at once
+    node = nullptr;
+  }
+  // the left child of every node is rotated up until the tree turns into the
+  // right spine, which is freed node by node without any recursion or stack
+  while (node) {
+    if (node_pointer left = node->left_) {
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      node_pointer next = node->right_;
+      if constexpr (allocator_type::kReleasesAll) {
+        // the slot isn't returned to the pool, all of them are released next
+        node->~node_type();
+      } else {
+        allocator.destroy(node);
+      }
+      node = next;
+    }
+  }
+  allocator.release();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::destroy_subtree(
+    node_pointer node) noexcept {
+  // the same rotations into the right spine as in free_tree
+  size_type count = 0UL;
+  while (node) {
+    if (node_pointer left = node->left_) {
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      node_pointer next = node->right_;
+      allocator_.destroy(node);
+      ++count;
+      node = next;
+    }
+  }
+  return count;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::reset_header() {
+  header_.set_parent(nullptr);
+  header_.set_left(nullptr);
+  header_.set_right(nullptr);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::repoint_header() {
+  // root has to point to the header of the tree it currently belongs to
+  if (root())
+    root()->set_parent(&header_);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::find_node(const Lookup &key,
+                                                node_pointer node) const {
+  // one comparison per level: the descent finds the first not less node and
+  // only that node is checked for equality in the end
+  node_pointer result = nullptr;
+  while (node) {
+    if (!key_compare()(node->key(), key)) {
+      result = node;
+      node = node->left_;
+    } else {
+      node = node->right_;
+    }
+  }
+  return result && !key_compare()(key, result->key()) ? result : nullptr;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+std::pair<typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer, bool>
+SortedBinaryTree__<K, T, S, C, A, R>::find_suitable_node(
+    const key_type &key, bool is_repeated_allowed) const {
+  // the descent goes right on equal keys, so it ends at the parent for the
+  // new node after all the equal ones. The last node where it turned right is
+  // the greatest not greater node, the only one that may be equal to the key
+  node_pointer parent = nullptr;
+  node_pointer not_greater = nullptr;
+  node_pointer node = root();
+  while (node) {
+    parent = node;
+    if (key_compare()(key, node->key())) {
+      node = node->left_;
+    } else {
+      not_greater = node;
+      node = node->right_;
+    }
+  }
+  if (!is_repeated_allowed && not_greater &&
+      !key_compare()(not_greater->key(), key))
+    return std::pair<node_pointer, bool>{not_greater, true};
+  return std::pair<node_pointer, bool>{parent, false};
+}
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::height() const {
+  // breadth-first traversal level by level
+  size_type result = 0UL;
+  Vector<node_pointer> level;
+  if (root())
+    level.push_back(root());
+  while (!level.empty()) {
+    Vector<node_pointer> next_level;
+    for (node_pointer node : level) {
+      if (node->left_)
+        next_level.push_back(node->left_);
+      if (node->right_)
+        next_level.push_back(node->right_);
+    }
+    level.swap(next_level);
+    ++result;
+  }
+  return result;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+bool SortedBinaryTree__<K, T, S, C, A, R>::is_red(base_pointer node) {
+  return node && node->color() == Color::kRed;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+bool SortedBinaryTree__<K, T, S, C, A, R>::is_header(base_pointer node) {
+  // the root is black, so only the red header is the parent of its parent
+  return is_red(node) && node->parent() && node->parent()->parent() == node;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::minimum(node_pointer node) {
+  while (node->left_)
+    node = node->left_;
+  return node;
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::const_iterator
-SortedBinaryTree__<K, T, S, C>::find(const key_type &key) const {
-  node_pointer ptr = find_suitable_node(key);
-  if (ptr && ptr->key() == key)
-    return const_iterator(ptr, root_);
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::maximum(node_pointer node) {
+  while (node->right_)
+    node = node->right_;
+  return node;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::rotate_left(node_pointer node,
+                                                       base_pointer header) {
+  /*
+      node                 right
+     /    \               /     \
+    a    right    ->    node     c
+         /   \          /   \
+        b     c        a     b
+  */
+  node_pointer right = node->right_;
+  node->set_right(right->left_);
+  if (right->left_)
+    right->left_->set_parent(node);
+  transplant(node, right, header);
+  right->set_left(node);
+  node->set_parent(right);
+  update_subtree_size(node);
+  update_subtree_size(right);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::rotate_right(node_pointer node,
+                                                        base_pointer header) {
+  /*
+         node            left
+        /    \          /    \
+      left    c   ->   a     node
+     /   \                  /    \
+    a     b                b      c
+  */
+  node_pointer left = node->left_;
+  node->set_left(left->right_);
+  if (left->right_)
+    left->right_->set_parent(node);
+  transplant(node, left, header);
+  left->set_right(node);
+  node->set_parent(left);
+  update_subtree_size(node);
+  update_subtree_size(left);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::transplant(node_pointer old_node,
+                                                      node_pointer new_node,
+                                                      base_pointer header) {
+  // puts new_node on the place of old_node in the parent of old_node
+  base_pointer parent = old_node->parent();
+  if (parent == header)
+    header->set_parent(new_node);
+  else if (old_node == parent->left_)
+    parent->set_left(new_node);
   else
-    return end();
+    parent->set_right(new_node);
+  if (new_node)
+    new_node->set_parent(parent);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+bool SortedBinaryTree__<K, T, S, C, A, R>::rebalance_after_insert(
+    node_pointer node, base_pointer header) {
+  // new node is always red, so only "red parent" rule can be broken
+  node->set_color(Color::kRed);
+  while (node != header->parent() && is_red(node->parent())) {
+    node_pointer parent = static_cast<node_pointer>(node->parent());
+    node_pointer grandparent = static_cast<node_pointer>(parent->parent());
+    if (parent == grandparent->left_) {
+      node_pointer uncle = grandparent->right_;
+      if (is_red(uncle)) {
+        // recolor and move the violation two levels up
+        parent->set_color(Color::kBlack);
+        uncle->set_color(Color::kBlack);
+        grandparent->set_color(Color::kRed);
+        node = grandparent;
+      } else {
+        if (node == parent->right_) {
+          node = parent;
+          rotate_left(node, header);
+          parent = static_cast<node_pointer>(node->parent());
+        }
+        parent->set_color(Color::kBlack);
+        grandparent->set_color(Color::kRed);
+        rotate_right(grandparent, header);
+      }
+    } else {
+      node_pointer uncle = grandparent->left_;
+      if (is_red(uncle)) {
+        parent->set_color(Color::kBlack);
+        uncle->set_color(Color::kBlack);
+        grandparent->set_color(Color::kRed);
+        node = grandparent;
+      } else {
+        if (node == parent->left_) {
+          node = parent;
+          rotate_right(node, header);
+          parent = static_cast<node_pointer>(node->parent());
+        }
+        parent->set_color(Color::kBlack);
+        grandparent->set_color(Color::kRed);
+        rotate_left(grandparent, header);
+      }
+    }
+  }
+  // tells if the black height of the tree grows with the recolored root
+  bool is_grown = is_red(header->parent());
+  header->parent()->set_color(Color::kBlack);
+  return is_grown;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::rebalance_after_erase(
+    node_pointer node, base_pointer base_parent, base_pointer header) {
+  // node carries an extra black that has to be pushed up or absorbed, parent
+  // is passed separately because node can be nullptr
+  while (node != header->parent() && !is_red(node)) {
+    node_pointer parent = static_cast<node_pointer>(base_parent);
+    if (node == parent->left_) {
+      node_pointer sibling = parent->right_;
+      if (is_red(sibling)) {
+        sibling->set_color(Color::kBlack);
+        parent->set_color(Color::kRed);
+        rotate_left(parent, header);
+        sibling = parent->right_;
+      }
+      if (!is_red(sibling->left_) && !is_red(sibling->right_)) {
+        sibling->set_color(Color::kRed);
+        node = parent;
+        base_parent = parent->parent();
+      } else {
+        if (!is_red(sibling->right_)) {
+          sibling->left_->set_color(Color::kBlack);
+          sibling->set_color(Color::kRed);
+          rotate_right(sibling, header);
+          sibling = parent->right_;
+        }
+        sibling->set_color(parent->color());
+        parent->set_color(Color::kBlack);
+        sibling->right_->set_color(Color::kBlack);
+        rotate_left(parent, header);
+        node = static_cast<node_pointer>(header->parent());
+      }
+    } else {
+      node_pointer sibling = parent->left_;
+      if (is_red(sibling)) {
+        sibling->set_color(Color::kBlack);
+        parent->set_color(Color::kRed);
+        rotate_right(parent, header);
+        sibling = parent->left_;
+      }
+      if (!is_red(sibling->left_) && !is_red(sibling->right_)) {
+        sibling->set_color(Color::kRed);
+        node = parent;
+        base_parent = parent->parent();
+      } else {
+        if (!is_red(sibling->left_)) {
+          sibling->right_->set_color(Color::kBlack);
+          sibling->set_color(Color::kRed);
+          rotate_left(sibling, header);
+          sibling = parent->left_;
+        }
+        sibling->set_color(parent->color());
+        parent->set_color(Color::kBlack);
+        sibling->left_->set_color(Color::kBlack);
+        rotate_right(parent, header);
+        node = static_cast<node_pointer>(header->parent());
+      }
+    }
+  }
+  if (node)
+    node->set_color(Color::kBlack);
 }
 
-template <class K, class T, class S, class C>
-void SortedBinaryTree__<K, T, S, C>::free_tree() {
-  node_pointer current = root_;
-  if (current) {
-    if (current->left_) {
-      root_ = current->left_;
-      free_tree();
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::clone_tree(
+    const SortedBinaryTree__ &other) {
+  // both trees are walked simultaneously in pre-order, so the copy gets the
+  // same shape and colors and no keys are compared
+  node_pointer source = other.root();
+  if (!source)
+    return;
+  allocator_.reserve(other.size_);
+  try {
+    node_pointer target = allocator_.create(&header_, source->value());
+    header_.set_parent(target);
+    target->set_color(source->color());
+    ++size_;
+    for (;;) {
+      if (source->left_ && !target->left_) {
+        source = source->left_;
+        target->set_left(allocator_.create(target, source->value()));
+        target = target->left_;
+      } else if (source->right_ && !target->right_) {
+        source = source->right_;
+        target->set_right(allocator_.create(target, source->value()));
+        target = target->right_;
+      } else {
+        // all the children of the target are already copied
+        update_subtree_size(target);
+        if (source == other.root())
+          break;
+        source = static_cast<node_pointer>(source->parent());
+        target = static_cast<node_pointer>(target->parent());
+        continue;
+      }
+      target->set_color(source->color());
+      ++size_;
     }
-    if (current->right_) {
-      root_ = current->right_;
-      free_tree();
+    header_.set_left(minimum(root()));
+    header_.set_right(maximum(root()));
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::sort_nodes(
+    Vector<node_pointer> &nodes, bool is_repeated_allowed) {
+  // already sorted sequences are detected in one pass and don't need sorting
+  auto node_less = [](node_pointer left, node_pointer right) {
+    return key_compare()(left->key(), right->key());
+  };
+  if (!std::is_sorted(nodes.begin(), nodes.end(), node_less))
+    std::stable_sort(nodes.begin(), nodes.end(), node_less);
+  if (!is_repeated_allowed && !nodes.empty()) {
+    // the first of the equal nodes stays just like with sequential insertion
+    size_type unique_count = 1UL;
+    for (size_type i = 1UL; i < nodes.size(); ++i) {
+      if (node_less(nodes[unique_count - 1UL], nodes[i]))
+        nodes[unique_count++] = nodes[i];
+      else
+        allocator_.destroy(nodes[i]);
     }
-    delete current;
-    --size_;
+    while (nodes.size() > unique_count)
+      nodes.pop_back();
   }
 }
 
-template <class K, class T, class S, class C>
-typename SortedBinaryTree__<K, T, S, C>::node_pointer
-SortedBinaryTree__<K, T, S, C>::find_suitable_node(const key_type &key) const {
-  if (!root_)
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::link_sorted_nodes(
+    Vector<node_pointer> &nodes) {
+  // nodes on the last level are red only if that level is not complete, so
+  // every path from the root to the leaf has the same count of black nodes
+  size_type red_depth = 0UL;
+  while ((2UL << red_depth) <= nodes.size() + 1UL)
+    ++red_depth;
+  header_.set_parent(
+      link_balanced(nodes.data(), nodes.size(), &header_, 0UL, red_depth));
+  if (!nodes.empty()) {
+    header_.set_left(nodes.front());
+    header_.set_right(nodes.back());
+  }
+  size_ = nodes.size();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::link_balanced(node_pointer *nodes,
+                                                    size_type count,
+                                                    base_pointer parent,
+                                                    size_type depth,
+                                                    size_type red_depth) {
+  if (!count)
     return nullptr;
-  node_pointer current = root_;
-  while (key != current->key()) {
-    if (key_compare()(key, current->key())) {
-      if (current->left_)
-        current = current->left_;
+  size_type middle = count / 2UL;
+  node_pointer node = nodes[middle];
+  node->set_parent(parent);
+  node->set_color(depth == red_depth ? Color::kRed : Color::kBlack);
+  node->set_left(link_balanced(nodes, middle, node, depth + 1UL, red_depth));
+  node->set_right(link_balanced(nodes + middle + 1UL, count - middle - 1UL,
+                                node, depth + 1UL, red_depth));
+  update_subtree_size(node);
+  return node;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::black_height(node_pointer node) {
+  size_type height = 0UL;
+  for (; node; node = node->left_)
+    height += is_red(node) ? 0UL : 1UL;
+  return height;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::join_trees(
+    node_pointer left, size_type left_height, node_pointer middle,
+    node_pointer right, size_type right_height, size_type &height) {
+  // links two trees with the middle node between them in the time
+  // proportional to the difference of their black heights. Red roots are
+  // made black first, so the height of the result is known without a walk
+  if (is_red(left)) {
+    left->set_color(Color::kBlack);
+    ++left_height;
+  }
+  if (is_red(right)) {
+    right->set_color(Color::kBlack);
+    ++right_height;
+  }
+  if (left_height == right_height) {
+    middle->set_left(left);
+    middle->set_right(right);
+    if (left)
+      left->set_parent(middle);
+    if (right)
+      right->set_parent(middle);
+    middle->set_color(Color::kBlack);
+    update_subtree_size(middle);
+    height = left_height + 1UL;
+    return middle;
+  }
+  // the middle node takes the place of the black node on the inner spine of
+  // the taller tree that has the same black height as the shorter tree
+  bool is_left_taller = left_height > right_height;
+  node_pointer taller = is_left_taller ? left : right;
+  size_type target_height = is_left_taller ? right_height : left_height;
+  height = is_left_taller ? left_height : right_height;
+  base_type header;
+  header.set_parent(taller);
+  taller->set_parent(&header);
+  node_pointer parent = nullptr, node = taller;
+  for (size_type node_height = height;
+       node && (is_red(node) || node_height > target_height);) {
+    node_height -= is_red(node) ? 0UL : 1UL;
+    parent = node;
+    node = is_left_taller ? node->right_ : node->left_;
+  }
+  if (is_left_taller) {
+    middle->set_left(node);
+    middle->set_right(right);
+    parent->set_right(middle);
+  } else {
+    middle->set_left(left);
+    middle->set_right(node);
+    parent->set_left(middle);
+  }
+  middle->set_parent(parent);
+  if (middle->left_)
+    middle->left_->set_parent(middle);
+  if (middle->right_)
+    middle->right_->set_parent(middle);
+  update_subtree_size(middle);
+  if constexpr (R) {
+    for (base_pointer i = parent; i != &header; i = i->parent())
+      update_subtree_size(i);
+  }
+  if (rebalance_after_insert(middle, &header))
+    ++height;
+  return static_cast<node_pointer>(header.parent());
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::subtree_size(const base_type *node) {
+  if constexpr (R)
+    return node ? node->subtree_size_ : 0UL;
+  else
+    return 0UL;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::update_subtree_size(
+    base_pointer node) {
+  if constexpr (R)
+    node->subtree_size_ =
+        1UL + subtree_size(node->left_) + subtree_size(node->right_);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+void SortedBinaryTree__<K, T, S, C, A, R>::shift_subtree_sizes(
+    base_pointer node, base_pointer header, bool is_growing) {
+  // walks from the node up to the root
+  if constexpr (R) {
+    for (; node != header; node = node->parent()) {
+      if (is_growing)
+        ++node->subtree_size_;
       else
-        break;
+        --node->subtree_size_;
+    }
+  }
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::iterator
+SortedBinaryTree__<K, T, S, C, A, R>::nth(size_type index) {
+  node_pointer node = find_nth(index);
+  return node ? iterator(node) : end();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::const_iterator
+SortedBinaryTree__<K, T, S, C, A, R>::nth(size_type index) const {
+  node_pointer node = find_nth(index);
+  return node ? const_iterator(node) : end();
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::rank(const key_type &key) const {
+  return count_before(key, false);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::count(const Lookup &key) const {
+  return count_before(key, true) - count_before(key, false);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::count_range(const key_type &low,
+                                                  const key_type &high) const {
+  if (!key_compare()(low, high))
+    return 0UL;
+  return count_before(high, false) - count_before(low, false);
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+typename SortedBinaryTree__<K, T, S, C, A, R>::node_pointer
+SortedBinaryTree__<K, T, S, C, A, R>::find_nth(size_type index) const {
+  static_assert(R, "Order statistics are available only for ranked trees");
+  node_pointer node = root();
+  while (node) {
+    size_type left_size = subtree_size(node->left_);
+    if (index < left_size) {
+      node = node->left_;
+    } else if (index == left_size) {
+      break;
     } else {
-      if (current->right_)
-        current = current->right_;
-      else
-        break;
+      index -= left_size + 1UL;
+      node = node->right_;
+    }
+  }
+  return node;
+}
+
+template <class K, class T, class S, class C, template <class> class A, bool R>
+template <class Lookup>
+typename SortedBinaryTree__<K, T, S, C, A, R>::size_type
+SortedBinaryTree__<K, T, S, C, A, R>::count_before(const Lookup &key,
+                                                   bool is_inclusive) const {
+  // counts values that are less than key, or not greater if inclusive
+  static_assert(R, "Order statistics are available only for ranked trees");
+  size_type result = 0UL;
+  node_pointer node = root();
+  while (node) {
+    bool is_before = is_inclusive ? !key_compare()(key, node->key())
+                                  : key_compare()(node->key(), key);
+    if (is_before) {
+      result += subtree_size(node->left_) + 1UL;
+      node = node->right_;
+    } else {
+      node = node->left_;
     }
   }
-  return current;
-}
\ No newline at end of file
+  return result;
+}
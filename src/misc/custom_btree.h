@@ -0,0 +1,289 @@
+#ifndef _MISC_CUSTOM_BTREE_H_
+#define _MISC_CUSTOM_BTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "custom_tree_traits.h"
+
+namespace custom {
+
+// Values of the maps have the constant keys, the nodes of the B-tree move
+// them between the slots as the same pairs with the mutable keys, so the keys
+// are moved instead of copied
+template <class T> struct MutableValue__ { using type = T; };
+
+template <class K, class V> struct MutableValue__<std::pair<const K, V>> {
+  using type = std::pair<K, V>;
+  static_assert(sizeof(type) == sizeof(std::pair<const K, V>) &&
+                    alignof(type) == alignof(std::pair<const K, V>),
+                "pairs with the constant and the mutable key differ");
+};
+
+/**
+ * @brief Sorted B-tree that keeps many values in one node, so a lookup takes
+ * a cache miss per node instead of per value. Nodes are sized to a few cache
+ * lines, values of the internal nodes separate the subtrees of their children.
+ * Unlike the binary tree every insertion and erasure invalidates iterators
+ *
+ * @tparam Key type of the keys
+ * @tparam T type of the stored values
+ * @tparam Select takes the key from the value
+ * @tparam Compare orders the keys
+ */
+template <class Key, class T, class Select = TypeOfValue__<Key>,
+          class Compare = std::less<Key>>
+class BTree__ {
+public:
+  using key_type = Key;
+  using key_identify = Select;
+  using value_type = T;
+  using key_compare = Compare;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using double_reference = value_type &&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+private:
+  using mutable_value_type = typename MutableValue__<value_type>::type;
+
+  // Values of one node take about four cache lines, but at least three values
+  // are kept so the tree stays balanced for large values
+  constexpr static size_type kTargetNodeSize = 256UL;
+  constexpr static size_type kNodeHeaderSize = sizeof(void *) + 8UL;
+  constexpr static size_type kMaxValues =
+      std::max<size_type>(3UL, std::min<size_type>(
+                                   (kTargetNodeSize - kNodeHeaderSize) /
+                                       sizeof(value_type),
+                                   255UL));
+  // Nodes with fewer values are merged with or refilled from the siblings
+  constexpr static size_type kMinValues = kMaxValues / 2UL;
+
+  // Leaf node, internal nodes extend it with the children
+  struct Node {
+    Node *parent_;
+    // index of the node among the children of the parent
+    std::uint16_t position_;
+    std::uint16_t count_;
+    bool is_leaf_;
+    alignas(value_type) unsigned char storage_[kMaxValues * sizeof(value_type)];
+
+    pointer value(size_type index) {
+      return std::launder(reinterpret_cast<pointer>(storage_) + index);
+    }
+    const_pointer value(size_type index) const {
+      return std::launder(reinterpret_cast<const_pointer>(storage_) + index);
+    }
+    const key_type &key(size_type index) const {
+      return key_identify()(*value(index));
+    }
+  };
+
+  struct InternalNode : Node {
+    Node *children_[kMaxValues + 1UL];
+  };
+
+  using node_pointer = Node *;
+
+public:
+  class BTreeIterator__ {
+  public:
+    template <class, class, class, class> friend class BTree__;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    BTreeIterator__(node_pointer node, size_type position)
+        : node_(node), position_(position) {}
+
+    BTreeIterator__ &operator++();
+    BTreeIterator__ operator++(int);
+    BTreeIterator__ &operator--();
+    BTreeIterator__ operator--(int);
+
+    bool operator==(const BTreeIterator__ &other) const {
+      return node_ == other.node_ && position_ == other.position_;
+    }
+
+    bool operator!=(const BTreeIterator__ &other) const {
+      return !(*this == other);
+    }
+
+    reference operator*() { return *node_->value(position_); }
+
+  protected:
+    node_pointer node_;
+    size_type position_;
+  };
+
+  using iterator = BTreeIterator__;
+
+  class BTreeConstIterator__ : public iterator {
+  public:
+    using iterator_category = typename iterator::iterator_category;
+    using difference_type = typename iterator::difference_type;
+    using pointer = const_pointer;
+    using reference = const_reference;
+
+    BTreeConstIterator__(node_pointer node, size_type position)
+        : iterator(node, position) {}
+
+    // implicit just like the conversion of the standard iterators
+    BTreeConstIterator__(const iterator &iter) : iterator(iter) {}
+
+    const_reference operator*() const {
+      return *this->node_->value(this->position_);
+    }
+  };
+
+  using const_iterator = BTreeConstIterator__;
+
+  BTree__() noexcept;
+  ~BTree__();
+  BTree__(const BTree__ &other);
+  BTree__(BTree__ &&other) noexcept;
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  BTree__(InputIt first, InputIt last, bool is_repeated_allowed = false);
+
+  BTree__ &operator=(const BTree__ &other);
+  BTree__ &operator=(BTree__ &&other) noexcept;
+
+  iterator begin();
+  const_iterator begin() const;
+  iterator end();
+  const_iterator end() const;
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  size_type height() const;
+  // Bytes taken by the nodes, without the overhead of the memory allocator
+  size_type memory_usage() const;
+
+  void clear();
+  void swap(BTree__ &other) noexcept;
+  void merge(BTree__ &other, bool is_repeated_allowed = false);
+
+  std::pair<iterator, bool> insert(const_reference value,
+                                   bool is_repeated_allowed = false);
+  std::pair<iterator, bool> insert(double_reference value,
+                                   bool is_repeated_allowed = false);
+  iterator insert(const_iterator hint, const_reference value,
+                  bool is_repeated_allowed = false);
+  iterator insert(const_iterator hint, double_reference value,
+                  bool is_repeated_allowed = false);
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last,
+                   bool is_repeated_allowed = false);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(bool is_repeated_allowed, Args &&...args);
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, bool is_repeated_allowed,
+                        Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  template <class Lookup> size_type erase_key(const Lookup &key);
+  template <class Predicate> size_type erase_if(Predicate pred);
+
+  template <class Lookup> iterator find(const Lookup &key);
+  template <class Lookup> const_iterator find(const Lookup &key) const;
+  template <class Lookup> bool contains(const Lookup &key) const;
+  template <class Lookup> size_type count(const Lookup &key) const;
+  template <class Lookup> iterator lower_bound(const Lookup &key);
+  template <class Lookup> const_iterator lower_bound(const Lookup &key) const;
+  template <class Lookup> iterator upper_bound(const Lookup &key);
+  template <class Lookup> const_iterator upper_bound(const Lookup &key) const;
+  template <class Lookup>
+  std::pair<iterator, iterator> equal_range(const Lookup &key);
+  template <class Lookup>
+  std::pair<const_iterator, const_iterator>
+  equal_range(const Lookup &key) const;
+
+private:
+  node_pointer root_;
+  // the first and the last leaves, the first and the last values are there
+  node_pointer leftmost_;
+  node_pointer rightmost_;
+  size_type size_;
+
+  static node_pointer &child(node_pointer node, size_type index) {
+    return static_cast<InternalNode *>(node)->children_[index];
+  }
+  static node_pointer create_node(bool is_leaf, node_pointer parent,
+                                  size_type position);
+  static void delete_node(node_pointer node) noexcept;
+  static void free_subtree(node_pointer node) noexcept;
+  static size_type subtree_memory(node_pointer node);
+  static mutable_value_type *as_mutable(pointer value) {
+    return std::launder(reinterpret_cast<mutable_value_type *>(value));
+  }
+  template <class Value> static const key_type &key_of(const Value &value) {
+    if constexpr (std::is_same<Value, mutable_value_type>::value)
+      return key_identify()(
+          *std::launder(reinterpret_cast<const_pointer>(&value)));
+    else
+      return key_identify()(value);
+  }
+  // moves the value into the raw slot and destroys the source, the key is
+  // moved too, so the move-only keys are fine
+  static void transfer(pointer to, pointer from) noexcept;
+  static void shift_values_right(node_pointer node, size_type index) noexcept;
+  static void shift_values_left(node_pointer node, size_type index) noexcept;
+  static void shift_children_right(node_pointer node, size_type index) noexcept;
+  static void shift_children_left(node_pointer node, size_type index) noexcept;
+  static void set_child(node_pointer node, size_type index,
+                        node_pointer child_node) noexcept;
+
+  template <class Lookup>
+  size_type lower_index(const Node *node, const Lookup &key) const;
+  template <class Lookup>
+  size_type upper_index(const Node *node, const Lookup &key) const;
+  template <class Lookup>
+  iterator lower_bound_position(const Lookup &key) const;
+  template <class Lookup>
+  iterator upper_bound_position(const Lookup &key) const;
+  // Leaf position for the new key, or the position of the equal key and true
+  // if it is found and repeated keys aren't allowed
+  std::pair<iterator, bool> find_insert_position(const key_type &key,
+                                                 bool is_repeated_allowed);
+  iterator position_from_hint(const_iterator hint, const key_type &key,
+                              bool is_repeated_allowed);
+  iterator end_position() const;
+
+  template <class Value>
+  std::pair<iterator, bool> insert_value(Value &&value,
+                                         bool is_repeated_allowed);
+  template <class Value>
+  iterator insert_value(const_iterator hint, Value &&value,
+                        bool is_repeated_allowed);
+  template <class... Args>
+  iterator emplace_at(iterator position, Args &&...args);
+  void make_room(iterator &position);
+  node_pointer split_node(node_pointer node, size_type insert_index);
+  void rebalance(node_pointer node, iterator &tracked);
+  void merge_children(node_pointer parent, size_type index);
+  void borrow_from_left(node_pointer parent, size_type index);
+  void borrow_from_right(node_pointer parent, size_type index);
+};
+
+#include "custom_btree.tpp"
+
+} // namespace custom
+
+#endif // _MISC_CUSTOM_BTREE_H_
@@ -0,0 +1,836 @@
+template <class K, class T, class S, class C>
+BTree__<K, T, S, C>::BTree__() noexcept
+    : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0UL) {}
+
+template <class K, class T, class S, class C> BTree__<K, T, S, C>::~BTree__() {
+  clear();
+}
+
+template <class K, class T, class S, class C>
+BTree__<K, T, S, C>::BTree__(const BTree__ &other) : BTree__() {
+  // values come in order, so every one of them is appended to the last leaf
+  for (const_reference value : other)
+    insert_value(end(), value, true);
+}
+
+template <class K, class T, class S, class C>
+BTree__<K, T, S, C>::BTree__(BTree__ &&other) noexcept : BTree__() {
+  swap(other);
+}
+
+template <class K, class T, class S, class C>
+template <class InputIt, class>
+BTree__<K, T, S, C>::BTree__(InputIt first, InputIt last,
+                             bool is_repeated_allowed)
+    : BTree__() {
+  insert(first, last, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+BTree__<K, T, S, C> &BTree__<K, T, S, C>::operator=(const BTree__ &other) {
+  if (this != &other) {
+    BTree__ copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <class K, class T, class S, class C>
+BTree__<K, T, S, C> &
+BTree__<K, T, S, C>::operator=(BTree__ &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator BTree__<K, T, S, C>::begin() {
+  // the empty tree has no leaves, so its begin is equal to its end
+  return iterator(leftmost_, 0UL);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::const_iterator
+BTree__<K, T, S, C>::begin() const {
+  return const_iterator(leftmost_, 0UL);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator BTree__<K, T, S, C>::end() {
+  return end_position();
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::const_iterator BTree__<K, T, S, C>::end() const {
+  return end_position();
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::end_position() const {
+  // past-end position is right after the last value of the last leaf
+  return iterator(rightmost_, rightmost_ ? rightmost_->count_ : 0UL);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::size_type BTree__<K, T, S, C>::max_size() const {
+  return std::numeric_limits<difference_type>().max() / sizeof(value_type);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::size_type BTree__<K, T, S, C>::height() const {
+  size_type result = 0UL;
+  for (node_pointer node = root_; node;
+       node = node->is_leaf_ ? nullptr : child(node, 0UL))
+    ++result;
+  return result;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::memory_usage() const {
+  return subtree_memory(root_);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::subtree_memory(node_pointer node) {
+  if (!node)
+    return 0UL;
+  if (node->is_leaf_)
+    return sizeof(Node);
+  size_type result = sizeof(InternalNode);
+  for (size_type i = 0UL; i <= node->count_; ++i)
+    result += subtree_memory(child(node, i));
+  return result;
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::clear() {
+  free_subtree(root_);
+  root_ = leftmost_ = rightmost_ = nullptr;
+  size_ = 0UL;
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::swap(BTree__ &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(size_, other.size_);
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::merge(BTree__ &other, bool is_repeated_allowed) {
+  if (this == &other)
+    return;
+  // values that are already here are collected in order into the new tree
+  // that replaces the other one, the rest are moved into this tree
+  BTree__ rest;
+  for (iterator i = other.begin(); i != other.end(); ++i) {
+    auto position =
+        find_insert_position(key_identify()(*i), is_repeated_allowed);
+    if (position.second)
+      rest.emplace_at(rest.end(), std::move(*as_mutable(&*i)));
+    else
+      emplace_at(position.first, std::move(*as_mutable(&*i)));
+  }
+  other.swap(rest);
+}
+
+template <class K, class T, class S, class C>
+std::pair<typename BTree__<K, T, S, C>::iterator, bool>
+BTree__<K, T, S, C>::insert(const_reference value, bool is_repeated_allowed) {
+  return insert_value(value, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+std::pair<typename BTree__<K, T, S, C>::iterator, bool>
+BTree__<K, T, S, C>::insert(double_reference value, bool is_repeated_allowed) {
+  return insert_value(std::move(value), is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::insert(const_iterator hint, const_reference value,
+                            bool is_repeated_allowed) {
+  return insert_value(hint, value, is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::insert(const_iterator hint, double_reference value,
+                            bool is_repeated_allowed) {
+  return insert_value(hint, std::move(value), is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+template <class InputIt, class>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::insert(InputIt first, InputIt last,
+                            bool is_repeated_allowed) {
+  // the end is used as the hint, so sorted ranges are appended to the last
+  // leaf without any descent
+  size_type old_size = size_;
+  for (; first != last; ++first)
+    insert_value(end(), *first, is_repeated_allowed);
+  return size_ - old_size;
+}
+
+template <class K, class T, class S, class C>
+template <class... Args>
+std::pair<typename BTree__<K, T, S, C>::iterator, bool>
+BTree__<K, T, S, C>::emplace(bool is_repeated_allowed, Args &&...args) {
+  // values are moved between the slots, so it is constructed aside first
+  mutable_value_type value(std::forward<Args>(args)...);
+  return insert_value(std::move(value), is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+template <class... Args>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::emplace_hint(const_iterator hint, bool is_repeated_allowed,
+                                  Args &&...args) {
+  mutable_value_type value(std::forward<Args>(args)...);
+  return insert_value(hint, std::move(value), is_repeated_allowed);
+}
+
+template <class K, class T, class S, class C>
+template <class... Args>
+std::pair<typename BTree__<K, T, S, C>::iterator, bool>
+BTree__<K, T, S, C>::try_emplace(const key_type &key, Args &&...args) {
+  // the value is constructed right in its slot only if the key is new
+  auto position = find_insert_position(key, false);
+  if (position.second)
+    return std::pair<iterator, bool>{position.first, false};
+  return std::pair<iterator, bool>{
+      emplace_at(position.first, std::forward<Args>(args)...), true};
+}
+
+template <class K, class T, class S, class C>
+template <class Value>
+std::pair<typename BTree__<K, T, S, C>::iterator, bool>
+BTree__<K, T, S, C>::insert_value(Value &&value, bool is_repeated_allowed) {
+  auto position =
+      find_insert_position(key_of(value), is_repeated_allowed);
+  if (position.second)
+    return std::pair<iterator, bool>{position.first, false};
+  return std::pair<iterator, bool>{
+      emplace_at(position.first, std::forward<Value>(value)), true};
+}
+
+template <class K, class T, class S, class C>
+template <class Value>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::insert_value(const_iterator hint, Value &&value,
+                                  bool is_repeated_allowed) {
+  if (root_) {
+    iterator position =
+        position_from_hint(hint, key_of(value), is_repeated_allowed);
+    if (position.node_)
+      return emplace_at(position, std::forward<Value>(value));
+  }
+  return insert_value(std::forward<Value>(value), is_repeated_allowed).first;
+}
+
+template <class K, class T, class S, class C>
+template <class... Args>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::emplace_at(iterator position, Args &&...args) {
+  if (!root_) {
+    root_ = leftmost_ = rightmost_ = create_node(true, nullptr, 0UL);
+    position = iterator(root_, 0UL);
+  }
+  make_room(position);
+  node_pointer node = position.node_;
+  size_type index = position.position_;
+  shift_values_right(node, index);
+  ++node->count_;
+  try {
+    new (node->value(index)) value_type(std::forward<Args>(args)...);
+  } catch (...) {
+    shift_values_left(node, index);
+    --node->count_;
+    if (!size_)
+      clear();
+    throw;
+  }
+  ++size_;
+  return position;
+}
+
+template <class K, class T, class S, class C>
+std::pair<typename BTree__<K, T, S, C>::iterator, bool>
+BTree__<K, T, S, C>::find_insert_position(const key_type &key,
+                                          bool is_repeated_allowed) {
+  // repeated keys go after the equal ones, so the descent takes upper bounds
+  node_pointer node = root_;
+  if (!node)
+    return std::pair<iterator, bool>{iterator(nullptr, 0UL), false};
+  while (true) {
+    size_type index = is_repeated_allowed ? upper_index(node, key)
+                                          : lower_index(node, key);
+    if (!is_repeated_allowed && index < node->count_ &&
+        !key_compare()(key, node->key(index)))
+      return std::pair<iterator, bool>{iterator(node, index), true};
+    if (node->is_leaf_)
+      return std::pair<iterator, bool>{iterator(node, index), false};
+    node = child(node, index);
+  }
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::position_from_hint(const_iterator hint,
+                                        const key_type &key,
+                                        bool is_repeated_allowed) {
+  // the key has to fit between the hint and the value before it, otherwise
+  // the null position is returned and the key is searched from the root
+  iterator next(hint.node_, hint.position_);
+  iterator previous = next;
+  if (next != end_position()) {
+    const key_type &next_key = next.node_->key(next.position_);
+    if (is_repeated_allowed ? key_compare()(next_key, key)
+                            : !key_compare()(key, next_key))
+      return iterator(nullptr, 0UL);
+  }
+  if (next != begin()) {
+    --previous;
+    const key_type &previous_key = previous.node_->key(previous.position_);
+    if (is_repeated_allowed ? key_compare()(key, previous_key)
+                            : !key_compare()(previous_key, key))
+      return iterator(nullptr, 0UL);
+  }
+  // values of the internal nodes are always preceded by the leaf values, so
+  // the new one goes either right before the hint or right after the previous
+  if (next.node_->is_leaf_)
+    return next;
+  ++previous.position_;
+  return previous;
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::make_room(iterator &position) {
+  while (position.node_->count_ == kMaxValues) {
+    // the highest of the full nodes on the path is split first, so the parent
+    // of every split node has room for the median
+    node_pointer top = position.node_;
+    while (top->parent_ && top->parent_->count_ == kMaxValues)
+      top = top->parent_;
+    if (top == position.node_) {
+      node_pointer sibling = split_node(top, position.position_);
+      if (position.position_ > top->count_)
+        position = iterator(sibling, position.position_ - top->count_ - 1UL);
+    } else {
+      node_pointer path = position.node_;
+      while (path->parent_ != top)
+        path = path->parent_;
+      split_node(top, path->position_);
+    }
+  }
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::node_pointer
+BTree__<K, T, S, C>::split_node(node_pointer node, size_type insert_index) {
+  // appending and prepending leave the full node behind, so sorted input
+  // fills the nodes completely. Other insertions split the node in half
+  size_type count = node->count_;
+  size_type middle = count / 2UL;
+  if (insert_index == count)
+    middle = count - 1UL;
+  else if (!insert_index)
+    middle = 0UL;
+  node_pointer sibling = create_node(node->is_leaf_, nullptr, 0UL);
+  if (!node->parent_) {
+    try {
+      root_ = create_node(false, nullptr, 0UL);
+    } catch (...) {
+      delete_node(sibling);
+      throw;
+    }
+    set_child(root_, 0UL, node);
+  }
+  for (size_type i = middle + 1UL; i < count; ++i)
+    transfer(sibling->value(i - middle - 1UL), node->value(i));
+  if (!node->is_leaf_) {
+    for (size_type i = middle + 1UL; i <= count; ++i)
+      set_child(sibling, i - middle - 1UL, child(node, i));
+  }
+  sibling->count_ = static_cast<std::uint16_t>(count - middle - 1UL);
+
+  // the median goes up to the parent and the sibling follows the node
+  node_pointer parent = node->parent_;
+  size_type position = node->position_;
+  shift_values_right(parent, position);
+  transfer(parent->value(position), node->value(middle));
+  shift_children_right(parent, position + 1UL);
+  set_child(parent, position + 1UL, sibling);
+  ++parent->count_;
+  node->count_ = static_cast<std::uint16_t>(middle);
+  if (node == rightmost_)
+    rightmost_ = sibling;
+  return sibling;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::erase(const_iterator pos) {
+  node_pointer node = pos.node_;
+  size_type index = pos.position_;
+  bool is_internal = !node->is_leaf_;
+  node->value(index)->~value_type();
+  if (is_internal) {
+    // the previous value is always in a leaf, it takes the erased place
+    node_pointer leaf = child(node, index);
+    while (!leaf->is_leaf_)
+      leaf = child(leaf, leaf->count_);
+    transfer(node->value(index), leaf->value(leaf->count_ - 1U));
+    --leaf->count_;
+    node = leaf;
+    index = leaf->count_;
+  } else {
+    shift_values_left(node, index);
+    --node->count_;
+  }
+  --size_;
+
+  // the position is followed through the rebalancing, then the position past
+  // the last value of a node is resolved to the next value
+  iterator next(node, index);
+  rebalance(node, next);
+  if (!root_)
+    return end_position();
+  while (next.position_ == next.node_->count_ && next.node_->parent_) {
+    next.position_ = next.node_->position_;
+    next.node_ = next.node_->parent_;
+  }
+  if (next.position_ == next.node_->count_)
+    return end_position();
+  // the moved previous value is skipped
+  if (is_internal)
+    ++next;
+  return next;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::erase(const_iterator first, const_iterator last) {
+  if (first == begin() && last == end()) {
+    clear();
+    return end();
+  }
+  // every erasure invalidates the iterators, so only the length is kept
+  auto count = std::distance(first, last);
+  iterator result(first.node_, first.position_);
+  while (count--)
+    result = erase(result);
+  return result;
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::erase_key(const Lookup &key) {
+  auto range = equal_range(key);
+  auto count = static_cast<size_type>(std::distance(range.first, range.second));
+  erase(range.first, range.second);
+  return count;
+}
+
+template <class K, class T, class S, class C>
+template <class Predicate>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::erase_if(Predicate pred) {
+  size_type old_size = size_;
+  for (iterator i = begin(); i != end();) {
+    if (pred(static_cast<const_reference>(*i)))
+      i = erase(i);
+    else
+      ++i;
+  }
+  return old_size - size_;
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::rebalance(node_pointer node, iterator &tracked) {
+  // small nodes are merged with a sibling if both fit into one node,
+  // otherwise one value moves over from the bigger sibling through the parent
+  while (node != root_ && node->count_ < kMinValues) {
+    node_pointer parent = node->parent_;
+    size_type index = node->position_;
+    node_pointer left = index ? child(parent, index - 1UL) : nullptr;
+    node_pointer right =
+        index < parent->count_ ? child(parent, index + 1UL) : nullptr;
+    if (left && left->count_ + node->count_ < kMaxValues) {
+      if (tracked.node_ == node)
+        tracked = iterator(left, tracked.position_ + left->count_ + 1UL);
+      merge_children(parent, index - 1UL);
+    } else if (right && node->count_ + right->count_ < kMaxValues) {
+      merge_children(parent, index);
+    } else if (left) {
+      if (tracked.node_ == node)
+        ++tracked.position_;
+      borrow_from_left(parent, index);
+      break;
+    } else {
+      borrow_from_right(parent, index);
+      break;
+    }
+    node = parent;
+  }
+  if (root_->count_)
+    return;
+  node_pointer old_root = root_;
+  if (root_->is_leaf_) {
+    root_ = leftmost_ = rightmost_ = nullptr;
+    tracked = iterator(nullptr, 0UL);
+  } else {
+    // the root without values is replaced by its only child
+    root_ = child(old_root, 0UL);
+    root_->parent_ = nullptr;
+    root_->position_ = 0U;
+  }
+  delete_node(old_root);
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::merge_children(node_pointer parent, size_type index) {
+  // the right child and the separator between the children join the left one
+  node_pointer left = child(parent, index);
+  node_pointer right = child(parent, index + 1UL);
+  size_type count = left->count_;
+  transfer(left->value(count), parent->value(index));
+  for (size_type i = 0UL; i < right->count_; ++i)
+    transfer(left->value(count + 1UL + i), right->value(i));
+  if (!left->is_leaf_) {
+    for (size_type i = 0UL; i <= right->count_; ++i)
+      set_child(left, count + 1UL + i, child(right, i));
+  }
+  left->count_ = static_cast<std::uint16_t>(count + right->count_ + 1UL);
+  shift_values_left(parent, index);
+  shift_children_left(parent, index + 1UL);
+  --parent->count_;
+  if (right == rightmost_)
+    rightmost_ = left;
+  delete_node(right);
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::borrow_from_left(node_pointer parent,
+                                           size_type index) {
+  node_pointer node = child(parent, index);
+  node_pointer left = child(parent, index - 1UL);
+  shift_values_right(node, 0UL);
+  if (!node->is_leaf_)
+    shift_children_right(node, 0UL);
+  transfer(node->value(0UL), parent->value(index - 1UL));
+  transfer(parent->value(index - 1UL), left->value(left->count_ - 1U));
+  if (!node->is_leaf_)
+    set_child(node, 0UL, child(left, left->count_));
+  --left->count_;
+  ++node->count_;
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::borrow_from_right(node_pointer parent,
+                                            size_type index) {
+  node_pointer node = child(parent, index);
+  node_pointer right = child(parent, index + 1UL);
+  transfer(node->value(node->count_), parent->value(index));
+  transfer(parent->value(index), right->value(0UL));
+  if (!node->is_leaf_)
+    set_child(node, node->count_ + 1UL, child(right, 0UL));
+  shift_values_left(right, 0UL);
+  if (!right->is_leaf_)
+    shift_children_left(right, 0UL);
+  ++node->count_;
+  --right->count_;
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::find(const Lookup &key) {
+  iterator position = lower_bound_position(key);
+  if (position != end_position() &&
+      !key_compare()(key, position.node_->key(position.position_)))
+    return position;
+  return end_position();
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::const_iterator
+BTree__<K, T, S, C>::find(const Lookup &key) const {
+  return const_cast<BTree__ *>(this)->find(key);
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+bool BTree__<K, T, S, C>::contains(const Lookup &key) const {
+  return find(key) != end();
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::count(const Lookup &key) const {
+  auto range = equal_range(key);
+  return static_cast<size_type>(std::distance(range.first, range.second));
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::lower_bound(const Lookup &key) {
+  return lower_bound_position(key);
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::const_iterator
+BTree__<K, T, S, C>::lower_bound(const Lookup &key) const {
+  return lower_bound_position(key);
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::upper_bound(const Lookup &key) {
+  return upper_bound_position(key);
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::const_iterator
+BTree__<K, T, S, C>::upper_bound(const Lookup &key) const {
+  return upper_bound_position(key);
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+std::pair<typename BTree__<K, T, S, C>::iterator,
+          typename BTree__<K, T, S, C>::iterator>
+BTree__<K, T, S, C>::equal_range(const Lookup &key) {
+  return std::pair<iterator, iterator>{lower_bound_position(key),
+                                       upper_bound_position(key)};
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+std::pair<typename BTree__<K, T, S, C>::const_iterator,
+          typename BTree__<K, T, S, C>::const_iterator>
+BTree__<K, T, S, C>::equal_range(const Lookup &key) const {
+  return std::pair<const_iterator, const_iterator>{lower_bound_position(key),
+                                                   upper_bound_position(key)};
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::lower_bound_position(const Lookup &key) const {
+  // every next candidate lies in the left subtree of the previous one
+  iterator result = end_position();
+  for (node_pointer node = root_; node;) {
+    size_type index = lower_index(node, key);
+    if (index < node->count_)
+      result = iterator(node, index);
+    node = node->is_leaf_ ? nullptr : child(node, index);
+  }
+  return result;
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::iterator
+BTree__<K, T, S, C>::upper_bound_position(const Lookup &key) const {
+  iterator result = end_position();
+  for (node_pointer node = root_; node;) {
+    size_type index = upper_index(node, key);
+    if (index < node->count_)
+      result = iterator(node, index);
+    node = node->is_leaf_ ? nullptr : child(node, index);
+  }
+  return result;
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::lower_index(const Node *node, const Lookup &key) const {
+  // binary search of the first value that is not less than the key
+  size_type low = 0UL;
+  size_type high = node->count_;
+  while (low < high) {
+    size_type middle = (low + high) / 2UL;
+    if (key_compare()(node->key(middle), key))
+      low = middle + 1UL;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+template <class K, class T, class S, class C>
+template <class Lookup>
+typename BTree__<K, T, S, C>::size_type
+BTree__<K, T, S, C>::upper_index(const Node *node, const Lookup &key) const {
+  // binary search of the first value that is greater than the key
+  size_type low = 0UL;
+  size_type high = node->count_;
+  while (low < high) {
+    size_type middle = (low + high) / 2UL;
+    if (key_compare()(key, node->key(middle)))
+      high = middle;
+    else
+      low = middle + 1UL;
+  }
+  return low;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::node_pointer
+BTree__<K, T, S, C>::create_node(bool is_leaf, node_pointer parent,
+                                 size_type position) {
+  node_pointer node =
+      is_leaf ? new Node : static_cast<node_pointer>(new InternalNode);
+  node->parent_ = parent;
+  node->position_ = static_cast<std::uint16_t>(position);
+  node->count_ = 0U;
+  node->is_leaf_ = is_leaf;
+  return node;
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::delete_node(node_pointer node) noexcept {
+  if (node->is_leaf_)
+    delete node;
+  else
+    delete static_cast<InternalNode *>(node);
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::free_subtree(node_pointer node) noexcept {
+  // recursion depth is the height of the tree, that is tiny
+  if (!node)
+    return;
+  if (!node->is_leaf_) {
+    for (size_type i = 0UL; i <= node->count_; ++i)
+      free_subtree(child(node, i));
+  }
+  if constexpr (!std::is_trivially_destructible<value_type>::value) {
+    for (size_type i = 0UL; i < node->count_; ++i)
+      node->value(i)->~value_type();
+  }
+  delete_node(node);
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::transfer(pointer to, pointer from) noexcept {
+  new (to) mutable_value_type(std::move(*as_mutable(from)));
+  as_mutable(from)->~mutable_value_type();
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::shift_values_right(node_pointer node,
+                                             size_type index) noexcept {
+  // values from the index move one slot right, the slot at index gets free
+  for (size_type i = node->count_; i > index; --i)
+    transfer(node->value(i), node->value(i - 1UL));
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::shift_values_left(node_pointer node,
+                                            size_type index) noexcept {
+  // the free slot at index is filled by the values after it
+  for (size_type i = index; i + 1UL < node->count_; ++i)
+    transfer(node->value(i), node->value(i + 1UL));
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::shift_children_right(node_pointer node,
+                                               size_type index) noexcept {
+  for (size_type i = node->count_ + 1UL; i > index; --i)
+    set_child(node, i, child(node, i - 1UL));
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::shift_children_left(node_pointer node,
+                                              size_type index) noexcept {
+  for (size_type i = index; i < node->count_; ++i)
+    set_child(node, i, child(node, i + 1UL));
+}
+
+template <class K, class T, class S, class C>
+void BTree__<K, T, S, C>::set_child(node_pointer node, size_type index,
+                                    node_pointer child_node) noexcept {
+  child(node, index) = child_node;
+  child_node->parent_ = node;
+  child_node->position_ = static_cast<std::uint16_t>(index);
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::BTreeIterator__ &
+BTree__<K, T, S, C>::iterator::operator++() {
+  if (!node_->is_leaf_) {
+    // the next value is the first one in the right subtree
+    node_ = child(node_, position_ + 1UL);
+    while (!node_->is_leaf_)
+      node_ = child(node_, 0UL);
+    position_ = 0UL;
+    return *this;
+  }
+  if (++position_ < node_->count_)
+    return *this;
+  // after the last value of the leaf comes the closest ancestor that has the
+  // leaf in its left subtree, past the last value the iterator stays at end
+  node_pointer node = node_;
+  size_type position = position_;
+  while (position == node->count_ && node->parent_) {
+    position = node->position_;
+    node = node->parent_;
+  }
+  if (position < node->count_) {
+    node_ = node;
+    position_ = position;
+  }
+  return *this;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::BTreeIterator__
+BTree__<K, T, S, C>::iterator::operator++(int) {
+  iterator tmp(*this);
+  ++(*this);
+  return tmp;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::BTreeIterator__ &
+BTree__<K, T, S, C>::iterator::operator--() {
+  if (!node_->is_leaf_) {
+    // the previous value is the last one in the left subtree
+    node_ = child(node_, position_);
+    while (!node_->is_leaf_)
+      node_ = child(node_, node_->count_);
+    position_ = node_->count_ - 1UL;
+    return *this;
+  }
+  while (!position_ && node_->parent_) {
+    position_ = node_->position_;
+    node_ = node_->parent_;
+  }
+  --position_;
+  return *this;
+}
+
+template <class K, class T, class S, class C>
+typename BTree__<K, T, S, C>::BTreeIterator__
+BTree__<K, T, S, C>::iterator::operator--(int) {
+  iterator tmp(*this);
+  --(*this);
+  return tmp;
+}
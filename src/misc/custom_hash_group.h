@@ -0,0 +1,205 @@
+#ifndef _MISC_CUSTOM_HASH_GROUP_H_
+#define _MISC_CUSTOM_HASH_GROUP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// The widest instruction set enabled for the build is used for the probing,
+// defining CUSTOM_HASH_NO_SIMD forces the portable implementation
+#if !defined(CUSTOM_HASH_NO_SIMD) && defined(__AVX2__)
+#define CUSTOM_HASH_GROUP_AVX2
+#include <immintrin.h>
+#elif !defined(CUSTOM_HASH_NO_SIMD) && defined(__SSE2__)
+#define CUSTOM_HASH_GROUP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace custom {
+
+// Every slot of the hash table has a control byte: the special ones have the
+// high bit set, full slots keep the 7 low bits of the hash of their key
+using ControlByte__ = std::int8_t;
+
+struct ControlBytes__ {
+  constexpr static ControlByte__ kEmpty = -128;
+  constexpr static ControlByte__ kDeleted = -2;
+  // terminates the control bytes, so the iteration stops without the bounds
+  constexpr static ControlByte__ kSentinel = -1;
+
+  static bool is_full(ControlByte__ control) { return control >= 0; }
+  static bool is_empty_or_deleted(ControlByte__ control) {
+    return control < kSentinel;
+  }
+};
+
+inline unsigned CountTrailingZeros__(std::uint64_t bits) {
+  return static_cast<unsigned>(__builtin_ctzll(bits));
+}
+
+inline unsigned CountLeadingZeros__(std::uint64_t bits) {
+  return static_cast<unsigned>(__builtin_clzll(bits));
+}
+
+/**
+ * @brief Set of the slots of one group that matched a probe. The slot i is
+ * kept as the bit (i << Shift), so the SIMD masks have a bit per slot and
+ * the portable one has a byte per slot
+ *
+ * @tparam Width amount of the slots in the group
+ * @tparam Shift log2 of the bits per slot
+ */
+template <unsigned Width, unsigned Shift> class GroupMask__ {
+public:
+  explicit GroupMask__(std::uint64_t bits) : bits_(bits) {}
+
+  explicit operator bool() const { return bits_ != 0UL; }
+
+  // index of the first matched slot, the mask must not be empty
+  unsigned lowest() const { return CountTrailingZeros__(bits_) >> Shift; }
+
+  // amount of the unmatched slots at the end of the group
+  unsigned leading_zeros() const {
+    return (CountLeadingZeros__(bits_) - (64U - (Width << Shift))) >> Shift;
+  }
+
+  void clear_lowest() { bits_ &= bits_ - 1UL; }
+
+private:
+  std::uint64_t bits_;
+};
+
+#if defined(CUSTOM_HASH_GROUP_AVX2)
+
+// 32 control bytes compared at once by the AVX2 instructions
+class ControlGroup__ {
+public:
+  constexpr static std::size_t kWidth = 32UL;
+  using mask_type = GroupMask__<32U, 0U>;
+
+  explicit ControlGroup__(const ControlByte__ *control)
+      : control_(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(control))) {}
+
+  mask_type match(ControlByte__ hash) const {
+    return to_mask(_mm256_cmpeq_epi8(_mm256_set1_epi8(hash), control_));
+  }
+
+  mask_type match_empty() const { return match(ControlBytes__::kEmpty); }
+
+  mask_type match_empty_or_deleted() const {
+    return to_mask(_mm256_cmpgt_epi8(
+        _mm256_set1_epi8(ControlBytes__::kSentinel), control_));
+  }
+
+  // amount of the empty and deleted slots before the first full or sentinel
+  unsigned count_leading_empty_or_deleted() const {
+    auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(ControlBytes__::kSentinel),
+                          control_)));
+    return CountTrailingZeros__(~static_cast<std::uint64_t>(bits));
+  }
+
+private:
+  __m256i control_;
+
+  static mask_type to_mask(__m256i matched) {
+    return mask_type(
+        static_cast<std::uint32_t>(_mm256_movemask_epi8(matched)));
+  }
+};
+
+#elif defined(CUSTOM_HASH_GROUP_SSE2)
+
+// 16 control bytes compared at once by the SSE2 instructions
+class ControlGroup__ {
+public:
+  constexpr static std::size_t kWidth = 16UL;
+  using mask_type = GroupMask__<16U, 0U>;
+
+  explicit ControlGroup__(const ControlByte__ *control)
+      : control_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control))) {}
+
+  mask_type match(ControlByte__ hash) const {
+    return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(hash), control_));
+  }
+
+  mask_type match_empty() const { return match(ControlBytes__::kEmpty); }
+
+  mask_type match_empty_or_deleted() const {
+    return to_mask(
+        _mm_cmpgt_epi8(_mm_set1_epi8(ControlBytes__::kSentinel), control_));
+  }
+
+  // amount of the empty and deleted slots before the first full or sentinel
+  unsigned count_leading_empty_or_deleted() const {
+    auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(ControlBytes__::kSentinel), control_)));
+    return CountTrailingZeros__(~static_cast<std::uint64_t>(bits));
+  }
+
+private:
+  __m128i control_;
+
+  static mask_type to_mask(__m128i matched) {
+    return mask_type(static_cast<std::uint32_t>(_mm_movemask_epi8(matched)));
+  }
+};
+
+#else
+
+// 8 control bytes compared at once as one 64-bit word, the bytes of the
+// matched slots get their high bit set
+class ControlGroup__ {
+public:
+  constexpr static std::size_t kWidth = 8UL;
+  using mask_type = GroupMask__<8U, 3U>;
+
+  explicit ControlGroup__(const ControlByte__ *control) : control_(0UL) {
+    // little-endian load on every platform, compilers fold it into one move
+    for (std::size_t i = 0; i < kWidth; ++i)
+      control_ |= static_cast<std::uint64_t>(
+                      static_cast<std::uint8_t>(control[i]))
+                  << (i * 8UL);
+  }
+
+  // Can report a full slot right after the matched one by mistake, that is
+  // harmless as the keys of the matched slots are compared anyway
+  mask_type match(ControlByte__ hash) const {
+    std::uint64_t bytes =
+        control_ ^ (kLowBits * static_cast<std::uint8_t>(hash));
+    return mask_type((bytes - kLowBits) & ~bytes & kHighBits);
+  }
+
+  // only the empty byte has the high bit set and the second bit cleared
+  mask_type match_empty() const {
+    return mask_type(control_ & ~(control_ << 6) & kHighBits);
+  }
+
+  // the empty and deleted bytes have the high bit set and the low bit cleared
+  mask_type match_empty_or_deleted() const {
+    return mask_type(empty_or_deleted_bits());
+  }
+
+  // amount of the empty and deleted slots before the first full or sentinel
+  unsigned count_leading_empty_or_deleted() const {
+    std::uint64_t others = ~empty_or_deleted_bits() & kHighBits;
+    return others ? CountTrailingZeros__(others) >> 3U
+                  : static_cast<unsigned>(kWidth);
+  }
+
+private:
+  constexpr static std::uint64_t kLowBits = 0x0101010101010101UL;
+  constexpr static std::uint64_t kHighBits = 0x8080808080808080UL;
+
+  std::uint64_t control_;
+
+  std::uint64_t empty_or_deleted_bits() const {
+    return control_ & ~(control_ << 7) & kHighBits;
+  }
+};
+
+#endif
+
+} // namespace custom
+
+#endif // _MISC_CUSTOM_HASH_GROUP_H_
@@ -0,0 +1,215 @@
+#ifndef _MISC_CUSTOM_HASH_TABLE_H_
+#define _MISC_CUSTOM_HASH_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "custom_hash_group.h"
+#include "custom_tree_traits.h"
+
+namespace custom {
+
+/**
+ * @brief Open addressing hash table laid out like the Swiss table. The values
+ * are kept right in one array of slots and every slot has a control byte in
+ * the separate array. A lookup compares 7 bits of the hash with the whole
+ * group of control bytes at once and touches the slots only for the matches,
+ * so most of the misses never read a key. Erased slots become tombstones,
+ * iterators are invalidated only by the growth of the table
+ *
+ * @tparam Key type of the keys
+ * @tparam T type of the stored values
+ * @tparam Select takes the key from the value
+ * @tparam Hash hashes the keys
+ * @tparam KeyEqual compares the keys
+ */
+template <class Key, class T, class Select = TypeOfValue__<Key>,
+          class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class HashTable__ {
+public:
+  using key_type = Key;
+  using key_identify = Select;
+  using value_type = T;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using double_reference = value_type &&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // slots are placed at the start of the block returned by operator new
+  static_assert(alignof(value_type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "over-aligned values aren't supported");
+
+  class HashTableIterator__ {
+  public:
+    template <class, class, class, class, class> friend class HashTable__;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    HashTableIterator__(const ControlByte__ *control, pointer slot)
+        : control_(control), slot_(slot) {}
+
+    HashTableIterator__ &operator++() {
+      ++control_;
+      ++slot_;
+      skip_empty_or_deleted();
+      return *this;
+    }
+
+    HashTableIterator__ operator++(int) {
+      HashTableIterator__ copy(*this);
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const HashTableIterator__ &other) const {
+      return control_ == other.control_;
+    }
+
+    bool operator!=(const HashTableIterator__ &other) const {
+      return !(*this == other);
+    }
+
+    reference operator*() { return *slot_; }
+
+  protected:
+    const ControlByte__ *control_;
+    pointer slot_;
+
+    // jumps over the whole group of free slots, the sentinel stops the walk
+    void skip_empty_or_deleted() {
+      while (ControlBytes__::is_empty_or_deleted(*control_)) {
+        unsigned shift =
+            ControlGroup__(control_).count_leading_empty_or_deleted();
+        control_ += shift;
+        slot_ += shift;
+      }
+    }
+  };
+
+  using iterator = HashTableIterator__;
+
+  class HashTableConstIterator__ : public iterator {
+  public:
+    using iterator_category = typename iterator::iterator_category;
+    using difference_type = typename iterator::difference_type;
+    using pointer = const_pointer;
+    using reference = const_reference;
+
+    HashTableConstIterator__(const ControlByte__ *control,
+                             typename iterator::pointer slot)
+        : iterator(control, slot) {}
+
+    // implicit just like the conversion of the standard iterators
+    HashTableConstIterator__(const iterator &iter) : iterator(iter) {}
+
+    const_reference operator*() const { return *this->slot_; }
+  };
+
+  using const_iterator = HashTableConstIterator__;
+
+  HashTable__() noexcept;
+  ~HashTable__();
+  HashTable__(const HashTable__ &other);
+  HashTable__(HashTable__ &&other) noexcept;
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  HashTable__(InputIt first, InputIt last);
+
+  HashTable__ &operator=(const HashTable__ &other);
+  HashTable__ &operator=(HashTable__ &&other) noexcept;
+
+  iterator begin();
+  const_iterator begin() const;
+  iterator end();
+  const_iterator end() const;
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  // Amount of the slots, the table grows when 7/8 of them are taken
+  size_type capacity() const { return capacity_; }
+  float load_factor() const;
+  // Bytes taken by the slots and control bytes
+  size_type memory_usage() const;
+
+  void clear();
+  void reserve(size_type count);
+  void swap(HashTable__ &other) noexcept;
+  void merge(HashTable__ &other);
+
+  std::pair<iterator, bool> insert(const_reference value);
+  std::pair<iterator, bool> insert(double_reference value);
+  template <class InputIt, class = RequireInputIterator__<InputIt>>
+  size_type insert(InputIt first, InputIt last);
+  template <class... Args> std::pair<iterator, bool> emplace(Args &&...args);
+  template <class Lookup, class... Args>
+  std::pair<iterator, bool> try_emplace(const Lookup &key, Args &&...args);
+
+  void erase(const_iterator pos);
+  template <class Lookup> size_type erase_key(const Lookup &key);
+  template <class Predicate> size_type erase_if(Predicate pred);
+
+  template <class Lookup> iterator find(const Lookup &key);
+  template <class Lookup> const_iterator find(const Lookup &key) const;
+  template <class Lookup> bool contains(const Lookup &key) const;
+  template <class Lookup> size_type count(const Lookup &key) const;
+
+private:
+  constexpr static size_type kWidth = ControlGroup__::kWidth;
+  // capacities are always 2^n - 1, so the probe wraps with a mask
+  constexpr static size_type kMinCapacity = kWidth - 1UL;
+
+  pointer slots_;
+  // capacity_ + kWidth bytes: the bytes of the slots, the sentinel and the
+  // copies of the first kWidth - 1 bytes, so a group can be loaded at any slot
+  ControlByte__ *control_;
+  size_type capacity_;
+  size_type size_;
+  // insertions into the empty slots left before the table has to grow
+  size_type growth_left_;
+
+  template <class Lookup> static size_type hash_of(const Lookup &key);
+  static size_type probe_start(size_type hash) { return hash >> 7U; }
+  static ControlByte__ control_of(size_type hash) {
+    return static_cast<ControlByte__>(hash & 0x7FUL);
+  }
+  static size_type growth_of(size_type capacity);
+  static size_type capacity_for(size_type count);
+
+  iterator iterator_at(size_type index) const;
+  iterator begin_position() const;
+  template <class Lookup>
+  size_type find_index(const Lookup &key, size_type hash) const;
+  size_type find_first_non_full(size_type hash) const;
+  // Slot for the new value with given hash, grows the table if needed
+  size_type prepare_insert(size_type hash);
+  template <class... Args>
+  iterator emplace_at(size_type index, size_type hash, Args &&...args);
+  template <class Value> std::pair<iterator, bool> insert_value(Value &&value);
+  void erase_at(size_type index);
+  void set_control(size_type index, ControlByte__ control);
+  void grow();
+  void resize(size_type new_capacity);
+  void destroy_values() noexcept;
+};
+
+#include "custom_hash_table.tpp"
+
+} // namespace custom
+
+#endif // _MISC_CUSTOM_HASH_TABLE_H_
@@ -0,0 +1,443 @@
+template <class K, class T, class S, class H, class E>
+HashTable__<K, T, S, H, E>::HashTable__() noexcept
+    : slots_(nullptr), control_(nullptr), capacity_(0UL), size_(0UL),
+      growth_left_(0UL) {}
+
+template <class K, class T, class S, class H, class E>
+HashTable__<K, T, S, H, E>::~HashTable__() {
+  destroy_values();
+  ::operator delete(slots_);
+}
+
+template <class K, class T, class S, class H, class E>
+HashTable__<K, T, S, H, E>::HashTable__(const HashTable__ &other)
+    : HashTable__() {
+  reserve(other.size_);
+  // keys of the other table are unique, so no lookup is needed
+  for (const_reference value : other) {
+    size_type hash = hash_of(key_identify()(value));
+    emplace_at(prepare_insert(hash), hash, value);
+  }
+}
+
+template <class K, class T, class S, class H, class E>
+HashTable__<K, T, S, H, E>::HashTable__(HashTable__ &&other) noexcept
+    : HashTable__() {
+  swap(other);
+}
+
+template <class K, class T, class S, class H, class E>
+template <class InputIt, class>
+HashTable__<K, T, S, H, E>::HashTable__(InputIt first, InputIt last)
+    : HashTable__() {
+  insert(first, last);
+}
+
+template <class K, class T, class S, class H, class E>
+HashTable__<K, T, S, H, E> &
+HashTable__<K, T, S, H, E>::operator=(const HashTable__ &other) {
+  if (this != &other) {
+    HashTable__ copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <class K, class T, class S, class H, class E>
+HashTable__<K, T, S, H, E> &
+HashTable__<K, T, S, H, E>::operator=(HashTable__ &&other) noexcept {
+  if (this != &other) {
+    HashTable__ released(std::move(*this));
+    swap(other);
+  }
+  return *this;
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::iterator
+HashTable__<K, T, S, H, E>::begin() {
+  return begin_position();
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::const_iterator
+HashTable__<K, T, S, H, E>::begin() const {
+  return begin_position();
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::iterator
+HashTable__<K, T, S, H, E>::end() {
+  return iterator_at(capacity_);
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::const_iterator
+HashTable__<K, T, S, H, E>::end() const {
+  return iterator_at(capacity_);
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::iterator
+HashTable__<K, T, S, H, E>::iterator_at(size_type index) const {
+  // past-end position is the sentinel, the empty table has no slots at all
+  return iterator(control_ + index, slots_ + index);
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::iterator
+HashTable__<K, T, S, H, E>::begin_position() const {
+  if (!size_)
+    return iterator_at(capacity_);
+  iterator first = iterator_at(0UL);
+  first.skip_empty_or_deleted();
+  return first;
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::max_size() const {
+  return std::numeric_limits<difference_type>().max() /
+         (sizeof(value_type) + 1UL);
+}
+
+template <class K, class T, class S, class H, class E>
+float HashTable__<K, T, S, H, E>::load_factor() const {
+  return capacity_ ? static_cast<float>(size_) / static_cast<float>(capacity_)
+                   : 0.0F;
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::memory_usage() const {
+  return capacity_ ? capacity_ * (sizeof(value_type) + 1UL) + kWidth : 0UL;
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::clear() {
+  destroy_values();
+  size_ = 0UL;
+  // the slots are kept for the next insertions just like in the vector
+  if (capacity_) {
+    std::memset(control_, ControlBytes__::kEmpty, capacity_ + kWidth);
+    control_[capacity_] = ControlBytes__::kSentinel;
+  }
+  growth_left_ = growth_of(capacity_);
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::reserve(size_type count) {
+  if (count > growth_of(capacity_))
+    resize(capacity_for(count));
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::swap(HashTable__ &other) noexcept {
+  std::swap(slots_, other.slots_);
+  std::swap(control_, other.control_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::merge(HashTable__ &other) {
+  if (this == &other)
+    return;
+  // erasure leaves the other slots in place, so the walk goes on
+  for (size_type i = 0; i < other.capacity_; ++i) {
+    if (!ControlBytes__::is_full(other.control_[i]))
+      continue;
+    const key_type &key = key_identify()(other.slots_[i]);
+    size_type hash = hash_of(key);
+    if (find_index(key, hash) == capacity_) {
+      emplace_at(prepare_insert(hash), hash, std::move(other.slots_[i]));
+      other.erase_at(i);
+    }
+  }
+}
+
+template <class K, class T, class S, class H, class E>
+std::pair<typename HashTable__<K, T, S, H, E>::iterator, bool>
+HashTable__<K, T, S, H, E>::insert(const_reference value) {
+  return insert_value(value);
+}
+
+template <class K, class T, class S, class H, class E>
+std::pair<typename HashTable__<K, T, S, H, E>::iterator, bool>
+HashTable__<K, T, S, H, E>::insert(double_reference value) {
+  return insert_value(std::move(value));
+}
+
+template <class K, class T, class S, class H, class E>
+template <class InputIt, class>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::insert(InputIt first, InputIt last) {
+  size_type inserted = 0UL;
+  for (; first != last; ++first)
+    inserted += insert_value(*first).second;
+  return inserted;
+}
+
+template <class K, class T, class S, class H, class E>
+template <class... Args>
+std::pair<typename HashTable__<K, T, S, H, E>::iterator, bool>
+HashTable__<K, T, S, H, E>::emplace(Args &&...args) {
+  // the key is known only after the value is constructed
+  value_type value(std::forward<Args>(args)...);
+  return insert_value(std::move(value));
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup, class... Args>
+std::pair<typename HashTable__<K, T, S, H, E>::iterator, bool>
+HashTable__<K, T, S, H, E>::try_emplace(const Lookup &key, Args &&...args) {
+  size_type hash = hash_of(key);
+  size_type index = find_index(key, hash);
+  if (index != capacity_)
+    return {iterator_at(index), false};
+  return {emplace_at(prepare_insert(hash), hash, std::forward<Args>(args)...),
+          true};
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::erase(const_iterator pos) {
+  erase_at(static_cast<size_type>(pos.slot_ - slots_));
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::erase_key(const Lookup &key) {
+  size_type index = find_index(key, hash_of(key));
+  if (index == capacity_)
+    return 0UL;
+  erase_at(index);
+  return 1UL;
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Predicate>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::erase_if(Predicate pred) {
+  size_type removed = 0UL;
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (ControlBytes__::is_full(control_[i]) &&
+        pred(static_cast<const_reference>(slots_[i]))) {
+      erase_at(i);
+      ++removed;
+    }
+  }
+  return removed;
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+typename HashTable__<K, T, S, H, E>::iterator
+HashTable__<K, T, S, H, E>::find(const Lookup &key) {
+  return iterator_at(find_index(key, hash_of(key)));
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+typename HashTable__<K, T, S, H, E>::const_iterator
+HashTable__<K, T, S, H, E>::find(const Lookup &key) const {
+  return iterator_at(find_index(key, hash_of(key)));
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+bool HashTable__<K, T, S, H, E>::contains(const Lookup &key) const {
+  return find_index(key, hash_of(key)) != capacity_;
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::count(const Lookup &key) const {
+  return contains(key) ? 1UL : 0UL;
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::hash_of(const Lookup &key) {
+  // std::hash of the integers returns the number itself, the multiplication
+  // spreads its low bits over the high half that is folded back, so both the
+  // probe start and the control byte depend on the whole key
+  std::uint64_t hash = static_cast<std::uint64_t>(hasher()(key));
+  hash *= 0x9E3779B97F4A7C15UL;
+  return static_cast<size_type>(hash ^ (hash >> 32U));
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::growth_of(size_type capacity) {
+  // at least one slot stays empty, so every probe ends
+  return capacity ? capacity - std::max<size_type>(capacity / 8UL, 1UL) : 0UL;
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::capacity_for(size_type count) {
+  size_type capacity = kMinCapacity;
+  while (growth_of(capacity) < count)
+    capacity = capacity * 2UL + 1UL;
+  return capacity;
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Lookup>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::find_index(const Lookup &key,
+                                       size_type hash) const {
+  if (!capacity_)
+    return capacity_;
+  ControlByte__ control = control_of(hash);
+  size_type offset = probe_start(hash) & capacity_;
+  // the groups are visited with the triangular steps, which pass every group
+  // of the power of two sized table once
+  for (size_type step = kWidth;; step += kWidth) {
+    ControlGroup__ group(control_ + offset);
+    for (auto matched = group.match(control); matched;
+         matched.clear_lowest()) {
+      size_type index = (offset + matched.lowest()) & capacity_;
+      if (key_equal()(key_identify()(slots_[index]), key))
+        return index;
+    }
+    // the key would have been placed into the empty slot
+    if (group.match_empty())
+      return capacity_;
+    offset = (offset + step) & capacity_;
+  }
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::find_first_non_full(size_type hash) const {
+  size_type offset = probe_start(hash) & capacity_;
+  for (size_type step = kWidth;; step += kWidth) {
+    auto free = ControlGroup__(control_ + offset).match_empty_or_deleted();
+    if (free)
+      return (offset + free.lowest()) & capacity_;
+    offset = (offset + step) & capacity_;
+  }
+}
+
+template <class K, class T, class S, class H, class E>
+typename HashTable__<K, T, S, H, E>::size_type
+HashTable__<K, T, S, H, E>::prepare_insert(size_type hash) {
+  if (capacity_) {
+    size_type index = find_first_non_full(hash);
+    // reuse of the tombstone doesn't take an empty slot
+    if (growth_left_ || control_[index] == ControlBytes__::kDeleted)
+      return index;
+  }
+  grow();
+  return find_first_non_full(hash);
+}
+
+template <class K, class T, class S, class H, class E>
+template <class... Args>
+typename HashTable__<K, T, S, H, E>::iterator
+HashTable__<K, T, S, H, E>::emplace_at(size_type index, size_type hash,
+                                       Args &&...args) {
+  // the slot is marked only when the value is constructed without exception
+  new (slots_ + index) value_type(std::forward<Args>(args)...);
+  if (control_[index] == ControlBytes__::kEmpty)
+    --growth_left_;
+  set_control(index, control_of(hash));
+  ++size_;
+  return iterator_at(index);
+}
+
+template <class K, class T, class S, class H, class E>
+template <class Value>
+std::pair<typename HashTable__<K, T, S, H, E>::iterator, bool>
+HashTable__<K, T, S, H, E>::insert_value(Value &&value) {
+  const key_type &key = key_identify()(value);
+  size_type hash = hash_of(key);
+  size_type index = find_index(key, hash);
+  if (index != capacity_)
+    return {iterator_at(index), false};
+  return {emplace_at(prepare_insert(hash), hash, std::forward<Value>(value)),
+          true};
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::erase_at(size_type index) {
+  slots_[index].~value_type();
+  --size_;
+  // The slot can become empty again only if no probe ever passed it, that is
+  // when no window of kWidth slots around it was full. Otherwise it is left
+  // as the tombstone, so the probes for the keys behind it go on
+  size_type index_before = (index - kWidth) & capacity_;
+  auto empty_after = ControlGroup__(control_ + index).match_empty();
+  auto empty_before = ControlGroup__(control_ + index_before).match_empty();
+  bool is_never_full =
+      empty_before && empty_after &&
+      empty_after.lowest() + empty_before.leading_zeros() < kWidth;
+  if (is_never_full) {
+    set_control(index, ControlBytes__::kEmpty);
+    ++growth_left_;
+  } else {
+    set_control(index, ControlBytes__::kDeleted);
+  }
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::set_control(size_type index,
+                                             ControlByte__ control) {
+  control_[index] = control;
+  // the first kWidth - 1 bytes are copied after the sentinel, for the other
+  // bytes this writes the same byte again
+  control_[((index - (kWidth - 1UL)) & capacity_) + (kWidth - 1UL)] = control;
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::grow() {
+  if (!capacity_)
+    resize(kMinCapacity);
+  else if (size_ * 32UL <= capacity_ * 25UL)
+    // most of the taken slots are tombstones, rehashing drops them
+    resize(capacity_);
+  else
+    resize(capacity_ * 2UL + 1UL);
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::resize(size_type new_capacity) {
+  // slots and control bytes share one block, the slots go first for alignment
+  auto *block = static_cast<unsigned char *>(::operator new(
+      new_capacity * sizeof(value_type) + new_capacity + kWidth));
+  pointer old_slots = slots_;
+  ControlByte__ *old_control = control_;
+  size_type old_capacity = capacity_;
+  slots_ = reinterpret_cast<pointer>(block);
+  control_ = reinterpret_cast<ControlByte__ *>(
+      block + new_capacity * sizeof(value_type));
+  capacity_ = new_capacity;
+  std::memset(control_, ControlBytes__::kEmpty, capacity_ + kWidth);
+  control_[capacity_] = ControlBytes__::kSentinel;
+  growth_left_ = growth_of(capacity_) - size_;
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (ControlBytes__::is_full(old_control[i])) {
+      size_type hash = hash_of(key_identify()(old_slots[i]));
+      size_type index = find_first_non_full(hash);
+      new (slots_ + index) value_type(std::move(old_slots[i]));
+      old_slots[i].~value_type();
+      set_control(index, control_of(hash));
+    }
+  }
+  ::operator delete(old_slots);
+}
+
+template <class K, class T, class S, class H, class E>
+void HashTable__<K, T, S, H, E>::destroy_values() noexcept {
+  if (std::is_trivially_destructible<value_type>::value)
+    return;
+  for (size_type i = 0; i < capacity_; ++i) {
+    if (ControlBytes__::is_full(control_[i]))
+      slots_[i].~value_type();
+  }
+}
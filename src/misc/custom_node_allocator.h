@@ -0,0 +1,175 @@
+#ifndef _MISC_CUSTOM_NODE_ALLOCATOR_H_
+#define _MISC_CUSTOM_NODE_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace custom {
+
+/**
+ * @brief Default allocator of the tree nodes, every node is allocated and
+ * freed separately with operator new and operator delete
+ *
+ * @tparam Node type of the node to allocate
+ */
+template <class Node> class NodeAllocator__ {
+public:
+  using value_type = Node;
+  using pointer = value_type *;
+  using size_type = std::size_t;
+
+  // Nodes can't be freed all at once, every node needs its own destroy() call
+  constexpr static bool kReleasesAll = false;
+
+  template <class... Args> pointer create(Args &&...args) {
+    return new value_type(std::forward<Args>(args)...);
+  }
+
+  void destroy(pointer node) noexcept { delete node; }
+  void reserve(size_type) {}
+  void release() noexcept {}
+  void swap(NodeAllocator__ &) noexcept {}
+
+  // Nodes of any allocator can be relinked to any other tree
+  bool operator==(const NodeAllocator__ &) const noexcept { return true; }
+  bool operator!=(const NodeAllocator__ &) const noexcept { return false; }
+};
+
+/**
+ * @brief Per-container pool of the tree nodes. Nodes are placed in contiguous
+ * slabs and freed nodes are kept in the intrusive free list for reuse. All
+ * slabs are freed at once on release() or destruction of the pool
+ *
+ * @tparam Node type of the node to allocate
+ */
+template <class Node> class NodePool__ {
+public:
+  using value_type = Node;
+  using pointer = value_type *;
+  using size_type = std::size_t;
+
+  // All the memory can be freed without destroy() calls for every node
+  constexpr static bool kReleasesAll = true;
+
+  NodePool__() noexcept
+      : slabs_(nullptr), free_list_(nullptr), next_slot_(nullptr),
+        slab_end_(nullptr), slab_size_(kMinSlabSize) {}
+  ~NodePool__() { release(); }
+
+  NodePool__(const NodePool__ &other) = delete;
+  NodePool__ &operator=(const NodePool__ &other) = delete;
+  NodePool__(NodePool__ &&other) noexcept : NodePool__() { swap(other); }
+
+  NodePool__ &operator=(NodePool__ &&other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  template <class... Args> pointer create(Args &&...args) {
+    Slot *slot = take_slot();
+    try {
+      return new (slot->storage_) value_type(std::forward<Args>(args)...);
+    } catch (...) {
+      put_slot(slot);
+      throw;
+    }
+  }
+
+  void destroy(pointer node) noexcept {
+    node->~value_type();
+    put_slot(reinterpret_cast<Slot *>(node));
+  }
+
+  /**
+   * @brief Makes sure that next count nodes will be taken from one slab
+   *
+   * @param count amount of nodes
+   */
+  void reserve(size_type count) {
+    if (static_cast<size_type>(slab_end_ - next_slot_) < count)
+      add_slab(std::max(count, slab_size_));
+  }
+
+  /**
+   * @brief Frees all the slabs. Nodes that were created by the pool must be
+   * destroyed or not used anymore
+   *
+   */
+  void release() noexcept {
+    while (slabs_) {
+      Slot *next = slabs_->next_;
+      operator delete(slabs_);
+      slabs_ = next;
+    }
+    free_list_ = next_slot_ = slab_end_ = nullptr;
+    slab_size_ = kMinSlabSize;
+  }
+
+  void swap(NodePool__ &other) noexcept {
+    std::swap(slabs_, other.slabs_);
+    std::swap(free_list_, other.free_list_);
+    std::swap(next_slot_, other.next_slot_);
+    std::swap(slab_end_, other.slab_end_);
+    std::swap(slab_size_, other.slab_size_);
+  }
+
+  // Nodes can be relinked only between trees that share the same pool
+  bool operator==(const NodePool__ &other) const noexcept {
+    return this == &other;
+  }
+  bool operator!=(const NodePool__ &other) const noexcept {
+    return !(*this == other);
+  }
+
+private:
+  union Slot {
+    Slot *next_;
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+  };
+
+  static_assert(alignof(Slot) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "Over-aligned nodes are not supported by the pool");
+
+  // Slabs grow twice on every allocation up to the maximum size
+  constexpr static size_type kMinSlabSize = 16UL;
+  constexpr static size_type kMaxSlabSize = 4096UL;
+
+  // The first slot of every slab links it to the previous slab
+  Slot *slabs_;
+  Slot *free_list_;
+  Slot *next_slot_;
+  Slot *slab_end_;
+  size_type slab_size_;
+
+  Slot *take_slot() {
+    if (free_list_) {
+      Slot *slot = free_list_;
+      free_list_ = slot->next_;
+      return slot;
+    }
+    if (next_slot_ == slab_end_)
+      add_slab(slab_size_);
+    return next_slot_++;
+  }
+
+  void put_slot(Slot *slot) noexcept {
+    slot->next_ = free_list_;
+    free_list_ = slot;
+  }
+
+  void add_slab(size_type size) {
+    Slot *slab = static_cast<Slot *>(operator new((size + 1UL) * sizeof(Slot)));
+    slab->next_ = slabs_;
+    slabs_ = slab;
+    next_slot_ = slab + 1UL;
+    slab_end_ = next_slot_ + size;
+    if (slab_size_ < kMaxSlabSize)
+      slab_size_ *= 2UL;
+  }
+};
+
+} // namespace custom
+
+#endif // _MISC_CUSTOM_NODE_ALLOCATOR_H_
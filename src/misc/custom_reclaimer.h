@@ -0,0 +1,148 @@
+#ifndef _MISC_CUSTOM_RECLAIMER_H_
+#define _MISC_CUSTOM_RECLAIMER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace custom {
+
+/**
+ * @brief Background thread that frees memory detached from the containers.
+ * Tasks are run one by one in the order they were given. The thread is
+ * started by the first task and stopped at the end of the program after all
+ * the given tasks are done
+ *
+ */
+class Reclaimer__ {
+public:
+  Reclaimer__(const Reclaimer__ &other) = delete;
+  Reclaimer__ &operator=(const Reclaimer__ &other) = delete;
+
+  ~Reclaimer__() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopped_ = true;
+    }
+    has_task_.notify_one();
+    if (thread_.joinable())
+      thread_.join();
+  }
+
+  static Reclaimer__ &instance() {
+    static Reclaimer__ reclaimer;
+    return reclaimer;
+  }
+
+  /**
+   * @brief Gives the task to the background thread. If the task or the thread
+   * can't be created the task is run right away by the current thread
+   *
+   * @param task function that frees the memory, must not throw
+   */
+  template <class Function> void reclaim(Function &&task) noexcept {
+    using task_type = Task<std::decay_t<Function>>;
+    task_type *node =
+        new (std::nothrow) task_type(std::forward<Function>(task));
+    if (!node) {
+      task();
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable() && !is_stopped_) {
+      try {
+        thread_ = std::thread(&Reclaimer__::run, this);
+      } catch (...) {
+        // no more threads available, the task is done by the current one
+        lock.unlock();
+        complete(node);
+        return;
+      }
+    }
+    if (is_stopped_) {
+      lock.unlock();
+      complete(node);
+      return;
+    }
+    if (last_)
+      last_->next_ = node;
+    else
+      first_ = node;
+    last_ = node;
+    ++pending_;
+    lock.unlock();
+    has_task_.notify_one();
+  }
+
+  /**
+   * @brief Blocks until all the tasks given before the call are done
+   *
+   */
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    is_idle_.wait(lock, [this] { return pending_ == 0UL; });
+  }
+
+private:
+  struct TaskBase {
+    virtual ~TaskBase() = default;
+    virtual void run() noexcept = 0;
+    TaskBase *next_ = nullptr;
+  };
+
+  template <class Function> struct Task : TaskBase {
+    template <class Arg>
+    explicit Task(Arg &&function) : function_(std::forward<Arg>(function)) {}
+    void run() noexcept override { function_(); }
+    Function function_;
+  };
+
+  Reclaimer__() noexcept
+      : first_(nullptr), last_(nullptr), pending_(0UL), is_stopped_(false) {}
+
+  static void complete(TaskBase *task) noexcept {
+    task->run();
+    delete task;
+  }
+
+  void run() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      has_task_.wait(lock, [this] { return first_ || is_stopped_; });
+      if (!first_)
+        return;
+      // the whole queue is taken at once, so the lock is held only to detach
+      TaskBase *task = first_;
+      first_ = last_ = nullptr;
+      lock.unlock();
+      std::size_t count = 0UL;
+      while (task) {
+        TaskBase *next = task->next_;
+        complete(task);
+        task = next;
+        ++count;
+      }
+      lock.lock();
+      pending_ -= count;
+      if (!pending_)
+        is_idle_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable has_task_;
+  std::condition_variable is_idle_;
+  TaskBase *first_;
+  TaskBase *last_;
+  std::size_t pending_;
+  bool is_stopped_;
+  std::thread thread_;
+};
+
+} // namespace custom
+
+#endif // _MISC_CUSTOM_RECLAIMER_H_
@@ -0,0 +1,34 @@
+#ifndef _MISC_CUSTOM_TREE_TRAITS_H_
+#define _MISC_CUSTOM_TREE_TRAITS_H_
+
+#include <iterator>
+#include <type_traits>
+
+namespace custom {
+
+// For set and map functions return values compatibility
+template <class T> struct TypeOfValue__ {
+  const T &operator()(const T &t__) const { return t__; }
+};
+
+// Specialization of tree iterator for first std::pair argument
+template <class Pair> struct PairFirstElement__ {
+  const typename Pair::first_type &operator()(const Pair &p) const {
+    return p.first;
+  }
+};
+
+// Enables range overloads only for types that can be used as input iterators
+template <class InputIt>
+using RequireInputIterator__ = std::enable_if_t<std::is_convertible<
+    typename std::iterator_traits<InputIt>::iterator_category,
+    std::input_iterator_tag>::value>;
+
+// Enables heterogeneous lookup overloads only for transparent comparators such
+// as std::less<>, that compare the keys with values of other types directly
+template <class Compare>
+using RequireTransparent__ = typename Compare::is_transparent;
+
+} // namespace custom
+
+#endif // _MISC_CUSTOM_TREE_TRAITS_H_
@@ -6,6 +6,9 @@
 #include <initializer_list>
 #include <limits>
 #include <stdexcept>
+#include <utility>
+
+#include "../../misc/custom_reclaimer.h"
 
 namespace custom {
 
@@ -17,14 +20,16 @@ public:
   using const_pointer = const value_type *;
   using reference = value_type &;
   using const_reference = const value_type &;
+  using double_reference = value_type &&;
 
 private:
   class Node {
   public:
     Node() = delete;
-    Node(const value_type &data = value_type(), Node *next = nullptr,
-         Node *prev = nullptr)
-        : data_{data}, next_{next}, prev_{prev} {}
+    // the element is constructed right inside the node from any arguments
+    template <class... Args>
+    Node(Node *next, Node *prev, Args &&...args)
+        : data_(std::forward<Args>(args)...), next_{next}, prev_{prev} {}
     value_type data_;
     Node *next_;
     Node *prev_;
@@ -106,13 +111,17 @@ public:
   const_iterator cend() const noexcept;
 
   void clear();
+  void clear_async();
   void push_back(const_reference value);
+  void push_back(double_reference value);
   void pop_back();
   void push_front(const_reference value);
+  void push_front(double_reference value);
   void pop_front();
   void swap(List &other);
 
   iterator insert(iterator pos, const_reference value);
+  iterator insert(iterator pos, double_reference value);
   iterator erase(iterator pos);
   void reverse() noexcept;
   void sort();
@@ -128,7 +137,8 @@ public:
 private:
   size_type size_;
   Node *shadow_node_;
-  iterator insert_after(iterator pos, const_reference value);
+  template <class... Args> iterator emplace_after(iterator pos, Args &&...args);
+  static void link_before(Node *pos, Node *node) noexcept;
   void copy_list(const List<T> &other);
 };
 
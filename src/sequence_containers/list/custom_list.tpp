@@ -3,7 +3,7 @@
  *
  */
 template <class value_type> List<value_type>::List() : size_{0} {
-  shadow_node_ = new Node(value_type());
+  shadow_node_ = new Node(nullptr, nullptr);
   shadow_node_->prev_ = shadow_node_;
   shadow_node_->next_ = shadow_node_;
 }
@@ -255,21 +255,45 @@ List<value_type>::max_size() const noexcept {
 template <class value_type>
 typename List<value_type>::iterator
 List<value_type>::insert(iterator pos, const_reference value) {
-  return insert_after(iterator(pos.ptr_->prev_), value);
+  return emplace_after(iterator(pos.ptr_->prev_), value);
 }
 
+/**
+ * @brief inserts value before pos by moving it into the new node.
+ *
+ * @param pos iterator before which the content will be inserted.
+ * @param value element value to move
+ * @return Iterator pointing to the inserted value.
+ */
 template <class value_type>
 typename List<value_type>::iterator
-List<value_type>::insert_after(iterator pos, const_reference value) {
-  Node *current = new Node(value, pos.ptr_->next_, pos.ptr_);
+List<value_type>::insert(iterator pos, double_reference value) {
+  return emplace_after(iterator(pos.ptr_->prev_), std::move(value));
+}
+
+template <class value_type>
+template <class... Args>
+typename List<value_type>::iterator
+List<value_type>::emplace_after(iterator pos, Args &&...args) {
+  Node *current =
+      new Node(pos.ptr_->next_, pos.ptr_, std::forward<Args>(args)...);
   pos.ptr_->next_->prev_ = current;
   pos.ptr_->next_ = current;
   ++size_;
   return iterator(current);
 }
 
+template <class value_type>
+void List<value_type>::link_before(Node *pos, Node *node) noexcept {
+  node->prev_ = pos->prev_;
+  node->next_ = pos;
+  pos->prev_->next_ = node;
+  pos->prev_ = node;
+}
+
 /**
- * @brief inserts new elements into the container directly before pos
+ * @brief inserts new elements into the container directly before pos, every
+ * argument is forwarded into its own node
  *
  * @tparam Args
  * @param pos iterator before which the new element will be constructed
@@ -280,15 +304,8 @@ template <class value_type>
 template <class... Args>
 typename List<value_type>::iterator
 List<value_type>::emplace(const_iterator pos, Args &&...args) {
-  value_type elements[] = {args...};
-  size_type tmp_size = sizeof...(args);
-  auto it_res = static_cast<iterator>(pos);
-  for (size_type i = 0; i < tmp_size; ++i) {
-    if (i == 0)
-      it_res = insert(it_res, elements[i]);
-    else
-      it_res = insert_after(it_res, elements[i]);
-  }
+  auto it_res = iterator(pos.ptr_->prev_);
+  ((it_res = emplace_after(it_res, std::forward<Args>(args))), ...);
   return it_res;
 }
 
@@ -300,7 +317,8 @@ List<value_type>::emplace(const_iterator pos, Args &&...args) {
 template <class value_type>
 template <class... Args>
 void List<value_type>::emplace_back(Args &&...args) {
-  (this->push_back(args), ...);
+  (emplace_after(iterator(shadow_node_->prev_), std::forward<Args>(args)),
+   ...);
 }
 
 /**
@@ -311,17 +329,8 @@ void List<value_type>::emplace_back(Args &&...args) {
 template <class value_type>
 template <class... Args>
 void List<value_type>::emplace_front(Args &&...args) {
-  value_type elements[] = {args...};
-  size_type tmp_size = sizeof...(args);
-  auto it_pos = begin();
-  for (size_type i = 0; i < tmp_size; ++i) {
-    if (i == 0) {
-      push_front(elements[i]);
-      --it_pos;
-    } else {
-      it_pos = insert_after(it_pos, elements[i]);
-    }
-  }
+  auto it_pos = iterator(shadow_node_);
+  ((it_pos = emplace_after(it_pos, std::forward<Args>(args))), ...);
 }
 
 /**
@@ -354,7 +363,18 @@ typename List<value_type>::iterator List<value_type>::erase(iterator pos) {
  */
 template <class value_type>
 void List<value_type>::push_front(const_reference value) {
-  insert_after(const_iterator(shadow_node_), value);
+  emplace_after(iterator(shadow_node_), value);
+}
+
+/**
+ * @brief Prepends the given element value to the beginning of the container by
+ * moving it into the new node.
+ *
+ * @param value the value of the element to prepend
+ */
+template <class value_type>
+void List<value_type>::push_front(double_reference value) {
+  emplace_after(iterator(shadow_node_), std::move(value));
 }
 
 /**
@@ -364,7 +384,18 @@ void List<value_type>::push_front(const_reference value) {
  */
 template <class value_type>
 void List<value_type>::push_back(const_reference value) {
-  insert_after(const_iterator(shadow_node_->prev_), value);
+  emplace_after(iterator(shadow_node_->prev_), value);
+}
+
+/**
+ * @brief Appends the given element value to the end of the container by moving
+ * it into the new node.
+ *
+ * @param value the value of the element to append
+ */
+template <class value_type>
+void List<value_type>::push_back(double_reference value) {
+  emplace_after(iterator(shadow_node_->prev_), std::move(value));
 }
 
 /**
@@ -394,6 +425,29 @@ template <class value_type> void List<value_type>::clear() {
   size_ = 0;
 }
 
+/**
+ * @brief Erases all elements from the container in constant time. The nodes
+ * are unlinked at once, destroyed and freed later by the background thread,
+ * @code custom::Reclaimer__::instance().wait() waits for it.
+ *
+ */
+template <class value_type> void List<value_type>::clear_async() {
+  if (empty())
+    return;
+  Node *first = shadow_node_->next_;
+  shadow_node_->prev_->next_ = nullptr;
+  shadow_node_->prev_ = shadow_node_;
+  shadow_node_->next_ = shadow_node_;
+  size_ = 0;
+  Reclaimer__::instance().reclaim([first]() mutable noexcept {
+    while (first) {
+      Node *next = first->next_;
+      delete first;
+      first = next;
+    }
+  });
+}
+
 /**
  * @brief Exchanges the contents of the container with those of other. Does not
  * invoke any move, copy, or swap operations on individual elements.
@@ -459,8 +513,9 @@ template <class value_type> void List<value_type>::unique() {
 /**
  * @brief Transfers elements from one list to another. Transfers all elements
  * from other into *this. The elements are inserted before the element pointed
- * to by pos. The container other becomes empty after the operation. The
- * behavior is undefined if other refers to the same object as *this.
+ * to by pos. The container other becomes empty after the operation. No
+ * elements are copied or moved, the nodes are relinked. The behavior is
+ * undefined if other refers to the same object as *this.
  *
  * @param pos element before which the content will be inserted
  * @param other	another container to transfer the content from
@@ -471,10 +526,16 @@ void List<value_type>::splice(const_iterator pos, List<value_type> &other) {
     throw std::logic_error(
         "*this == &other, two object indicate on one object");
   if (!other.empty()) {
-    for (auto it = other.begin(); it != other.end(); ++it) {
-      this->insert(pos, *it);
-    }
-    other.clear();
+    Node *first = other.shadow_node_->next_;
+    Node *last = other.shadow_node_->prev_;
+    Node *next = pos.ptr_;
+    first->prev_ = next->prev_;
+    next->prev_->next_ = first;
+    last->next_ = next;
+    next->prev_ = last;
+    size_ += other.size_;
+    other.shadow_node_->next_ = other.shadow_node_->prev_ = other.shadow_node_;
+    other.size_ = 0;
   }
 }
 
@@ -492,14 +553,17 @@ void List<value_type>::merge(List<value_type> &other) {
   if (this != &other) {
     auto it_begin_this = begin();
     auto it_begin_other = other.begin();
-    for (auto i = other.size_ + size_; i != 0; --i) {
-      if ((*it_begin_this <= *it_begin_other) && (it_begin_this != end())) {
+    while (it_begin_other != other.end()) {
+      if (it_begin_this != end() && *it_begin_this <= *it_begin_other) {
         ++it_begin_this;
-      } else if (it_begin_other != other.end()) {
-        insert(it_begin_this, *it_begin_other);
-        ++it_begin_other;
+      } else {
+        // the node itself moves to this list
+        Node *node = (it_begin_other++).ptr_;
+        link_before(it_begin_this.ptr_, node);
+        ++size_;
       }
     }
-    other.clear();
+    other.shadow_node_->next_ = other.shadow_node_->prev_ = other.shadow_node_;
+    other.size_ = 0;
   }
 }
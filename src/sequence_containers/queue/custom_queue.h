@@ -138,6 +138,13 @@ public:
    */
   void push(const_reference value) { queue_.push_back(value); }
 
+  /**
+   * @brief Moves the given element value to the end of the queue.
+   *
+   * @param value the value of the element to push
+   */
+  void push(value_type &&value) { queue_.push_back(std::move(value)); }
+
   /**
    * @brief Removes an element from the front of the queue. Effectively calls
    * c.pop_front()
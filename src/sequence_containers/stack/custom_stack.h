@@ -120,6 +120,14 @@ public:
    */
   void push(const_reference value) { stack_.push_back(value); }
 
+  /**
+   * @brief Moves the given element value to the top of the stack. Effectively
+   * calls c.push_back(std::move(value))
+   *
+   * @param value the value of the element to push
+   */
+  void push(value_type &&value) { stack_.push_back(std::move(value)); }
+
   /**
    * @brief Removes the top element from the stack. Effectively calls
    * c.pop_back()
@@ -5,6 +5,7 @@
 #include <initializer_list>
 #include <limits>
 #include <stdexcept>
+#include <utility>
 
 #include "../../interfaces/custom_iterator.h"
 #include "../../misc/custom_sequence_allocator.h"
@@ -93,12 +94,6 @@ private:
   constexpr void shrink(size_type size);
   constexpr void reorganize_for_push_back();
 
-  template <typename... Args>
-  constexpr iterator emplace_helper(const_iterator pos, reference first,
-                                    Args &&...args);
-
-  constexpr iterator emplace_helper(const_iterator pos, reference value);
-
   constexpr static const char *kOutOfRangeMsg =
       "Position is greater or equal than size of a vector";
   constexpr static const char *kMaxCapacityMsg =
@@ -404,7 +404,10 @@ template <class T>
 template <typename... Args>
 constexpr typename Vector<T>::iterator Vector<T>::emplace(const_iterator pos,
                                                           Args &&...args) {
-  return emplace_helper(pos, args...);
+  // every argument is forwarded, so rvalues and move-only values are moved
+  size_type distance = pos - data_.data();
+  ((insert(data_ + distance++, std::forward<Args>(args))), ...);
+  return data_ + distance;
 }
 
 /**
@@ -416,24 +419,7 @@ constexpr typename Vector<T>::iterator Vector<T>::emplace(const_iterator pos,
 template <class T>
 template <typename... Args>
 constexpr void Vector<T>::emplace_back(Args &&...args) {
-  emplace_helper(end(), args...);
-}
-
-template <class T>
-template <typename... Args>
-constexpr typename Vector<T>::iterator
-Vector<T>::emplace_helper(const_iterator pos, reference first, Args &&...args) {
-  pos = insert((pointer)pos, first);
-  ++pos;
-  return emplace_helper(pos, args...);
-}
-
-template <class T>
-constexpr typename Vector<T>::iterator
-Vector<T>::emplace_helper(const_iterator pos, reference value) {
-  iterator result = (iterator)insert((iterator)pos, value);
-  ++result;
-  return result;
+  (push_back(std::forward<Args>(args)), ...);
 }
 
 template <class T> constexpr void Vector<T>::shrink(size_type size) {
@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../../associative_containers/btree_map/custom_btree_map.h"
+#include "../move_only_counter.h"
+
+template <class K, class V>
+void CompareBTreeMaps(const std::map<K, V> &std_map,
+                      const custom::BTreeMap<K, V> &s21_map) {
+  ASSERT_EQ(std_map.size(), s21_map.size());
+  ASSERT_EQ(std_map.empty(), s21_map.empty());
+  auto std_i = std_map.begin();
+  auto s21_i = s21_map.begin();
+  while (std_i != std_map.end() && s21_i != s21_map.end()) {
+    ASSERT_EQ((*std_i).first, (*s21_i).first);
+    ASSERT_EQ((*std_i).second, (*s21_i).second);
+    ++std_i;
+    ++s21_i;
+  }
+  ASSERT_EQ(std_i, std_map.end());
+  ASSERT_EQ(s21_i, s21_map.end());
+  // backward walk crosses the nodes in the other direction
+  while (std_i != std_map.begin()) {
+    --std_i;
+    --s21_i;
+    ASSERT_EQ((*std_i).first, (*s21_i).first);
+  }
+  ASSERT_EQ(s21_i, s21_map.begin());
+}
+
+TEST(BTreeMap, default_constructor) {
+  std::map<int, int> std_map;
+  custom::BTreeMap<int, int> s21_map;
+  CompareBTreeMaps(std_map, s21_map);
+  ASSERT_EQ(s21_map.begin(), s21_map.end());
+  ASSERT_EQ(s21_map.memory_usage(), 0UL);
+}
+
+TEST(BTreeMap, initializer_list_and_copy) {
+  std::map<int, std::string> std_map{{5, "five"}, {1, "one"}, {3, "three"}};
+  custom::BTreeMap<int, std::string> s21_map{
+      {5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}};
+  CompareBTreeMaps(std_map, s21_map);
+  custom::BTreeMap<int, std::string> s21_copy(s21_map);
+  CompareBTreeMaps(std_map, s21_copy);
+  custom::BTreeMap<int, std::string> s21_moved(std::move(s21_copy));
+  CompareBTreeMaps(std_map, s21_moved);
+  ASSERT_TRUE(s21_copy.empty());
+  s21_copy = s21_moved;
+  CompareBTreeMaps(std_map, s21_copy);
+}
+
+TEST(BTreeMap, element_access) {
+  custom::BTreeMap<std::string, int> s21_map;
+  s21_map["a"] = 1;
+  s21_map["b"] += 2;
+  ASSERT_EQ(s21_map.at("a"), 1);
+  ASSERT_EQ(s21_map.at("b"), 2);
+  ASSERT_THROW(s21_map.at("c"), std::exception);
+  const auto &s21_const = s21_map;
+  ASSERT_EQ(s21_const.at("b"), 2);
+  ASSERT_EQ(s21_map.size(), 2UL);
+}
+
+TEST(BTreeMap, insert_variants) {
+  custom::BTreeMap<int, std::string> s21_map;
+  ASSERT_TRUE(s21_map.insert({1, "one"}).second);
+  ASSERT_FALSE(s21_map.insert(1, "uno").second);
+  ASSERT_TRUE(s21_map.insert(2, "two").second);
+  ASSERT_FALSE(s21_map.insert_or_assign(2, "dos").second);
+  ASSERT_EQ(s21_map.at(2), "dos");
+  ASSERT_TRUE(s21_map.try_emplace(3, 5UL, 'x').second);
+  ASSERT_EQ(s21_map.at(3), "xxxxx");
+  ASSERT_FALSE(s21_map.emplace(3, "three").second);
+  auto it = s21_map.emplace_hint(s21_map.end(), 4, "four");
+  ASSERT_EQ((*it).first, 4);
+  it = s21_map.insert(s21_map.begin(), {0, "zero"});
+  ASSERT_EQ((*it).first, 0);
+  // the wrong hint is ignored
+  it = s21_map.insert(s21_map.begin(), {10, "ten"});
+  ASSERT_EQ((*it).first, 10);
+  std::map<int, std::string> std_map{{0, "zero"}, {1, "one"}, {2, "dos"},
+                                     {3, "xxxxx"}, {4, "four"}, {10, "ten"}};
+  CompareBTreeMaps(std_map, s21_map);
+}
+
+TEST(BTreeMap, random_operations) {
+  std::mt19937 generator(7);
+  std::map<int, int> std_map;
+  custom::BTreeMap<int, int> s21_map;
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(generator() % 2000);
+    switch (generator() % 4) {
+    case 0:
+    case 1:
+      ASSERT_EQ(std_map.insert({key, i}).second,
+                s21_map.insert({key, i}).second);
+      break;
+    case 2:
+      ASSERT_EQ(std_map.erase(key), s21_map.erase(key));
+      break;
+    default: {
+      auto std_i = std_map.lower_bound(key);
+      auto s21_i = s21_map.lower_bound(key);
+      ASSERT_EQ(std_i == std_map.end(), s21_i == s21_map.end());
+      if (std_i != std_map.end()) {
+        // erasure returns the next element
+        std_i = std_map.erase(std_i);
+        s21_i = s21_map.erase(s21_i);
+        ASSERT_EQ(std_i == std_map.end(), s21_i == s21_map.end());
+        if (std_i != std_map.end()) {
+          ASSERT_EQ((*std_i).first, (*s21_i).first);
+        }
+      }
+    }
+    }
+  }
+  CompareBTreeMaps(std_map, s21_map);
+}
+
+TEST(BTreeMap, sorted_fill_is_dense) {
+  custom::BTreeMap<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 100000; ++i) {
+    s21_map.insert(s21_map.end(), {i, -i});
+    std_map.insert(std_map.end(), {i, -i});
+  }
+  CompareBTreeMaps(std_map, s21_map);
+  // appended nodes stay full, so every pair takes about its own size
+  ASSERT_LT(s21_map.memory_usage(),
+            s21_map.size() * sizeof(std::pair<const int, int>) * 5UL / 4UL);
+}
+
+TEST(BTreeMap, erase_range_and_if) {
+  std::map<int, int> std_map;
+  custom::BTreeMap<int, int> s21_map;
+  for (int i = 0; i < 3000; ++i) {
+    std_map.insert({i, i});
+    s21_map.insert({i, i});
+  }
+  auto std_i = std_map.erase(std_map.find(100), std_map.find(2500));
+  auto s21_i = s21_map.erase(s21_map.find(100), s21_map.find(2500));
+  ASSERT_EQ((*std_i).first, (*s21_i).first);
+  CompareBTreeMaps(std_map, s21_map);
+  auto is_odd = [](const std::pair<const int, int> &item) {
+    return item.first % 2 == 1;
+  };
+  ASSERT_EQ(custom::erase_if(s21_map, is_odd), 300UL);
+  for (auto i = std_map.begin(); i != std_map.end();)
+    i = is_odd(*i) ? std_map.erase(i) : std::next(i);
+  CompareBTreeMaps(std_map, s21_map);
+  s21_map.erase(s21_map.begin(), s21_map.end());
+  ASSERT_TRUE(s21_map.empty());
+}
+
+TEST(BTreeMap, swap_and_merge) {
+  custom::BTreeMap<int, int> s21_map1{{1, 1}, {3, 3}, {5, 5}};
+  custom::BTreeMap<int, int> s21_map2{{2, 2}, {3, 30}, {4, 4}};
+  s21_map1.merge(s21_map2);
+  CompareBTreeMaps(std::map<int, int>{{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}},
+                   s21_map1);
+  CompareBTreeMaps(std::map<int, int>{{3, 30}}, s21_map2);
+  s21_map1.swap(s21_map2);
+  ASSERT_EQ(s21_map1.size(), 1UL);
+  ASSERT_EQ(s21_map2.size(), 5UL);
+}
+
+TEST(BTreeMap, move_only) {
+  MoveOnlyCounter::instances = 0;
+  {
+    custom::BTreeMap<int, MoveOnlyCounter> s21_map;
+    for (int i = 0; i < 1000; ++i)
+      s21_map.try_emplace(i * 7 % 1000, i);
+    for (int i = 0; i < 1000; i += 3)
+      s21_map.erase(i);
+    ASSERT_EQ(MoveOnlyCounter::instances,
+              static_cast<int>(s21_map.size()));
+    ASSERT_EQ(s21_map.at(1).value, 143);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(BTreeMap, move_only_key) {
+  MoveOnlyCounter::instances = 0;
+  {
+    custom::BTreeMap<MoveOnlyCounter, int> s21_map1, s21_map2;
+    for (int i = 0; i < 1000; ++i)
+      s21_map1.try_emplace(MoveOnlyCounter(i * 7 % 1000), i);
+    for (int i = 0; i < 1000; i += 2)
+      s21_map2.emplace(MoveOnlyCounter(i), -i);
+    for (int i = 0; i < 1000; i += 3)
+      s21_map1.erase(MoveOnlyCounter(i));
+    s21_map1.merge(s21_map2);
+    ASSERT_EQ(s21_map1.size(), 1000UL - 167UL);
+    ASSERT_EQ(s21_map2.size(), 333UL);
+    ASSERT_EQ(s21_map1.at(MoveOnlyCounter(1)), 143);
+    ASSERT_EQ(s21_map1.at(MoveOnlyCounter(6)), -6);
+    ASSERT_EQ(MoveOnlyCounter::instances,
+              static_cast<int>(s21_map1.size() + s21_map2.size()));
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+struct KeyCopyCounter {
+  explicit KeyCopyCounter(int new_value) : value(new_value) {}
+  KeyCopyCounter(const KeyCopyCounter &other) : value(other.value) {
+    ++copies;
+  }
+  KeyCopyCounter(KeyCopyCounter &&other) noexcept : value(other.value) {}
+  KeyCopyCounter &operator=(const KeyCopyCounter &other) = default;
+  KeyCopyCounter &operator=(KeyCopyCounter &&other) noexcept = default;
+
+  bool operator<(const KeyCopyCounter &other) const {
+    return value < other.value;
+  }
+
+  int value;
+  inline static int copies = 0;
+};
+
+TEST(BTreeMap, relocation_does_not_copy_keys) {
+  custom::BTreeMap<KeyCopyCounter, std::string> s21_map;
+  KeyCopyCounter::copies = 0;
+  // the keys go into the middle of the full nodes, so every insertion and
+  // erasure shifts the values and many of them split or merge the nodes
+  for (int i = 0; i < 2000; ++i)
+    s21_map.try_emplace(KeyCopyCounter(i * 7 % 2000), "value");
+  for (int i = 0; i < 2000; i += 3)
+    s21_map.erase(KeyCopyCounter(i));
+  s21_map.emplace(KeyCopyCounter(3000), "value");
+  ASSERT_EQ(KeyCopyCounter::copies, 0);
+  ASSERT_EQ(s21_map.size(), 2000UL - 667UL + 1UL);
+  ASSERT_EQ(s21_map.at(KeyCopyCounter(1)), "value");
+}
+
+TEST(BTreeMap, insert_move) {
+  using mapped_type = std::vector<int>;
+  custom::BTreeMap<KeyCopyCounter, mapped_type> s21_map;
+  KeyCopyCounter::copies = 0;
+  mapped_type value(100, 1);
+  ASSERT_TRUE(s21_map.insert(KeyCopyCounter(1), std::move(value)).second);
+  ASSERT_TRUE(value.empty());
+  value.assign(100, 2);
+  ASSERT_FALSE(s21_map.insert(KeyCopyCounter(1), std::move(value)).second);
+  ASSERT_EQ(value.size(), 100UL);
+
+  auto result = s21_map.insert_or_assign(KeyCopyCounter(1), std::move(value));
+  ASSERT_FALSE(result.second);
+  ASSERT_TRUE(value.empty());
+  ASSERT_EQ((*result.first).second, mapped_type(100, 2));
+  result = s21_map.insert_or_assign(KeyCopyCounter(3), mapped_type(3, 3));
+  ASSERT_TRUE(result.second);
+  s21_map[KeyCopyCounter(4)].assign(4, 4);
+  ASSERT_EQ(KeyCopyCounter::copies, 0);
+  ASSERT_EQ(s21_map.size(), 3UL);
+  ASSERT_EQ(s21_map.at(KeyCopyCounter(4)), mapped_type(4, 4));
+}
+
+TEST(BTreeMap, transparent_lookup) {
+  custom::BTreeMap<std::string, int, std::less<>> s21_map{
+      {"apple", 1}, {"banana", 2}, {"cherry", 3}};
+  std::string_view key = "banana";
+  ASSERT_EQ((*s21_map.find(key)).second, 2);
+  ASSERT_TRUE(s21_map.contains(std::string_view("cherry")));
+  ASSERT_EQ((*s21_map.lower_bound(std::string_view("b"))).first, "banana");
+  ASSERT_EQ(s21_map.upper_bound(std::string_view("cherry")), s21_map.end());
+}
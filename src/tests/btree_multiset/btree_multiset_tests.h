@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../../associative_containers/btree_multiset/custom_btree_multiset.h"
+
+template <class T>
+void CompareBTreeMultisets(const std::multiset<T> &std_multiset,
+                           const custom::BTreeMultiset<T> &s21_multiset) {
+  ASSERT_EQ(std_multiset.size(), s21_multiset.size());
+  auto std_i = std_multiset.begin();
+  auto s21_i = s21_multiset.begin();
+  while (std_i != std_multiset.end() && s21_i != s21_multiset.end()) {
+    ASSERT_EQ(*std_i, *s21_i);
+    ++std_i;
+    ++s21_i;
+  }
+  ASSERT_EQ(std_i, std_multiset.end());
+  ASSERT_EQ(s21_i, s21_multiset.end());
+}
+
+TEST(BTreeMultiset, repeated_values) {
+  std::multiset<int> std_multiset{5, 1, 5, 3, 5, 1};
+  custom::BTreeMultiset<int> s21_multiset{5, 1, 5, 3, 5, 1};
+  CompareBTreeMultisets(std_multiset, s21_multiset);
+  ASSERT_EQ(s21_multiset.count(5), 3UL);
+  ASSERT_EQ(s21_multiset.count(2), 0UL);
+  ASSERT_EQ(*s21_multiset.insert(3), 3);
+  ASSERT_EQ(*s21_multiset.emplace(3), 3);
+  ASSERT_EQ(s21_multiset.erase(3), 3UL);
+  ASSERT_EQ(s21_multiset.erase(3), 0UL);
+  ASSERT_EQ(s21_multiset.size(), 5UL);
+}
+
+TEST(BTreeMultiset, random_operations) {
+  std::mt19937 generator(11);
+  std::multiset<int> std_multiset;
+  custom::BTreeMultiset<int> s21_multiset;
+  for (int i = 0; i < 50000; ++i) {
+    int value = static_cast<int>(generator() % 300);
+    switch (generator() % 3) {
+    case 0:
+      std_multiset.insert(value);
+      s21_multiset.insert(value);
+      break;
+    case 1:
+      std_multiset.insert(std_multiset.lower_bound(value), value);
+      s21_multiset.insert(s21_multiset.lower_bound(value), value);
+      break;
+    default: {
+      auto std_i = std_multiset.find(value);
+      auto s21_i = s21_multiset.find(value);
+      ASSERT_EQ(std_i == std_multiset.end(), s21_i == s21_multiset.end());
+      if (std_i != std_multiset.end()) {
+        std_multiset.erase(std_i);
+        s21_multiset.erase(s21_i);
+      }
+    }
+    }
+    ASSERT_EQ(std_multiset.count(value), s21_multiset.count(value));
+  }
+  CompareBTreeMultisets(std_multiset, s21_multiset);
+}
+
+TEST(BTreeMultiset, merge_keeps_all_values) {
+  custom::BTreeMultiset<int> s21_multiset1{1, 2, 2};
+  custom::BTreeMultiset<int> s21_multiset2{2, 3};
+  s21_multiset1.merge(s21_multiset2);
+  CompareBTreeMultisets(std::multiset<int>{1, 2, 2, 2, 3}, s21_multiset1);
+  ASSERT_TRUE(s21_multiset2.empty());
+}
+
+TEST(BTreeMultiset, transparent_lookup) {
+  custom::BTreeMultiset<std::string, std::less<>> s21_multiset{"a", "b", "b"};
+  ASSERT_EQ(s21_multiset.count(std::string_view("b")), 2UL);
+  ASSERT_TRUE(s21_multiset.contains(std::string_view("a")));
+  ASSERT_EQ(*s21_multiset.upper_bound(std::string_view("a")), "b");
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../associative_containers/btree_set/custom_btree_set.h"
+
+template <class T>
+void CompareBTreeSets(const std::set<T> &std_set,
+                      const custom::BTreeSet<T> &s21_set) {
+  ASSERT_EQ(std_set.size(), s21_set.size());
+  auto std_i = std_set.begin();
+  auto s21_i = s21_set.begin();
+  while (std_i != std_set.end() && s21_i != s21_set.end()) {
+    ASSERT_EQ(*std_i, *s21_i);
+    ++std_i;
+    ++s21_i;
+  }
+  ASSERT_EQ(std_i, std_set.end());
+  ASSERT_EQ(s21_i, s21_set.end());
+}
+
+TEST(BTreeSet, constructors) {
+  std::vector<int> items{9, 3, 7, 3, 1};
+  std::set<int> std_set(items.begin(), items.end());
+  custom::BTreeSet<int> s21_set(items.begin(), items.end());
+  CompareBTreeSets(std_set, s21_set);
+  custom::BTreeSet<int> s21_list{9, 3, 7, 3, 1};
+  CompareBTreeSets(std_set, s21_list);
+  custom::BTreeSet<int> s21_copy;
+  s21_copy = s21_set;
+  CompareBTreeSets(std_set, s21_copy);
+  custom::BTreeSet<int> s21_moved;
+  s21_moved = std::move(s21_copy);
+  CompareBTreeSets(std_set, s21_moved);
+}
+
+TEST(BTreeSet, insert_and_find) {
+  custom::BTreeSet<std::string> s21_set;
+  ASSERT_TRUE(s21_set.insert("b").second);
+  ASSERT_FALSE(s21_set.insert("b").second);
+  ASSERT_TRUE(s21_set.emplace(3UL, 'a').second);
+  ASSERT_EQ(*s21_set.emplace_hint(s21_set.end(), "z"), "z");
+  ASSERT_EQ(s21_set.insert({"c", "d", "b"}), 2UL);
+  ASSERT_EQ(*s21_set.find("aaa"), "aaa");
+  ASSERT_EQ(s21_set.find("a"), s21_set.end());
+  ASSERT_TRUE(s21_set.contains("d"));
+  ASSERT_EQ(*s21_set.lower_bound("ca"), "d");
+  ASSERT_EQ(*s21_set.upper_bound("c"), "d");
+  auto range = s21_set.equal_range("c");
+  ASSERT_EQ(*range.first, "c");
+  ASSERT_EQ(*range.second, "d");
+}
+
+TEST(BTreeSet, large_values) {
+  // only a few values fit into a node, so every operation splits and merges
+  std::mt19937 generator(3);
+  std::set<std::string> std_set;
+  custom::BTreeSet<std::string> s21_set;
+  for (int i = 0; i < 20000; ++i) {
+    std::string value(40UL, static_cast<char>('a' + generator() % 26));
+    value += std::to_string(generator() % 1000);
+    if (generator() % 3) {
+      ASSERT_EQ(std_set.insert(value).second, s21_set.insert(value).second);
+    } else {
+      ASSERT_EQ(std_set.erase(value), s21_set.erase(value));
+    }
+  }
+  CompareBTreeSets(std_set, s21_set);
+  ASSERT_GT(s21_set.memory_usage(), s21_set.size() * sizeof(std::string));
+}
+
+TEST(BTreeSet, descending_order) {
+  custom::BTreeSet<int, std::greater<int>> s21_set;
+  for (int i = 0; i < 1000; ++i)
+    s21_set.insert(s21_set.begin(), i);
+  int expected = 999;
+  for (int value : s21_set)
+    ASSERT_EQ(value, expected--);
+  ASSERT_EQ(expected, -1);
+}
+
+TEST(BTreeSet, erase_while_iterating) {
+  std::set<int> std_set;
+  custom::BTreeSet<int> s21_set;
+  for (int i = 0; i < 5000; ++i) {
+    std_set.insert(i);
+    s21_set.insert(i);
+  }
+  for (auto i = s21_set.begin(); i != s21_set.end();)
+    i = *i % 3 ? s21_set.erase(i) : std::next(i);
+  for (auto i = std_set.begin(); i != std_set.end();)
+    i = *i % 3 ? std_set.erase(i) : std::next(i);
+  CompareBTreeSets(std_set, s21_set);
+  ASSERT_EQ(custom::erase_if(s21_set, [](int value) { return value < 2500; }),
+            834UL);
+  ASSERT_EQ(*s21_set.begin(), 2502);
+}
+
+TEST(BTreeSet, merge) {
+  custom::BTreeSet<int> s21_set1{1, 2, 3};
+  custom::BTreeSet<int> s21_set2{3, 4, 5};
+  s21_set1.merge(s21_set2);
+  CompareBTreeSets(std::set<int>{1, 2, 3, 4, 5}, s21_set1);
+  CompareBTreeSets(std::set<int>{3}, s21_set2);
+}
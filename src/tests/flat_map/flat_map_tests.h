@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../../associative_containers/flat_map/custom_flat_map.h"
+#include "../move_only_counter.h"
+
+template <class K, class V>
+void CompareFlatMaps(const std::map<K, V> &std_map,
+                     const custom::FlatMap<K, V> &s21_map) {
+  ASSERT_EQ(std_map.size(), s21_map.size());
+  ASSERT_EQ(std_map.empty(), s21_map.empty());
+  auto std_i = std_map.begin();
+  auto s21_i = s21_map.begin();
+  while (std_i != std_map.end() && s21_i != s21_map.end()) {
+    ASSERT_EQ((*std_i).first, (*s21_i).first);
+    ASSERT_EQ((*std_i).second, (*s21_i).second);
+    ++std_i;
+    ++s21_i;
+  }
+  ASSERT_EQ(std_i, std_map.end());
+  ASSERT_EQ(s21_i, s21_map.end());
+}
+
+TEST(FlatMap, constructors) {
+  std::map<int, std::string> std_map{{5, "five"}, {1, "one"}, {3, "three"}};
+  custom::FlatMap<int, std::string> s21_map{
+      {5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}};
+  CompareFlatMaps(std_map, s21_map);
+  custom::FlatMap<int, std::string> s21_range(std_map.begin(), std_map.end());
+  CompareFlatMaps(std_map, s21_range);
+  custom::FlatMap<int, std::string> s21_copy(s21_map);
+  CompareFlatMaps(std_map, s21_copy);
+  custom::FlatMap<int, std::string> s21_moved(std::move(s21_copy));
+  CompareFlatMaps(std_map, s21_moved);
+  ASSERT_TRUE(s21_copy.empty());
+}
+
+TEST(FlatMap, element_access) {
+  custom::FlatMap<std::string, int> s21_map;
+  s21_map["b"] = 2;
+  s21_map["a"] += 1;
+  ASSERT_EQ(s21_map.at("a"), 1);
+  ASSERT_EQ(s21_map.at("b"), 2);
+  ASSERT_THROW(s21_map.at("c"), std::exception);
+  const auto &s21_const = s21_map;
+  ASSERT_EQ(s21_const.at("b"), 2);
+  // keys and values lie in the separate arrays in the same order
+  ASSERT_EQ(s21_map.keys()[0], "a");
+  ASSERT_EQ(s21_map.values()[1], 2);
+}
+
+TEST(FlatMap, insert_variants) {
+  custom::FlatMap<int, std::string> s21_map;
+  ASSERT_TRUE(s21_map.insert({1, "one"}).second);
+  ASSERT_FALSE(s21_map.insert(1, "uno").second);
+  ASSERT_TRUE(s21_map.insert(2, "two").second);
+  ASSERT_FALSE(s21_map.insert_or_assign(2, "dos").second);
+  ASSERT_TRUE(s21_map.try_emplace(3, 5UL, 'x').second);
+  ASSERT_FALSE(s21_map.emplace(3, "three").second);
+  auto it = s21_map.emplace_hint(s21_map.end(), 4, "four");
+  ASSERT_EQ((*it).first, 4);
+  it = s21_map.insert(s21_map.begin(), {0, "zero"});
+  ASSERT_EQ((*it).first, 0);
+  // the wrong hint is ignored
+  it = s21_map.insert(s21_map.begin(), {10, "ten"});
+  ASSERT_EQ((*it).first, 10);
+  (*it).second += "!";
+  std::map<int, std::string> std_map{{0, "zero"}, {1, "one"}, {2, "dos"},
+                                     {3, "xxxxx"}, {4, "four"}, {10, "ten!"}};
+  CompareFlatMaps(std_map, s21_map);
+}
+
+TEST(FlatMap, bulk_insert) {
+  std::mt19937 generator(5);
+  std::map<int, int> std_map;
+  custom::FlatMap<int, int> s21_map;
+  for (int round = 0; round < 20; ++round) {
+    std::vector<std::pair<int, int>> batch;
+    for (int i = 0; i < 500; ++i)
+      batch.push_back({static_cast<int>(generator() % 5000), round});
+    std::size_t old_size = std_map.size();
+    std_map.insert(batch.begin(), batch.end());
+    ASSERT_EQ(s21_map.insert(batch.begin(), batch.end()),
+              std_map.size() - old_size);
+    CompareFlatMaps(std_map, s21_map);
+  }
+}
+
+TEST(FlatMap, random_operations) {
+  std::mt19937 generator(9);
+  std::map<int, int> std_map;
+  custom::FlatMap<int, int> s21_map;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(generator() % 1000);
+    switch (generator() % 3) {
+    case 0:
+      ASSERT_EQ(std_map.insert({key, i}).second,
+                s21_map.insert({key, i}).second);
+      break;
+    case 1:
+      ASSERT_EQ(std_map.erase(key), s21_map.erase(key));
+      break;
+    default: {
+      auto std_i = std_map.upper_bound(key);
+      auto s21_i = s21_map.upper_bound(key);
+      ASSERT_EQ(std::distance(std_map.begin(), std_i),
+                s21_i - s21_map.begin());
+    }
+    }
+  }
+  CompareFlatMaps(std_map, s21_map);
+}
+
+TEST(FlatMap, erase_range_and_if) {
+  std::map<int, int> std_map;
+  custom::FlatMap<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) {
+    std_map.insert({i, -i});
+    s21_map.insert(s21_map.end(), {i, -i});
+  }
+  auto std_i = std_map.erase(std_map.find(100), std_map.find(900));
+  auto s21_i = s21_map.erase(s21_map.find(100), s21_map.find(900));
+  ASSERT_EQ((*std_i).first, (*s21_i).first);
+  CompareFlatMaps(std_map, s21_map);
+  auto is_odd = [](const auto &item) { return item.first % 2 == 1; };
+  ASSERT_EQ(custom::erase_if(s21_map, is_odd), 100UL);
+  for (auto i = std_map.begin(); i != std_map.end();)
+    i = is_odd(*i) ? std_map.erase(i) : std::next(i);
+  CompareFlatMaps(std_map, s21_map);
+}
+
+TEST(FlatMap, erase_empty_range) {
+  std::map<std::string, std::string> std_map;
+  custom::FlatMap<std::string, std::string> s21_map;
+  for (int i = 0; i < 5; ++i) {
+    std_map.insert({std::to_string(i), std::string(20, 'a' + i)});
+    s21_map.insert({std::to_string(i), std::string(20, 'a' + i)});
+  }
+  auto middle = s21_map.lower_bound("2");
+  auto s21_i = s21_map.erase(middle, middle);
+  ASSERT_EQ((*s21_i).first, "2");
+  s21_i = s21_map.erase(s21_map.end(), s21_map.end());
+  ASSERT_EQ(s21_i, s21_map.end());
+  CompareFlatMaps(std_map, s21_map);
+}
+
+TEST(FlatMap, swap_and_merge) {
+  custom::FlatMap<int, int> s21_map1{{1, 1}, {3, 3}, {5, 5}};
+  custom::FlatMap<int, int> s21_map2{{2, 2}, {3, 30}, {4, 4}};
+  s21_map1.merge(s21_map2);
+  CompareFlatMaps(std::map<int, int>{{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}},
+                  s21_map1);
+  CompareFlatMaps(std::map<int, int>{{3, 30}}, s21_map2);
+  s21_map1.swap(s21_map2);
+  ASSERT_EQ(s21_map1.size(), 1UL);
+  ASSERT_EQ(s21_map2.size(), 5UL);
+}
+
+TEST(FlatMap, move_only) {
+  MoveOnlyCounter::instances = 0;
+  {
+    custom::FlatMap<int, MoveOnlyCounter> s21_map;
+    for (int i = 0; i < 300; ++i)
+      s21_map.try_emplace(i * 7 % 300, i);
+    for (int i = 0; i < 300; i += 3)
+      s21_map.erase(i);
+    ASSERT_EQ(MoveOnlyCounter::instances, static_cast<int>(s21_map.size()));
+    ASSERT_EQ(s21_map.at(1).value, 43);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(FlatMap, iterator_arithmetic) {
+  custom::FlatMap<int, int> s21_map{{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  auto it = s21_map.begin() + 2;
+  ASSERT_EQ((*it).second, 30);
+  ASSERT_EQ(it[1].first, 4);
+  ASSERT_EQ(s21_map.end() - it, 2);
+  custom::FlatMap<int, int>::const_iterator const_it = it;
+  ASSERT_TRUE(const_it > s21_map.begin());
+  std::reverse_iterator<custom::FlatMap<int, int>::iterator> reverse(
+      s21_map.end());
+  ASSERT_EQ((*reverse).first, 4);
+}
+
+TEST(FlatMap, transparent_lookup) {
+  custom::FlatMap<std::string, int, std::less<>> s21_map{
+      {"apple", 1}, {"banana", 2}, {"cherry", 3}};
+  std::string_view key = "banana";
+  ASSERT_EQ((*s21_map.find(key)).second, 2);
+  ASSERT_TRUE(s21_map.contains(std::string_view("cherry")));
+  ASSERT_EQ((*s21_map.lower_bound(std::string_view("b"))).first, "banana");
+  ASSERT_EQ(s21_map.upper_bound(std::string_view("cherry")), s21_map.end());
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../associative_containers/flat_set/custom_flat_set.h"
+
+template <class T>
+void CompareFlatSets(const std::set<T> &std_set,
+                     const custom::FlatSet<T> &s21_set) {
+  ASSERT_EQ(std_set.size(), s21_set.size());
+  auto std_i = std_set.begin();
+  auto s21_i = s21_set.begin();
+  while (std_i != std_set.end() && s21_i != s21_set.end()) {
+    ASSERT_EQ(*std_i, *s21_i);
+    ++std_i;
+    ++s21_i;
+  }
+  ASSERT_EQ(std_i, std_set.end());
+  ASSERT_EQ(s21_i, s21_set.end());
+}
+
+TEST(FlatSet, constructors) {
+  std::vector<int> items{9, 3, 7, 3, 1};
+  std::set<int> std_set(items.begin(), items.end());
+  custom::FlatSet<int> s21_set(items.begin(), items.end());
+  CompareFlatSets(std_set, s21_set);
+  custom::FlatSet<int> s21_list{9, 3, 7, 3, 1};
+  CompareFlatSets(std_set, s21_list);
+  custom::FlatSet<int> s21_copy;
+  s21_copy = s21_set;
+  CompareFlatSets(std_set, s21_copy);
+  custom::FlatSet<int> s21_moved;
+  s21_moved = std::move(s21_copy);
+  CompareFlatSets(std_set, s21_moved);
+}
+
+TEST(FlatSet, insert_and_find) {
+  custom::FlatSet<std::string> s21_set;
+  ASSERT_TRUE(s21_set.insert("b").second);
+  ASSERT_FALSE(s21_set.insert("b").second);
+  ASSERT_TRUE(s21_set.emplace(3UL, 'a').second);
+  ASSERT_EQ(*s21_set.emplace_hint(s21_set.end(), "z"), "z");
+  ASSERT_EQ(*s21_set.insert(s21_set.begin(), "y"), "y");
+  ASSERT_EQ(s21_set.insert({"c", "d", "b", "c"}), 2UL);
+  ASSERT_EQ(*s21_set.find("aaa"), "aaa");
+  ASSERT_EQ(s21_set.find("a"), s21_set.end());
+  ASSERT_TRUE(s21_set.contains("d"));
+  ASSERT_EQ(*s21_set.lower_bound("ca"), "d");
+  ASSERT_EQ(*s21_set.upper_bound("c"), "d");
+  auto range = s21_set.equal_range("c");
+  ASSERT_EQ(*range.first, "c");
+  ASSERT_EQ(*range.second, "d");
+  CompareFlatSets(std::set<std::string>{"aaa", "b", "c", "d", "y", "z"},
+                  s21_set);
+}
+
+TEST(FlatSet, bulk_insert_and_erase) {
+  std::mt19937 generator(13);
+  std::set<int> std_set;
+  custom::FlatSet<int> s21_set;
+  for (int round = 0; round < 20; ++round) {
+    std::vector<int> batch;
+    for (int i = 0; i < 300; ++i)
+      batch.push_back(static_cast<int>(generator() % 4000));
+    std::size_t old_size = std_set.size();
+    std_set.insert(batch.begin(), batch.end());
+    ASSERT_EQ(s21_set.insert(batch.begin(), batch.end()),
+              std_set.size() - old_size);
+    for (int i = 0; i < 50; ++i) {
+      int value = static_cast<int>(generator() % 4000);
+      ASSERT_EQ(std_set.erase(value), s21_set.erase(value));
+    }
+  }
+  CompareFlatSets(std_set, s21_set);
+  auto std_i = std_set.erase(std_set.lower_bound(1000),
+                             std_set.lower_bound(3000));
+  auto s21_i = s21_set.erase(s21_set.lower_bound(1000),
+                             s21_set.lower_bound(3000));
+  ASSERT_EQ(*std_i, *s21_i);
+  CompareFlatSets(std_set, s21_set);
+  auto is_even = [](int value) { return value % 2 == 0; };
+  std::size_t even = 0UL;
+  for (auto i = std_set.begin(); i != std_set.end();)
+    i = is_even(*i) ? (++even, std_set.erase(i)) : std::next(i);
+  ASSERT_EQ(custom::erase_if(s21_set, is_even), even);
+  CompareFlatSets(std_set, s21_set);
+}
+
+TEST(FlatSet, erase_empty_range) {
+  std::set<std::string> std_set;
+  custom::FlatSet<std::string> s21_set;
+  for (int i = 0; i < 5; ++i) {
+    std_set.insert(std::string(20, 'a' + i));
+    s21_set.insert(std::string(20, 'a' + i));
+  }
+  auto middle = s21_set.find(std::string(20, 'c'));
+  auto s21_i = s21_set.erase(middle, middle);
+  ASSERT_EQ(*s21_i, std::string(20, 'c'));
+  s21_i = s21_set.erase(s21_set.begin(), s21_set.begin());
+  ASSERT_EQ(s21_i, s21_set.begin());
+  CompareFlatSets(std_set, s21_set);
+}
+
+TEST(FlatSet, merge) {
+  custom::FlatSet<int> s21_set1{1, 2, 3};
+  custom::FlatSet<int> s21_set2{3, 4, 5};
+  s21_set1.merge(s21_set2);
+  CompareFlatSets(std::set<int>{1, 2, 3, 4, 5}, s21_set1);
+  CompareFlatSets(std::set<int>{3}, s21_set2);
+}
+
+TEST(FlatSet, descending_order_and_transparent_lookup) {
+  custom::FlatSet<int, std::greater<int>> s21_set{1, 5, 3};
+  ASSERT_EQ(*s21_set.begin(), 5);
+  ASSERT_EQ(*s21_set.lower_bound(4), 3);
+  custom::FlatSet<std::string, std::less<>> s21_strings{"a", "b", "c"};
+  ASSERT_TRUE(s21_strings.contains(std::string_view("b")));
+  ASSERT_EQ(*s21_strings.upper_bound(std::string_view("b")), "c");
+}
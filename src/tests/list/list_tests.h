@@ -3,6 +3,7 @@
 #include <list>
 
 #include "../../sequence_containers/list/custom_list.h"
+#include "../move_only_counter.h"
 
 void CompareListInt(custom::List<int> const &result,
                     std::list<int> const &expect) {
@@ -1759,4 +1760,56 @@ TEST(List, emplace_front_1) {
     ASSERT_EQ(*it, i);
     ++i;
   }
-}
\ No newline at end of file
+}
+
+TEST(List, move_only) {
+  {
+    custom::List<MoveOnlyCounter> s21_list1, s21_list2;
+    for (int i = 0; i < 10; ++i) {
+      s21_list1.push_back(MoveOnlyCounter(i * 2));
+      s21_list2.push_front(MoveOnlyCounter(19 - i * 2));
+    }
+    s21_list1.emplace_back(MoveOnlyCounter(100));
+    s21_list1.emplace_front(MoveOnlyCounter(-2), MoveOnlyCounter(-1));
+    s21_list1.insert(s21_list1.end(), MoveOnlyCounter(101));
+    s21_list1.emplace(s21_list1.cbegin(), MoveOnlyCounter(-3));
+    // shadow nodes of both lists hold default constructed values
+    ASSERT_EQ(MoveOnlyCounter::instances, 27);
+    s21_list1.merge(s21_list2);
+    ASSERT_TRUE(s21_list2.empty());
+    ASSERT_EQ(s21_list1.size(), 25UL);
+    int expected = -3;
+    for (auto i = s21_list1.begin(); *i < MoveOnlyCounter(100); ++i)
+      ASSERT_EQ((*i).value, expected++);
+    s21_list2.push_back(MoveOnlyCounter(200));
+    s21_list1.splice(s21_list1.cbegin(), s21_list2);
+    ASSERT_EQ(s21_list1.front().value, 200);
+    ASSERT_EQ(s21_list1.back().value, 101);
+    ASSERT_EQ(s21_list1.size(), 26UL);
+    s21_list1.sort();
+    ASSERT_EQ(s21_list1.back().value, 200);
+    s21_list1.pop_front();
+    ASSERT_EQ(MoveOnlyCounter::instances, 27);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(List, clear_async) {
+  {
+    custom::List<MoveOnlyCounter> s21_list;
+    s21_list.clear_async();
+    for (int i = 0; i < 1000; ++i)
+      s21_list.emplace_back(MoveOnlyCounter(i));
+    s21_list.clear_async();
+    ASSERT_TRUE(s21_list.empty());
+    ASSERT_EQ(s21_list.begin(), s21_list.end());
+    custom::Reclaimer__::instance().wait();
+    // the shadow node holds one more value
+    ASSERT_EQ(MoveOnlyCounter::instances, 1);
+    s21_list.push_back(MoveOnlyCounter(1));
+    s21_list.push_front(MoveOnlyCounter(0));
+    ASSERT_EQ(s21_list.size(), 2UL);
+    ASSERT_EQ(s21_list.back().value, 1);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
@@ -1,9 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "../../associative_containers/map/custom_map.h"
+#include "../move_only_counter.h"
 
 template <class Key, class T>
 void CompareMaps(const std::map<Key, T> &map1, const std::map<Key, T> &map2) {
@@ -25,7 +33,7 @@ template <class Key, class T>
 void CompareMaps(const std::map<Key, T> &map1,
                  const custom::Map<Key, T> &map2) {
   ASSERT_EQ(map1.size(), map2.size());
-  ASSERT_EQ(map1.max_size(), map2.max_size());
+  ASSERT_LE(map1.max_size(), map2.max_size());
   auto i1 = map1.begin();
   auto i2 = map2.begin();
   while (i1 != map1.end() && i2 != map2.end()) {
@@ -42,7 +50,7 @@ template <class Key, class T>
 void CompareMaps(const custom::Map<Key, T> &map1,
                  const std::map<Key, T> &map2) {
   ASSERT_EQ(map1.size(), map2.size());
-  ASSERT_EQ(map1.max_size(), map2.max_size());
+  ASSERT_GE(map1.max_size(), map2.max_size());
   auto i1 = map1.begin();
   auto i2 = map2.begin();
   while (i1 != map1.end() && i2 != map2.end()) {
@@ -271,11 +279,13 @@ private:
 TEST(Map, max_size) {
   std::map<MapTestClass, MapTestClass> std_map1;
   custom::Map<MapTestClass, MapTestClass> s21_map1;
-  ASSERT_EQ(std_map1.max_size(), s21_map1.max_size());
+  // nodes don't keep a reference to the key, so they are never larger than
+  // the nodes of std::map
+  ASSERT_LE(std_map1.max_size(), s21_map1.max_size());
 
   std::map<int, char> std_map2;
   custom::Map<int, char> s21_map2;
-  ASSERT_EQ(std_map2.max_size(), s21_map2.max_size());
+  ASSERT_LE(std_map2.max_size(), s21_map2.max_size());
 }
 
 TEST(Map, clear) {
@@ -422,12 +432,12 @@ TEST(Map, contains) {
     ASSERT_EQ(s21_map.contains(i.first), true);
 }
 
-TEST(Map, emplace) {
-  // * std::map emplace function behavior differs completely
+TEST(Map, insert_many) {
+  // * std::map has no insert_many function
   custom::Map<int, int> s21_map;
   custom::Map<int, int> compare{{1, 2},   {2, 3},   {3, 2},  {4, 4},
                                 {88, 88}, {88, 87}, {88, 86}};
-  auto emplace_result = s21_map.emplace(
+  auto emplace_result = s21_map.insert_many(
       std::pair{1, 2}, std::pair{2, 3}, std::pair{3, 2}, std::pair{4, 4},
       std::pair{88, 88}, std::pair{88, 87}, std::pair{88, 86});
   CompareMaps(s21_map, compare);
@@ -440,4 +450,588 @@ TEST(Map, emplace) {
 
   ASSERT_EQ(emplace_result[emplace_result.size() - 1].second, false);
   ASSERT_EQ(emplace_result[emplace_result.size() - 2].second, false);
-}
\ No newline at end of file
+}
+TEST(Map, height_after_ascending_insert) {
+  custom::Map<int, int>::binary_tree tree;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 10000; ++i) {
+    tree.insert({i, -i});
+    std_map.insert({i, -i});
+  }
+  ASSERT_LE(static_cast<double>(tree.height()),
+            2.0 * std::log2(static_cast<double>(tree.size()) + 1.0));
+  auto std_i = std_map.begin();
+  for (auto i = tree.begin(); i != tree.end(); ++i, ++std_i)
+    ASSERT_EQ((*i).second, std_i->second);
+}
+
+// Pools of every node type fail to create a node once the budget runs out,
+// the negative budget is unlimited
+struct PoolBudget {
+  inline static int budget = -1;
+};
+
+template <class Node>
+struct LimitedPool : custom::NodePool__<Node>, PoolBudget {
+  template <class... Args> Node *create(Args &&...args) {
+    if (budget == 0)
+      throw std::bad_alloc();
+    --budget;
+    return custom::NodePool__<Node>::create(std::forward<Args>(args)...);
+  }
+};
+
+TEST(Map, merge_keeps_other_on_failure) {
+  using limited_map =
+      custom::Map<int, std::string, std::less<int>, LimitedPool>;
+  limited_map s21_map, s21_other;
+  for (int i = 0; i < 100; ++i) {
+    s21_map.insert(i * 2, std::to_string(i * 2));
+    s21_other.insert(i * 2 + 1, std::string(40UL, 'a' + i % 26));
+  }
+  // the other tree is as large as this one, so it is merged by the rebuild
+  // that recreates the nodes in the pool of this tree
+  PoolBudget::budget = 50;
+  ASSERT_THROW(s21_map.merge(s21_other), std::bad_alloc);
+  PoolBudget::budget = -1;
+  ASSERT_EQ(s21_map.size(), 100UL);
+  ASSERT_EQ(s21_other.size(), 100UL);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(s21_map.at(i * 2), std::to_string(i * 2));
+    ASSERT_EQ(s21_other.at(i * 2 + 1), std::string(40UL, 'a' + i % 26));
+  }
+  s21_map.merge(s21_other);
+  ASSERT_EQ(s21_map.size(), 200UL);
+  ASSERT_TRUE(s21_other.empty());
+}
+
+TEST(Map, node_pool) {
+  using pool_map =
+      custom::Map<int, std::string, std::less<int>, custom::NodePool__>;
+  std::map<int, std::string> std_map;
+  pool_map s21_map;
+  for (int i = 0; i < 1000; ++i) {
+    std_map.insert({i, std::to_string(i)});
+    s21_map.insert(i, std::to_string(i));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    std_map.erase(i);
+    s21_map.erase(i);
+  }
+  for (int i = 0; i < 500; i += 3) {
+    std_map[i] = "again";
+    s21_map[i] = "again";
+  }
+  ASSERT_EQ(std_map.size(), s21_map.size());
+  auto std_i = std_map.begin();
+  for (auto i = s21_map.begin(); i != s21_map.end(); ++i, ++std_i) {
+    ASSERT_EQ((*i).first, std_i->first);
+    ASSERT_EQ((*i).second, std_i->second);
+  }
+
+  pool_map s21_other;
+  s21_other.insert(-1, "minus one");
+  s21_other.insert(1, "duplicate");
+  s21_map.merge(s21_other);
+  ASSERT_EQ(s21_map.size(), std_map.size() + 1UL);
+  ASSERT_EQ(s21_map.at(-1), "minus one");
+  ASSERT_EQ(s21_map.at(1), "1");
+  ASSERT_EQ(s21_other.size(), 1UL);
+  ASSERT_EQ(s21_other.at(1), "duplicate");
+
+  pool_map s21_moved(std::move(s21_map));
+  ASSERT_EQ(s21_moved.size(), std_map.size() + 1UL);
+  s21_moved.clear();
+  ASSERT_TRUE(s21_moved.empty());
+  s21_moved.insert(5, "five");
+  ASSERT_EQ(s21_moved.at(5), "five");
+}
+
+TEST(Map, range_constructor) {
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 1000; ++i)
+    std_map[(i * 13) % 1000] = std::to_string(i);
+  custom::Map<int, std::string> s21_map(std_map.begin(), std_map.end());
+  CompareMaps(s21_map, std_map);
+
+  std::vector<std::pair<const int, std::string>> values{
+      {3, "three"}, {1, "one"}, {3, "again"}, {2, "two"}};
+  s21_map.assign(values.begin(), values.end());
+  CompareMaps(s21_map,
+              std::map<int, std::string>(values.begin(), values.end()));
+}
+
+TEST(Map, copy_keeps_shape) {
+  custom::Map<int, std::string> s21_map1;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 3000; ++i) {
+    s21_map1.insert(i, std::to_string(i));
+    std_map.insert({i, std::to_string(i)});
+  }
+  custom::Map<int, std::string> s21_map2(s21_map1);
+  CompareMaps(s21_map2, std_map);
+  CompareMaps(s21_map1, s21_map2);
+
+  custom::Map<int, std::string, std::less<int>, custom::NodePool__> s21_map3(
+      std_map.begin(), std_map.end());
+  auto s21_map4 = s21_map3;
+  s21_map3.clear();
+  ASSERT_EQ(s21_map4.size(), std_map.size());
+  auto std_i = std_map.begin();
+  for (auto i = s21_map4.begin(); i != s21_map4.end(); ++i, ++std_i)
+    ASSERT_EQ((*i).second, std_i->second);
+
+  custom::Map<int, std::string>::binary_tree tree1, tree2;
+  for (int i = 0; i < 1000; ++i)
+    tree1.insert({i, std::to_string(i)});
+  tree2 = tree1;
+  ASSERT_EQ(tree1.height(), tree2.height());
+  ASSERT_EQ(tree1.size(), tree2.size());
+  tree2 = tree2;
+  ASSERT_EQ(tree1.size(), tree2.size());
+}
+
+TEST(Map, reverse_iteration) {
+  custom::Map<int, std::string, std::less<int>, custom::NodePool__> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 500; ++i) {
+    int key = (i * 7) % 500;
+    s21_map.insert(key, std::to_string(i));
+    std_map.insert({key, std::to_string(i)});
+  }
+  auto std_i = std_map.rbegin();
+  auto s21_i = s21_map.end();
+  while (s21_i != s21_map.begin()) {
+    --s21_i;
+    ASSERT_EQ((*s21_i).first, std_i->first);
+    ASSERT_EQ((*s21_i).second, std_i->second);
+    ++std_i;
+  }
+  ASSERT_TRUE(std_i == std_map.rend());
+}
+
+TEST(Map, iterator_is_one_pointer) {
+  using map_type = custom::Map<int, std::string>;
+  ASSERT_EQ(sizeof(map_type::iterator), sizeof(void *));
+  ASSERT_EQ(sizeof(map_type::const_iterator), sizeof(void *));
+  ASSERT_TRUE(std::is_trivially_copyable<map_type::iterator>::value);
+  ASSERT_TRUE(std::is_trivially_copyable<map_type::const_iterator>::value);
+}
+
+TEST(Map, percentile) {
+  custom::Map<int, std::string, std::less<int>, custom::NodeAllocator__, true>
+      s21_map;
+  for (int i = 0; i < 1000; ++i)
+    s21_map.insert((i * 389) % 1000, std::to_string(i));
+  ASSERT_EQ((*s21_map.nth(990)).first, 990);
+  (*s21_map.nth(500)).second = "median";
+  ASSERT_EQ(s21_map.at(500), "median");
+  const auto &s21_const = s21_map;
+  ASSERT_EQ((*s21_const.nth(0)).first, 0);
+  ASSERT_TRUE(s21_const.nth(1000) == s21_const.end());
+  ASSERT_EQ(s21_map.rank(250), 250UL);
+  s21_map.erase(100);
+  ASSERT_EQ(s21_map.rank(250), 249UL);
+  ASSERT_EQ(s21_map.count_range(0, 200), 199UL);
+}
+
+TEST(Map, range_scan) {
+  custom::Map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    s21_map.insert(i * 10, std::to_string(i));
+    std_map.insert({i * 10, std::to_string(i)});
+  }
+  auto std_i = std_map.lower_bound(2005);
+  for (auto i = s21_map.lower_bound(2005); i != s21_map.lower_bound(3000);
+       ++i, ++std_i)
+    ASSERT_EQ((*i).second, std_i->second);
+  ASSERT_TRUE(std_i == std_map.lower_bound(3000));
+
+  (*s21_map.upper_bound(500)).second = "changed";
+  ASSERT_EQ(s21_map.at(510), "changed");
+  const auto &s21_const = s21_map;
+  auto s21_range = s21_const.equal_range(700);
+  ASSERT_EQ((*s21_range.first).first, 700);
+  ASSERT_EQ((*s21_range.second).first, 710);
+  ASSERT_TRUE(s21_const.upper_bound(9990) == s21_const.end());
+}
+
+TEST(Map, emplace_hint) {
+  custom::Map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    auto s21_i = s21_map.emplace_hint(s21_map.end(), i * 2, std::to_string(i));
+    ASSERT_EQ((*s21_i).first, i * 2);
+    std_map.emplace_hint(std_map.end(), i * 2, std::to_string(i));
+  }
+  auto s21_i = s21_map.insert(s21_map.find(100), {101, "odd"});
+  std_map.insert({101, "odd"});
+  ASSERT_EQ((*s21_i).second, "odd");
+  s21_i = s21_map.insert(s21_map.begin(), {100, "ignored"});
+  ASSERT_EQ((*s21_i).second, "50");
+  CompareMaps(s21_map, std_map);
+
+  auto s21_found = s21_map.find(s21_map.find(100), 106);
+  (*s21_found).second = "found";
+  ASSERT_EQ(s21_map.at(106), "found");
+  ASSERT_TRUE(s21_map.find(s21_map.find(100), 107) == s21_map.end());
+}
+
+struct CopyCounter {
+  CopyCounter() = default;
+  CopyCounter(const CopyCounter &other) : value(other.value) { ++copies; }
+  CopyCounter(CopyCounter &&other) noexcept : value(other.value) {}
+  CopyCounter &operator=(const CopyCounter &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  CopyCounter &operator=(CopyCounter &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  int value = 0;
+  static int copies;
+};
+
+int CopyCounter::copies = 0;
+
+TEST(Map, node_handle) {
+  custom::Map<int, CopyCounter> s21_map1, s21_map2;
+  for (int i = 0; i < 100; ++i)
+    s21_map1[i].value = i;
+  CopyCounter::copies = 0;
+  for (int i = 0; i < 100; i += 2) {
+    auto handle = s21_map1.extract(i);
+    ASSERT_FALSE(handle.empty());
+    ASSERT_EQ(handle.key(), i);
+    handle.value().second.value *= 10;
+    auto result = s21_map2.insert(std::move(handle));
+    ASSERT_TRUE(result.inserted);
+    ASSERT_TRUE(result.node.empty());
+    ASSERT_EQ((*result.position).second.value, i * 10);
+  }
+  ASSERT_EQ(CopyCounter::copies, 0);
+  ASSERT_EQ(s21_map1.size(), 50UL);
+  ASSERT_EQ(s21_map2.size(), 50UL);
+  ASSERT_TRUE(s21_map1.extract(0).empty());
+
+  s21_map2[1].value = -1;
+  auto result = s21_map2.insert(s21_map1.extract(s21_map1.find(1)));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ((*result.position).second.value, -1);
+  ASSERT_EQ(result.node.value().second.value, 1);
+  ASSERT_FALSE(s21_map1.contains(1));
+
+  auto empty_result = s21_map2.insert(std::move(result.node));
+  ASSERT_TRUE(empty_result.inserted == false);
+  ASSERT_EQ(s21_map2.size(), 51UL);
+}
+
+TEST(Map, node_handle_between_pools) {
+  using pool_map = custom::Map<int, std::string, std::less<int>,
+                               custom::NodePool__, true>;
+  pool_map s21_map1, s21_map2;
+  for (int i = 0; i < 300; ++i)
+    s21_map1.insert(i, std::to_string(i));
+  for (int i = 0; i < 300; i += 3)
+    s21_map2.insert(s21_map1.extract(i));
+  ASSERT_EQ(s21_map1.size(), 200UL);
+  ASSERT_EQ(s21_map2.size(), 100UL);
+  ASSERT_EQ((*s21_map2.nth(10)).second, "30");
+  ASSERT_EQ(s21_map1.rank(30), 20UL);
+  {
+    auto dropped = s21_map1.extract(s21_map1.begin());
+    ASSERT_EQ(dropped.key(), 1);
+  }
+  ASSERT_EQ((*s21_map1.begin()).first, 2);
+}
+
+TEST(Map, node_handle_outlives_pool) {
+  using pool_map =
+      custom::Map<int, std::string, std::less<int>, custom::NodePool__>;
+  pool_map::node_type handle;
+  {
+    pool_map s21_source;
+    for (int i = 0; i < 100; ++i)
+      s21_source.insert(i, std::string(30, 'a' + i % 26));
+    handle = s21_source.extract(5);
+  }
+  ASSERT_EQ(handle.key(), 5);
+  ASSERT_EQ(handle.value().second, std::string(30, 'f'));
+
+  pool_map s21_moved_from{{1, "one"}, {2, "two"}};
+  auto moved_handle = s21_moved_from.extract(1);
+  pool_map s21_moved_to(std::move(s21_moved_from));
+  pool_map s21_swapped{{3, "three"}};
+  auto swapped_handle = s21_swapped.extract(3);
+  s21_swapped.swap(s21_moved_to);
+  auto cleared_handle = s21_swapped.extract(2);
+  s21_swapped.clear_async();
+
+  // the target shares no pool with any of the sources
+  pool_map s21_target;
+  ASSERT_TRUE(s21_target.insert(std::move(handle)).inserted);
+  ASSERT_TRUE(s21_target.insert(std::move(moved_handle)).inserted);
+  ASSERT_TRUE(s21_target.insert(std::move(swapped_handle)).inserted);
+  ASSERT_EQ(s21_target.size(), 3UL);
+  ASSERT_EQ(s21_target.at(1), "one");
+  ASSERT_EQ(s21_target.at(3), "three");
+  ASSERT_EQ(s21_target.at(5), std::string(30, 'f'));
+  ASSERT_TRUE(handle.empty());
+  // the last handle is destroyed with its node after all the pools are gone
+  ASSERT_EQ(cleared_handle.value().second, "two");
+}
+
+struct ConstructionCounter {
+  ConstructionCounter() { ++constructions; }
+  explicit ConstructionCounter(int new_value) : value(new_value) {
+    ++constructions;
+  }
+  ConstructionCounter(const ConstructionCounter &other) : value(other.value) {
+    ++constructions;
+  }
+  ~ConstructionCounter() { ++destructions; }
+
+  int value = 0;
+  static int constructions;
+  static int destructions;
+};
+
+int ConstructionCounter::constructions = 0;
+int ConstructionCounter::destructions = 0;
+
+TEST(Map, try_emplace) {
+  custom::Map<std::string, ConstructionCounter> s21_map;
+  ConstructionCounter::constructions = ConstructionCounter::destructions = 0;
+  for (int i = 0; i < 100; ++i)
+    s21_map[std::to_string(i % 10)].value++;
+  ASSERT_EQ(ConstructionCounter::constructions, 10);
+  ASSERT_EQ(ConstructionCounter::destructions, 0);
+  ASSERT_EQ(s21_map["7"].value, 10);
+
+  auto result = s21_map.try_emplace("7", 100);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ((*result.first).second.value, 10);
+  result = s21_map.try_emplace("a", 100);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ((*result.first).second.value, 100);
+  ASSERT_EQ(ConstructionCounter::constructions, 11);
+  ASSERT_EQ(ConstructionCounter::destructions, 0);
+  ASSERT_EQ(s21_map.size(), 11UL);
+}
+
+TEST(Map, emplace_single) {
+  custom::Map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 100; ++i) {
+    auto s21_result = s21_map.emplace(i % 30, std::string(3UL, 'a' + i % 26));
+    auto std_result = std_map.emplace(i % 30, std::string(3UL, 'a' + i % 26));
+    ASSERT_EQ(s21_result.second, std_result.second);
+    ASSERT_EQ((*s21_result.first).second, std_result.first->second);
+  }
+  auto s21_result =
+      s21_map.emplace(std::piecewise_construct, std::forward_as_tuple(100),
+                      std::forward_as_tuple("abc"));
+  std_map.emplace(100, "abc");
+  ASSERT_TRUE(s21_result.second);
+  CompareMaps(s21_map, std_map);
+}
+
+TEST(Map, insert_move) {
+  using key_type = std::vector<int>;
+  custom::Map<key_type, CopyCounter> s21_map;
+  CopyCounter::copies = 0;
+  key_type key(100, 1);
+  ASSERT_TRUE(s21_map.insert(std::move(key), CopyCounter()).second);
+  ASSERT_TRUE(key.empty());
+  key.assign(100, 1);
+  ASSERT_FALSE(s21_map.insert(std::move(key), CopyCounter()).second);
+  ASSERT_EQ(key.size(), 100UL);
+
+  CopyCounter counter;
+  counter.value = 5;
+  auto result = s21_map.insert_or_assign(key, std::move(counter));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ((*result.first).second.value, 5);
+  result = s21_map.insert_or_assign(key_type(3, 3), CopyCounter());
+  ASSERT_TRUE(result.second);
+  s21_map[key_type(4, 4)].value = 4;
+  using value_type = std::pair<const key_type, CopyCounter>;
+  s21_map.insert(value_type(key_type(5, 5), CopyCounter()));
+  s21_map.insert(s21_map.end(), value_type(key_type(6, 6), CopyCounter()));
+  ASSERT_EQ(CopyCounter::copies, 0);
+  ASSERT_EQ(s21_map.size(), 5UL);
+  ASSERT_EQ(s21_map.at(key_type(4, 4)).value, 4);
+}
+
+TEST(Map, clear_destroys_every_value) {
+  using pool_map =
+      custom::Map<int, MoveOnlyCounter, std::less<int>, custom::NodePool__>;
+  {
+    custom::Map<int, MoveOnlyCounter> s21_map;
+    pool_map s21_pool_map;
+    for (int i = 0; i < 1 << 16; ++i) {
+      s21_map.try_emplace(i, i);
+      s21_pool_map.try_emplace(i, i);
+    }
+    ASSERT_EQ(MoveOnlyCounter::instances, 2 << 16);
+    s21_map.clear();
+    ASSERT_EQ(MoveOnlyCounter::instances, 1 << 16);
+    s21_pool_map.clear();
+    ASSERT_EQ(MoveOnlyCounter::instances, 0);
+    ASSERT_TRUE(s21_map.empty());
+    ASSERT_TRUE(s21_pool_map.empty());
+    s21_pool_map.try_emplace(1, 1);
+    s21_map.try_emplace(2, 2);
+    ASSERT_EQ(s21_pool_map.at(1).value, 1);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(Map, clear_async) {
+  using pool_map =
+      custom::Map<int, MoveOnlyCounter, std::less<int>, custom::NodePool__>;
+  {
+    custom::Map<int, MoveOnlyCounter> s21_map;
+    pool_map s21_pool_map;
+    s21_map.clear_async();
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < 1000; ++i) {
+        s21_map.try_emplace(i, i);
+        s21_pool_map.try_emplace(i, i);
+      }
+      s21_map.clear_async();
+      s21_pool_map.clear_async();
+      ASSERT_TRUE(s21_map.empty());
+      ASSERT_TRUE(s21_pool_map.empty());
+      ASSERT_EQ(s21_pool_map.begin(), s21_pool_map.end());
+      custom::Reclaimer__::instance().wait();
+      ASSERT_EQ(MoveOnlyCounter::instances, 0);
+    }
+    s21_map.try_emplace(1, 1);
+    s21_pool_map.try_emplace(2, 2);
+    ASSERT_EQ(s21_map.at(1).value, 1);
+    ASSERT_EQ(s21_pool_map.at(2).value, 2);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(Map, move_only) {
+  {
+    custom::Map<int, MoveOnlyCounter> s21_map;
+    for (int i = 0; i < 100; ++i)
+      s21_map.insert(i, MoveOnlyCounter(i));
+    s21_map[100].value = 100;
+    s21_map.try_emplace(101, 101);
+    s21_map.emplace(102, MoveOnlyCounter(102));
+    s21_map.insert_or_assign(0, MoveOnlyCounter(-1));
+    s21_map.insert(std::pair<const int, MoveOnlyCounter>(103, 103));
+    s21_map.erase(50);
+    ASSERT_EQ(MoveOnlyCounter::instances, 103);
+    custom::Map<int, MoveOnlyCounter> s21_other;
+    s21_other.insert(s21_map.extract(1));
+    s21_other.merge(s21_map);
+    ASSERT_EQ(s21_other.size(), 103UL);
+    ASSERT_EQ(s21_other.at(0).value, -1);
+    ASSERT_EQ(s21_other.at(103).value, 103);
+    custom::Map<int, MoveOnlyCounter> s21_moved(std::move(s21_other));
+    ASSERT_EQ(s21_moved.size(), 103UL);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+
+  custom::Map<std::string, std::unique_ptr<int>> s21_pointers;
+  s21_pointers["a"] = std::make_unique<int>(1);
+  s21_pointers.insert("b", std::make_unique<int>(2));
+  ASSERT_EQ(*s21_pointers["a"] + *s21_pointers.at("b"), 3);
+}
+
+TEST(Map, insert_range) {
+  custom::Map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 500; ++i) {
+    s21_map.insert(i * 2, "old");
+    std_map.insert({i * 2, "old"});
+  }
+  std::vector<std::pair<int, std::string>> batch{
+      {3, "new"}, {4, "new"}, {3, "repeated"}, {1001, "new"}};
+  ASSERT_EQ(s21_map.insert(batch.begin(), batch.end()), 2UL);
+  std_map.insert(batch.begin(), batch.end());
+  CompareMaps(s21_map, std_map);
+  ASSERT_EQ(s21_map.insert({{-1, "a"}, {0, "b"}, {2000, "c"}}), 2UL);
+  std_map.insert({{-1, "a"}, {0, "b"}, {2000, "c"}});
+  CompareMaps(s21_map, std_map);
+  ASSERT_EQ(s21_map.insert(std_map.begin(), std_map.end()), 0UL);
+  custom::Map<int, std::string> s21_copy;
+  ASSERT_EQ(s21_copy.insert(std_map.begin(), std_map.end()), std_map.size());
+  CompareMaps(s21_copy, std_map);
+}
+
+TEST(Map, erase_range_and_if) {
+  custom::Map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    s21_map.insert(i, std::to_string(i));
+    std_map.insert({i, std::to_string(i)});
+  }
+  auto s21_i = s21_map.erase(s21_map.find(10), s21_map.find(900));
+  std_map.erase(std_map.find(10), std_map.find(900));
+  ASSERT_EQ((*s21_i).first, 900);
+  CompareMaps(s21_map, std_map);
+  ASSERT_EQ(s21_map.erase(5), 1UL);
+  ASSERT_EQ(s21_map.erase(5), 0UL);
+  std_map.erase(5);
+  auto has_two_digits = [](const std::pair<const int, std::string> &item) {
+    return item.second.size() == 2UL;
+  };
+  ASSERT_EQ(custom::erase_if(s21_map, has_two_digits), 0UL);
+  ASSERT_EQ(custom::erase_if(s21_map, [](const auto &item) {
+              return item.first % 10 == 0;
+            }),
+            11UL);
+  for (auto i = std_map.begin(); i != std_map.end();)
+    i = (*i).first % 10 == 0 ? std_map.erase(i) : std::next(i);
+  CompareMaps(s21_map, std_map);
+}
+
+TEST(Map, split_and_join) {
+  custom::Map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 1000; ++i) {
+    s21_map.insert(i, std::to_string(i));
+    std_map.insert({i, std::to_string(i)});
+  }
+  custom::Map<int, std::string> s21_greater = s21_map.split(600);
+  ASSERT_EQ(s21_map.size(), 600UL);
+  ASSERT_EQ(s21_greater.size(), 400UL);
+  ASSERT_EQ(s21_greater.at(600), "600");
+  ASSERT_FALSE(s21_map.contains(600));
+  s21_greater[2000] = "2000";
+  std_map[2000] = "2000";
+  s21_map.join(s21_greater);
+  CompareMaps(s21_map, std_map);
+  custom::Map<int, std::string> s21_overlap{{1500, "1500"}};
+  ASSERT_THROW(s21_map.join(s21_overlap), std::invalid_argument);
+  ASSERT_EQ(s21_overlap.size(), 1UL);
+}
+
+TEST(Map, transparent_lookup) {
+  custom::Map<std::string, int, std::less<>> s21_map{
+      {"apple", 1}, {"banana", 2}, {"cherry", 3}};
+  std::string_view banana = "banana";
+  ASSERT_EQ((*s21_map.find(banana)).second, 2);
+  ASSERT_EQ((*s21_map.find("cherry")).second, 3);
+  ASSERT_EQ(s21_map.find("date"), s21_map.end());
+  ASSERT_TRUE(s21_map.contains("apple"));
+  ASSERT_FALSE(s21_map.contains(std::string_view("apricot")));
+  ASSERT_EQ((*s21_map.lower_bound("b")).first, "banana");
+  ASSERT_EQ((*s21_map.upper_bound("banana")).first, "cherry");
+  auto range = s21_map.equal_range(std::string_view("cherry"));
+  ASSERT_EQ((*range.first).second, 3);
+  ASSERT_EQ(range.second, s21_map.end());
+  const auto &s21_const_map = s21_map;
+  ASSERT_EQ((*s21_const_map.find("apple")).second, 1);
+  ASSERT_EQ(s21_map.find(std::string("banana")), s21_map.find(banana));
+}
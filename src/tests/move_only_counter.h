@@ -0,0 +1,42 @@
+#ifndef _TESTS_MOVE_ONLY_COUNTER_H_
+#define _TESTS_MOVE_ONLY_COUNTER_H_
+
+// Element type that can't be copied and counts its alive instances, so tests
+// can check that containers neither copy nor leak their elements
+struct MoveOnlyCounter {
+  explicit MoveOnlyCounter(int new_value = 0) : value(new_value) {
+    ++instances;
+  }
+  MoveOnlyCounter(const MoveOnlyCounter &other) = delete;
+  MoveOnlyCounter(MoveOnlyCounter &&other) noexcept : value(other.value) {
+    ++instances;
+  }
+  ~MoveOnlyCounter() { --instances; }
+
+  MoveOnlyCounter &operator=(const MoveOnlyCounter &other) = delete;
+  MoveOnlyCounter &operator=(MoveOnlyCounter &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  bool operator<(const MoveOnlyCounter &other) const {
+    return value < other.value;
+  }
+  bool operator<=(const MoveOnlyCounter &other) const {
+    return value <= other.value;
+  }
+  bool operator>(const MoveOnlyCounter &other) const {
+    return value > other.value;
+  }
+  bool operator==(const MoveOnlyCounter &other) const {
+    return value == other.value;
+  }
+  bool operator!=(const MoveOnlyCounter &other) const {
+    return value != other.value;
+  }
+
+  int value;
+  inline static int instances = 0;
+};
+
+#endif // _TESTS_MOVE_ONLY_COUNTER_H_
@@ -1,14 +1,22 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "../../associative_containers/multiset/custom_multiset.h"
+#include "../move_only_counter.h"
 
 template <class T>
 void CompareMultisets(const std::multiset<T> &std_multiset,
                       const custom::Multiset<T> &s21_multiset) {
   ASSERT_EQ(std_multiset.size(), s21_multiset.size());
-  ASSERT_EQ(std_multiset.max_size(), s21_multiset.max_size());
+  ASSERT_LE(std_multiset.max_size(), s21_multiset.max_size());
   auto std_i = std_multiset.begin();
   auto s21_i = s21_multiset.begin();
   while (std_i != std_multiset.end() && s21_i != s21_multiset.end()) {
@@ -24,7 +32,7 @@ template <class T>
 void CompareMultisets(const custom::Multiset<T> &s21_multiset,
                       const std::multiset<T> &std_multiset) {
   ASSERT_EQ(std_multiset.size(), s21_multiset.size());
-  ASSERT_EQ(std_multiset.max_size(), s21_multiset.max_size());
+  ASSERT_LE(std_multiset.max_size(), s21_multiset.max_size());
   auto std_i = std_multiset.begin();
   auto s21_i = s21_multiset.begin();
   while (std_i != std_multiset.end() && s21_i != s21_multiset.end()) {
@@ -345,12 +353,12 @@ TEST(Multiset, contains) {
     ASSERT_EQ(s21_multiset.contains(i), true);
 }
 
-TEST(Multiset, emplace) {
-  // * emplace behavior in std::multiset differs completely
+TEST(Multiset, insert_many) {
+  // * std::multiset has no insert_many function
   custom::Multiset<int> s21_multiset;
   custom::Multiset<int> compare{1, 2, 3, 4, 5, 6, 6, 5, 4, 3, 2, 1};
   auto emplace_result =
-      s21_multiset.emplace(1, 2, 3, 4, 5, 6, 6, 5, 4, 3, 2, 1);
+      s21_multiset.insert_many(1, 2, 3, 4, 5, 6, 6, 5, 4, 3, 2, 1);
   CompareMultisets(s21_multiset, compare);
   for (auto &i : emplace_result)
     ASSERT_EQ(i.second, true);
@@ -361,7 +369,7 @@ TEST(Multiset, emplace) {
       {1, true}, {1, true}, {2, true},  {2, true}, {3, true}, {3, true},
       {4, true}, {4, true}, {-5, true}, {6, true}, {-5, true}};
   auto pair_compare_iterator = pair_compare.begin();
-  emplace_result = s21_multiset.emplace(1, 1, 2, 2, 3, 3, 4, 4, -5, 6, -5);
+  emplace_result = s21_multiset.insert_many(1, 1, 2, 2, 3, 3, 4, 4, -5, 6, -5);
   CompareMultisets(s21_multiset, compare);
   for (auto &i : emplace_result) {
     ASSERT_EQ(*i.first, (*pair_compare_iterator).first);
@@ -418,4 +426,367 @@ TEST(Multiset, upper_bound) {
     --std_upper_bound_result;
     --s21_upper_bound_result;
   }
-}
\ No newline at end of file
+}
+TEST(Multiset, height_after_repeated_insert) {
+  custom::Multiset<int>::binary_tree tree;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 3000; ++i) {
+    tree.insert(i / 10, true);
+    tree.insert(7, true);
+    std_multiset.insert(i / 10);
+    std_multiset.insert(7);
+  }
+  ASSERT_LE(static_cast<double>(tree.height()),
+            2.0 * std::log2(static_cast<double>(tree.size()) + 1.0));
+  ASSERT_EQ(tree.size(), std_multiset.size());
+  auto std_i = std_multiset.begin();
+  for (auto i = tree.begin(); i != tree.end(); ++i, ++std_i)
+    ASSERT_EQ(*i, *std_i);
+}
+
+TEST(Multiset, count_after_rebalancing) {
+  std::multiset<int> std_multiset;
+  custom::Multiset<int> s21_multiset;
+  for (int i = 0; i < 500; ++i) {
+    std_multiset.insert(i % 7);
+    s21_multiset.insert(i % 7);
+  }
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_EQ(std_multiset.count(i), s21_multiset.count(i));
+    if (std_multiset.count(i)) {
+      ASSERT_EQ(*std_multiset.lower_bound(i), *s21_multiset.lower_bound(i));
+      ASSERT_EQ(*(--std_multiset.lower_bound(i + 1)),
+                *(--s21_multiset.upper_bound(i)));
+    }
+  }
+}
+
+TEST(Multiset, node_pool) {
+  using pool_multiset =
+      custom::Multiset<int, std::less<int>, custom::NodePool__>;
+  std::multiset<int> std_multiset;
+  pool_multiset s21_multiset1, s21_multiset2;
+  for (int i = 0; i < 2000; ++i) {
+    std_multiset.insert(i % 100);
+    s21_multiset1.insert(i % 100);
+    s21_multiset2.insert(i % 10);
+  }
+  s21_multiset1.merge(s21_multiset2);
+  for (int i = 0; i < 2000; ++i)
+    std_multiset.insert(i % 10);
+  ASSERT_TRUE(s21_multiset2.empty());
+  ASSERT_EQ(std_multiset.size(), s21_multiset1.size());
+  auto std_i = std_multiset.begin();
+  for (auto i = s21_multiset1.begin(); i != s21_multiset1.end(); ++i, ++std_i)
+    ASSERT_EQ(*i, *std_i);
+  ASSERT_EQ(s21_multiset1.count(5), std_multiset.count(5));
+}
+
+TEST(Multiset, range_constructor) {
+  std::vector<int> values;
+  for (int i = 0; i < 3000; ++i)
+    values.push_back((i * 31) % 97);
+  std::multiset<int> std_multiset(values.begin(), values.end());
+  custom::Multiset<int> s21_multiset(values.begin(), values.end());
+  CompareMultisets(s21_multiset, std_multiset);
+
+  std::multiset<int> std_copy;
+  custom::Multiset<int> s21_copy;
+  std_copy = std_multiset;
+  s21_copy = s21_multiset;
+  CompareMultisets(s21_copy, std_copy);
+
+  s21_copy.assign(std_multiset.begin(), std_multiset.end());
+  CompareMultisets(s21_copy, std_multiset);
+  ASSERT_EQ(s21_copy.count(13), std_multiset.count(13));
+}
+
+TEST(Multiset, ranked_count) {
+  custom::Multiset<int, std::less<int>, custom::NodePool__, true> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 2000; ++i) {
+    s21_multiset.insert(i % 17);
+    std_multiset.insert(i % 17);
+  }
+  for (int i = 0; i < 500; ++i) {
+    s21_multiset.erase(s21_multiset.find(i % 5));
+    std_multiset.erase(std_multiset.find(i % 5));
+  }
+  for (int key = -1; key < 18; ++key) {
+    ASSERT_EQ(s21_multiset.count(key), std_multiset.count(key));
+    ASSERT_EQ(s21_multiset.rank(key),
+              static_cast<std::size_t>(std::distance(
+                  std_multiset.begin(), std_multiset.lower_bound(key))));
+  }
+  ASSERT_EQ(s21_multiset.count_range(3, 8),
+            static_cast<std::size_t>(std::distance(
+                std_multiset.lower_bound(3), std_multiset.lower_bound(8))));
+  ASSERT_EQ(*s21_multiset.nth(0), 0);
+  ASSERT_EQ(*s21_multiset.nth(s21_multiset.size() - 1), 16);
+}
+
+TEST(Multiset, equal_range_bounds) {
+  custom::Multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 1000; ++i) {
+    s21_multiset.insert((i * 13) % 40);
+    std_multiset.insert((i * 13) % 40);
+  }
+  for (int key = -1; key <= 40; ++key) {
+    auto s21_range = s21_multiset.equal_range(key);
+    auto std_range = std_multiset.equal_range(key);
+    ASSERT_EQ(std::distance(s21_range.first, s21_range.second),
+              std::distance(std_range.first, std_range.second));
+    ASSERT_TRUE(s21_range.first == s21_multiset.lower_bound(key));
+    ASSERT_TRUE(s21_range.second == s21_multiset.upper_bound(key));
+    for (auto i = s21_range.first; i != s21_range.second; ++i)
+      ASSERT_EQ(*i, key);
+    ASSERT_EQ(s21_multiset.count(key), std_multiset.count(key));
+  }
+}
+
+TEST(Multiset, insert_with_hint) {
+  custom::Multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 1000; ++i) {
+    s21_multiset.insert(s21_multiset.end(), i / 3);
+    std_multiset.insert(std_multiset.end(), i / 3);
+  }
+  for (int i = 0; i < 300; ++i) {
+    auto s21_i = s21_multiset.insert(s21_multiset.find(i), i % 50);
+    ASSERT_EQ(*s21_i, i % 50);
+    std_multiset.insert(i % 50);
+  }
+  s21_multiset.emplace_hint(s21_multiset.begin(), 1000);
+  std_multiset.insert(1000);
+  CompareMultisets(s21_multiset, std_multiset);
+  ASSERT_EQ(s21_multiset.count(7), std_multiset.count(7));
+  ASSERT_EQ(*s21_multiset.find(s21_multiset.begin(), 200), 200);
+}
+
+TEST(Multiset, node_handle) {
+  custom::Multiset<int> s21_multiset1{1, 2, 2, 2, 3};
+  custom::Multiset<int> s21_multiset2{2};
+  auto handle = s21_multiset1.extract(2);
+  ASSERT_EQ(handle.value(), 2);
+  auto s21_i = s21_multiset2.insert(std::move(handle));
+  ASSERT_EQ(*s21_i, 2);
+  ASSERT_TRUE(handle.empty());
+  s21_multiset2.insert(s21_multiset1.extract(s21_multiset1.begin()));
+  CompareMultisets(s21_multiset1, std::multiset<int>{2, 2, 3});
+  CompareMultisets(s21_multiset2, std::multiset<int>{1, 2, 2});
+}
+
+TEST(Multiset, merge_large) {
+  custom::Multiset<int> s21_multiset1, s21_multiset2;
+  std::multiset<int> std_multiset1, std_multiset2;
+  for (int i = 0; i < 2000; ++i) {
+    s21_multiset1.insert(i % 300);
+    std_multiset1.insert(i % 300);
+    s21_multiset2.insert(i % 700);
+    std_multiset2.insert(i % 700);
+  }
+  s21_multiset1.merge(s21_multiset2);
+  std_multiset1.merge(std_multiset2);
+  CompareMultisets(s21_multiset1, std_multiset1);
+  ASSERT_TRUE(s21_multiset2.empty());
+  ASSERT_EQ(s21_multiset1.count(299), std_multiset1.count(299));
+}
+
+TEST(Multiset, set_algebra) {
+  custom::Multiset<int> s21_multiset1{1, 1, 1, 2, 3, 3, 7};
+  custom::Multiset<int> s21_multiset2{1, 2, 2, 3, 3, 3, 8};
+  CompareMultisets(std::multiset<int>{1, 1, 1, 2, 2, 3, 3, 3, 7, 8},
+                   s21_multiset1.set_union(s21_multiset2));
+  CompareMultisets(std::multiset<int>{1, 2, 3, 3},
+                   s21_multiset1.set_intersection(s21_multiset2));
+  CompareMultisets(std::multiset<int>{1, 1, 7},
+                   s21_multiset1.set_difference(s21_multiset2));
+  CompareMultisets(std::multiset<int>{1, 1, 2, 3, 7, 8},
+                   s21_multiset1.set_symmetric_difference(s21_multiset2));
+}
+
+TEST(Multiset, set_algebra_parallel) {
+  custom::Multiset<int> s21_multiset1, s21_multiset2;
+  std::multiset<int> std_multiset1, std_multiset2;
+  for (int i = 0; i < 100000; ++i) {
+    s21_multiset1.insert(i % 5000);
+    std_multiset1.insert(i % 5000);
+    s21_multiset2.insert(i % 7000);
+    std_multiset2.insert(i % 7000);
+  }
+  std::multiset<int> std_result;
+  std::set_union(std_multiset1.begin(), std_multiset1.end(),
+                 std_multiset2.begin(), std_multiset2.end(),
+                 std::inserter(std_result, std_result.end()));
+  CompareMultisets(std_result, s21_multiset1.set_union(s21_multiset2, 4UL));
+  std_result.clear();
+  std::set_difference(std_multiset2.begin(), std_multiset2.end(),
+                      std_multiset1.begin(), std_multiset1.end(),
+                      std::inserter(std_result, std_result.end()));
+  CompareMultisets(std_result,
+                   s21_multiset2.set_difference(s21_multiset1, 4UL));
+}
+
+TEST(Multiset, emplace_single) {
+  custom::Multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 100; ++i) {
+    auto s21_i = s21_multiset.emplace(i % 7);
+    std_multiset.emplace(i % 7);
+    ASSERT_EQ(*s21_i, i % 7);
+    ASSERT_TRUE(std::next(s21_i) == s21_multiset.upper_bound(i % 7));
+  }
+  CompareMultisets(std_multiset, s21_multiset);
+}
+
+TEST(Multiset, insert_move) {
+  custom::Multiset<std::vector<int>> s21_multiset;
+  for (int i = 0; i < 3; ++i) {
+    std::vector<int> value(100, 1);
+    auto s21_i = s21_multiset.insert(std::move(value));
+    ASSERT_TRUE(value.empty());
+    ASSERT_EQ((*s21_i).size(), 100UL);
+  }
+  std::vector<int> value(10, 0);
+  s21_multiset.insert(s21_multiset.begin(), std::move(value));
+  ASSERT_TRUE(value.empty());
+  ASSERT_EQ(s21_multiset.size(), 4UL);
+  ASSERT_EQ((*s21_multiset.begin()).size(), 10UL);
+}
+
+TEST(Multiset, move_only) {
+  {
+    custom::Multiset<MoveOnlyCounter> s21_multiset;
+    for (int i = 0; i < 100; ++i)
+      s21_multiset.insert(MoveOnlyCounter(i % 10));
+    s21_multiset.emplace(3);
+    s21_multiset.insert(s21_multiset.end(), MoveOnlyCounter(10));
+    ASSERT_EQ(MoveOnlyCounter::instances, 102);
+    ASSERT_EQ(s21_multiset.count(MoveOnlyCounter(3)), 11UL);
+    custom::Multiset<MoveOnlyCounter> s21_other;
+    s21_other.merge(s21_multiset);
+    ASSERT_EQ(s21_other.size(), 102UL);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(Multiset, insert_range) {
+  custom::Multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 1000; ++i) {
+    s21_multiset.insert(i % 250);
+    std_multiset.insert(i % 250);
+  }
+  std::vector<int> batch{7, 300, 7, -1, 249, 7};
+  ASSERT_EQ(s21_multiset.insert(batch.begin(), batch.end()), 6UL);
+  std_multiset.insert(batch.begin(), batch.end());
+  CompareMultisets(s21_multiset, std_multiset);
+  batch.assign(3000, 0);
+  for (int i = 0; i < 3000; ++i)
+    batch[i] = 500 - i % 600;
+  ASSERT_EQ(s21_multiset.insert(batch.begin(), batch.end()), 3000UL);
+  std_multiset.insert(batch.begin(), batch.end());
+  CompareMultisets(s21_multiset, std_multiset);
+  ASSERT_EQ(s21_multiset.insert({1, 1, 1}), 3UL);
+  ASSERT_EQ(s21_multiset.count(1), 12UL);
+}
+
+TEST(Multiset, insert_range_keeps_order_of_equal) {
+  // values are compared by the first member only, the second one shows
+  // the order of insertion
+  struct CompareFirst {
+    bool operator()(const std::pair<int, int> &left,
+                    const std::pair<int, int> &right) const {
+      return left.first < right.first;
+    }
+  };
+  using value_type = std::pair<int, int>;
+  for (int size : {2, 1000}) {
+    custom::Multiset<value_type, CompareFirst> s21_multiset;
+    for (int i = 0; i < size; ++i)
+      s21_multiset.insert(value_type(i % 2, i));
+    s21_multiset.insert({value_type(1, -1), value_type(0, -1),
+                         value_type(1, -2), value_type(0, -2)});
+    std::vector<value_type> expected;
+    for (int first = 0; first < 2; ++first) {
+      for (int i = first; i < size; i += 2)
+        expected.push_back(value_type(first, i));
+      expected.push_back(value_type(first, -1));
+      expected.push_back(value_type(first, -2));
+    }
+    ASSERT_TRUE(std::equal(s21_multiset.begin(), s21_multiset.end(),
+                           expected.begin(), expected.end()));
+  }
+}
+
+TEST(Multiset, erase_key_and_range) {
+  custom::Multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 2000; ++i) {
+    s21_multiset.insert(i % 100);
+    std_multiset.insert(i % 100);
+  }
+  ASSERT_EQ(s21_multiset.erase(7), 20UL);
+  ASSERT_EQ(s21_multiset.erase(7), 0UL);
+  std_multiset.erase(7);
+  CompareMultisets(s21_multiset, std_multiset);
+  auto s21_i = s21_multiset.erase(s21_multiset.lower_bound(10),
+                                  s21_multiset.upper_bound(89));
+  std_multiset.erase(std_multiset.lower_bound(10),
+                     std_multiset.upper_bound(89));
+  ASSERT_EQ(*s21_i, 90);
+  CompareMultisets(s21_multiset, std_multiset);
+  ASSERT_EQ(s21_multiset.count(50), 0UL);
+  ASSERT_EQ(s21_multiset.count(95), 20UL);
+}
+
+TEST(Multiset, erase_if) {
+  custom::Multiset<int> s21_multiset{5, 1, 5, 2, 5, 3, 4, 4};
+  ASSERT_EQ(custom::erase_if(s21_multiset,
+                             [](int value) { return value == 5; }),
+            3UL);
+  CompareMultisets(s21_multiset, std::multiset<int>{1, 2, 3, 4, 4});
+  ASSERT_EQ(erase_if(s21_multiset, [](int value) { return value < 3; }), 2UL);
+  CompareMultisets(s21_multiset, std::multiset<int>{3, 4, 4});
+}
+
+TEST(Multiset, split_and_join) {
+  custom::Multiset<int, std::less<int>, custom::NodeAllocator__, true>
+      s21_multiset;
+  for (int i = 0; i < 1000; ++i)
+    s21_multiset.insert(i % 10);
+  auto s21_greater = s21_multiset.split(5);
+  ASSERT_EQ(s21_multiset.size(), 500UL);
+  ASSERT_EQ(s21_greater.size(), 500UL);
+  ASSERT_EQ(s21_multiset.count(4), 100UL);
+  ASSERT_EQ(s21_greater.count(5), 100UL);
+  ASSERT_EQ(*s21_greater.nth(250), 7);
+  auto s21_equal = s21_multiset.split(4);
+  s21_equal.join(s21_greater);
+  ASSERT_EQ(s21_equal.size(), 600UL);
+  ASSERT_EQ(s21_equal.rank(5), 100UL);
+  ASSERT_THROW(s21_equal.join(s21_multiset), std::invalid_argument);
+  s21_multiset.join(s21_equal);
+  ASSERT_EQ(s21_multiset.size(), 1000UL);
+  ASSERT_EQ(*s21_multiset.nth(999), 9);
+}
+
+TEST(Multiset, transparent_lookup) {
+  custom::Multiset<std::string, std::less<>> s21_multiset{"b", "a", "b", "c",
+                                                          "b"};
+  custom::Multiset<std::string, std::less<>, custom::NodeAllocator__, true>
+      s21_ranked(s21_multiset.begin(), s21_multiset.end());
+  std::string_view key = "b";
+  ASSERT_EQ(s21_multiset.count(key), 3UL);
+  ASSERT_EQ(s21_ranked.count(key), 3UL);
+  ASSERT_EQ(s21_multiset.count("d"), 0UL);
+  // the first of the equal values is found
+  ASSERT_EQ(s21_multiset.find(key), s21_multiset.lower_bound("b"));
+  ASSERT_EQ(std::distance(s21_multiset.begin(), s21_multiset.find("b")), 1);
+  ASSERT_TRUE(s21_multiset.contains("c"));
+  ASSERT_FALSE(s21_multiset.contains(std::string_view("bb")));
+  auto range = s21_multiset.equal_range("b");
+  ASSERT_EQ(std::distance(range.first, range.second), 3);
+  ASSERT_EQ(*s21_multiset.upper_bound(key), "c");
+}
@@ -1,13 +1,22 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
 #include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../../associative_containers/set/custom_set.h"
+#include "../move_only_counter.h"
 
 template <class T>
 void CompareSets(const std::set<T> &std_set, const custom::Set<T> &s21_set) {
   ASSERT_EQ(std_set.size(), s21_set.size());
-  ASSERT_EQ(std_set.max_size(), s21_set.max_size());
+  ASSERT_LE(std_set.max_size(), s21_set.max_size());
   auto std_i = std_set.begin();
   auto s21_i = s21_set.begin();
   while (std_i != std_set.end() && s21_i != s21_set.end()) {
@@ -22,7 +31,7 @@ void CompareSets(const std::set<T> &std_set, const custom::Set<T> &s21_set) {
 template <class T>
 void CompareSets(const custom::Set<T> &s21_set, const std::set<T> &std_set) {
   ASSERT_EQ(std_set.size(), s21_set.size());
-  ASSERT_EQ(std_set.max_size(), s21_set.max_size());
+  ASSERT_LE(std_set.max_size(), s21_set.max_size());
   auto std_i = std_set.begin();
   auto s21_i = s21_set.begin();
   while (std_i != std_set.end() && s21_i != s21_set.end()) {
@@ -335,11 +344,11 @@ TEST(Set, contains) {
     ASSERT_EQ(s21_set.contains(i), true);
 }
 
-TEST(Set, emplace) {
-  // * emplace behavior in std::set differs completely
+TEST(Set, insert_many) {
+  // * std::set has no insert_many function
   custom::Set<int> s21_set;
   custom::Set<int> compare{1, 2, 3, 4, 5, 6};
-  auto emplace_result = s21_set.emplace(1, 2, 3, 4, 5, 6);
+  auto emplace_result = s21_set.insert_many(1, 2, 3, 4, 5, 6);
   CompareSets(s21_set, compare);
   for (auto &i : emplace_result)
     ASSERT_EQ(i.second, true);
@@ -350,11 +359,666 @@ TEST(Set, emplace) {
       {1, true}, {1, false}, {2, true},  {2, false}, {3, true},  {3, false},
       {4, true}, {4, false}, {-5, true}, {6, true},  {-5, false}};
   auto pair_compare_iterator = pair_compare.begin();
-  emplace_result = s21_set.emplace(1, 1, 2, 2, 3, 3, 4, 4, -5, 6, -5);
+  emplace_result = s21_set.insert_many(1, 1, 2, 2, 3, 3, 4, 4, -5, 6, -5);
   CompareSets(s21_set, compare);
   for (auto &i : emplace_result) {
     ASSERT_EQ(*i.first, (*pair_compare_iterator).first);
     ASSERT_EQ(i.second, (*pair_compare_iterator).second);
     ++pair_compare_iterator;
   }
-}
\ No newline at end of file
+}
+// Red-black tree height can't be greater than 2 * log2(n + 1)
+template <class Tree> void CheckHeightBound(const Tree &tree) {
+  ASSERT_LE(static_cast<double>(tree.height()),
+            2.0 * std::log2(static_cast<double>(tree.size()) + 1.0));
+}
+
+TEST(Set, height_after_ascending_insert) {
+  custom::Set<int>::binary_tree tree;
+  std::set<int> std_set;
+  for (int i = 0; i < 10000; ++i) {
+    tree.insert(i);
+    std_set.insert(i);
+  }
+  CheckHeightBound(tree);
+  ASSERT_EQ(tree.size(), std_set.size());
+  auto std_i = std_set.begin();
+  for (auto i = tree.begin(); i != tree.end(); ++i, ++std_i)
+    ASSERT_EQ(*i, *std_i);
+}
+
+TEST(Set, height_after_descending_insert) {
+  custom::Set<int>::binary_tree tree;
+  for (int i = 10000; i > 0; --i)
+    tree.insert(i);
+  CheckHeightBound(tree);
+  ASSERT_EQ(*tree.begin(), 1);
+  ASSERT_EQ(*(--tree.end()), 10000);
+}
+
+TEST(Set, height_after_zigzag_insert) {
+  custom::Set<int>::binary_tree tree;
+  for (int i = 0; i < 5000; ++i) {
+    tree.insert(i);
+    tree.insert(10000 - i);
+  }
+  CheckHeightBound(tree);
+  ASSERT_EQ(tree.size(), 10000UL);
+}
+
+TEST(Set, height_after_erase) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  custom::Set<int>::binary_tree tree;
+  for (int i = 0; i < 4096; ++i) {
+    tree.insert(i);
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+  for (int i = 0; i < 4096; i += 3) {
+    tree.erase(tree.find(i));
+    s21_set.erase(s21_set.find(i));
+    std_set.erase(i);
+    CheckHeightBound(tree);
+  }
+  CompareSets(s21_set, std_set);
+  while (!tree.empty()) {
+    tree.erase(tree.begin());
+    CheckHeightBound(tree);
+  }
+}
+
+TEST(Set, node_pool) {
+  using pool_set = custom::Set<int, std::less<int>, custom::NodePool__>;
+  std::set<int> std_set;
+  pool_set s21_set1, s21_set2;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 5000; ++i) {
+      std_set.insert((i * 7919) % 5000);
+      s21_set1.insert((i * 7919) % 5000);
+    }
+    for (int i = 0; i < 5000; i += 5) {
+      std_set.erase(i);
+      s21_set1.erase(s21_set1.find(i));
+    }
+    ASSERT_EQ(std_set.size(), s21_set1.size());
+    auto std_i = std_set.begin();
+    for (auto i = s21_set1.begin(); i != s21_set1.end(); ++i, ++std_i)
+      ASSERT_EQ(*i, *std_i);
+    s21_set2 = s21_set1;
+    s21_set1.clear();
+    ASSERT_TRUE(s21_set1.empty());
+    ASSERT_EQ(s21_set2.size(), std_set.size());
+    s21_set1.swap(s21_set2);
+    ASSERT_EQ(s21_set1.size(), std_set.size());
+    s21_set1.clear();
+    std_set.clear();
+  }
+}
+
+TEST(Set, range_constructor) {
+  std::vector<int> sorted(10000), unsorted;
+  for (int i = 0; i < 10000; ++i) {
+    sorted[i] = i;
+    unsorted.push_back((i * 7919) % 10000);
+    unsorted.push_back(i % 100);
+  }
+  custom::Set<int> s21_set1(sorted.begin(), sorted.end());
+  std::set<int> std_set1(sorted.begin(), sorted.end());
+  CompareSets(s21_set1, std_set1);
+
+  custom::Set<int> s21_set2(unsorted.begin(), unsorted.end());
+  std::set<int> std_set2(unsorted.begin(), unsorted.end());
+  CompareSets(s21_set2, std_set2);
+
+  custom::Set<int> s21_set3(sorted.begin(), sorted.begin());
+  CompareSets(s21_set3, std::set<int>());
+
+  for (std::size_t count = 0; count < 70; ++count) {
+    custom::Set<int>::binary_tree tree(sorted.begin(), sorted.begin() + count);
+    CheckHeightBound(tree);
+    ASSERT_EQ(tree.size(), count);
+    tree.insert(-1);
+    tree.erase(tree.find(static_cast<int>(count / 2)));
+    CheckHeightBound(tree);
+  }
+}
+
+TEST(Set, assign) {
+  std::set<std::string> std_set{"a", "b"};
+  custom::Set<std::string> s21_set{"c", "d", "e"};
+  std::vector<std::string> values{"x", "a", "x", "y", "b", "z", "a"};
+  std_set = std::set<std::string>(values.begin(), values.end());
+  s21_set.assign(values.begin(), values.end());
+  CompareSets(s21_set, std_set);
+
+  std::istringstream stream("5 3 9 1 3 7");
+  s21_set.clear();
+  custom::Set<int> s21_ints;
+  s21_ints.assign(std::istream_iterator<int>(stream),
+                  std::istream_iterator<int>());
+  CompareSets(s21_ints, std::set<int>{1, 3, 5, 7, 9});
+}
+
+TEST(Set, begin_and_end_after_modifications) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  ASSERT_TRUE(s21_set.begin() == s21_set.end());
+  for (int i = 0; i < 200; ++i) {
+    int value = (i * 37) % 101 - 50;
+    s21_set.insert(value);
+    std_set.insert(value);
+    ASSERT_EQ(*s21_set.begin(), *std_set.begin());
+    ASSERT_EQ(*--s21_set.end(), *std_set.rbegin());
+  }
+  while (std_set.size() > 1) {
+    s21_set.erase(s21_set.begin());
+    std_set.erase(std_set.begin());
+    s21_set.erase(std::prev(s21_set.end()));
+    std_set.erase(--std_set.end());
+    if (std_set.empty())
+      break;
+    ASSERT_EQ(*s21_set.begin(), *std_set.begin());
+    ASSERT_EQ(*--s21_set.end(), *std_set.rbegin());
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+
+  custom::Set<int> s21_other{1, 2, 3};
+  s21_set.swap(s21_other);
+  ASSERT_EQ(*--s21_set.end(), 3);
+  s21_set.clear();
+  ASSERT_TRUE(s21_set.begin() == s21_set.end());
+}
+
+TEST(Set, order_statistics) {
+  custom::Set<int, std::less<int>, custom::NodeAllocator__, true> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 3000; ++i) {
+    int value = (i * 7919) % 1000;
+    if (i % 3 == 2) {
+      s21_set.erase(s21_set.find(value));
+      std_set.erase(value);
+    } else {
+      s21_set.insert(value);
+      std_set.insert(value);
+    }
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  std::size_t index = 0;
+  for (int value : std_set)
+    ASSERT_EQ(*s21_set.nth(index++), value);
+  ASSERT_TRUE(s21_set.nth(index) == s21_set.end());
+  for (int key = -10; key < 1010; key += 7) {
+    auto std_lower = std_set.lower_bound(key);
+    auto std_rank = std::distance(std_set.begin(), std_lower);
+    ASSERT_EQ(s21_set.rank(key), static_cast<std::size_t>(std_rank));
+    ASSERT_EQ(s21_set.count_range(key, key + 100),
+              static_cast<std::size_t>(
+                  std::distance(std_lower, std_set.lower_bound(key + 100))));
+  }
+  ASSERT_EQ(s21_set.count_range(100, 50), 0UL);
+
+  auto s21_copy = s21_set;
+  s21_copy.assign(std_set.begin(), std_set.end());
+  ASSERT_EQ(*s21_copy.nth(std_set.size() / 2),
+            *std::next(std_set.begin(), std_set.size() / 2));
+}
+
+TEST(Set, bounds) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 500; ++i) {
+    s21_set.insert(i * 3);
+    std_set.insert(i * 3);
+  }
+  for (int key = -2; key < 1505; ++key) {
+    auto s21_lower = s21_set.lower_bound(key);
+    auto std_lower = std_set.lower_bound(key);
+    auto s21_upper = s21_set.upper_bound(key);
+    auto std_upper = std_set.upper_bound(key);
+    ASSERT_EQ(s21_lower == s21_set.end(), std_lower == std_set.end());
+    ASSERT_EQ(s21_upper == s21_set.end(), std_upper == std_set.end());
+    if (std_lower != std_set.end()) {
+      ASSERT_EQ(*s21_lower, *std_lower);
+    }
+    if (std_upper != std_set.end()) {
+      ASSERT_EQ(*s21_upper, *std_upper);
+    }
+    auto s21_range = s21_set.equal_range(key);
+    ASSERT_TRUE(s21_range.first == s21_lower);
+    ASSERT_TRUE(s21_range.second == s21_upper);
+  }
+  custom::Set<int> s21_empty;
+  ASSERT_TRUE(s21_empty.lower_bound(1) == s21_empty.end());
+  ASSERT_TRUE(s21_empty.equal_range(1).second == s21_empty.end());
+}
+
+TEST(Set, insert_with_hint) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 2000; ++i) {
+    auto s21_i = s21_set.insert(s21_set.end(), i);
+    std_set.insert(std_set.end(), i);
+    ASSERT_EQ(*s21_i, i);
+  }
+  custom::Set<int>::binary_tree tree;
+  for (int i = 0; i < 2000; ++i)
+    tree.insert(tree.end(), i);
+  CheckHeightBound(tree);
+  auto s21_i = s21_set.insert(s21_set.find(500), 500);
+  ASSERT_EQ(*s21_i, 500);
+  ASSERT_EQ(s21_set.size(), std_set.size());
+
+  // wrong hints still insert the value at the right place
+  for (int i = -100; i < 3000; i += 7) {
+    s21_set.insert(s21_set.begin(), i);
+    std_set.insert(i);
+  }
+  s21_set.emplace_hint(s21_set.find(1999), 2000);
+  std_set.insert(2000);
+  CompareSets(s21_set, std_set);
+
+  for (int i = -100; i < 3000; i += 13) {
+    auto s21_found = s21_set.find(s21_set.find(1000), i);
+    ASSERT_EQ(s21_found == s21_set.end(), std_set.find(i) == std_set.end());
+    if (s21_found != s21_set.end()) {
+      ASSERT_EQ(*s21_found, i);
+    }
+  }
+}
+
+TEST(Set, node_handle) {
+  custom::Set<std::string> s21_set1{"a", "b", "c"};
+  custom::Set<std::string> s21_set2{"c"};
+  auto result = s21_set2.insert(s21_set1.extract("a"));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ(*result.position, "a");
+  result = s21_set2.insert(s21_set1.extract(s21_set1.find("c")));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.node.value(), "c");
+  CompareSets(s21_set1, std::set<std::string>{"b"});
+  CompareSets(s21_set2, std::set<std::string>{"a", "c"});
+  ASSERT_TRUE(s21_set1.extract("z").empty());
+}
+
+TEST(Set, merge_large) {
+  custom::Set<int> s21_set1, s21_set2;
+  std::set<int> std_set1, std_set2;
+  for (int i = 0; i < 3000; ++i) {
+    s21_set1.insert(i * 2);
+    std_set1.insert(i * 2);
+    s21_set2.insert(i * 3);
+    std_set2.insert(i * 3);
+  }
+  s21_set1.merge(s21_set2);
+  std_set1.merge(std_set2);
+  CompareSets(s21_set1, std_set1);
+  CompareSets(s21_set2, std_set2);
+  custom::Set<int>::binary_tree tree1(std_set1.begin(), std_set1.end());
+  custom::Set<int>::binary_tree tree2(std_set2.begin(), std_set2.end());
+  tree2.merge(tree1);
+  CheckHeightBound(tree1);
+  CheckHeightBound(tree2);
+  ASSERT_EQ(tree1.size(), std_set2.size());
+  ASSERT_EQ(*--tree2.end(), *std_set1.rbegin());
+
+  using pool_set = custom::Set<int, std::less<int>, custom::NodePool__>;
+  pool_set s21_pool1(std_set1.begin(), std_set1.end());
+  pool_set s21_pool2{-1, 0, 3, 1000000};
+  s21_pool2.merge(s21_pool1);
+  std_set1.insert({-1, 1000000});
+  ASSERT_EQ(s21_pool2.size(), std_set1.size());
+  auto std_i = std_set1.begin();
+  for (auto i = s21_pool2.begin(); i != s21_pool2.end(); ++i, ++std_i)
+    ASSERT_EQ(*i, *std_i);
+  ASSERT_EQ(s21_pool1.size(), 2UL);
+}
+
+TEST(Set, set_algebra) {
+  custom::Set<int> s21_set1{1, 2, 3, 5, 8, 13}, s21_set2{2, 3, 4, 5, 6};
+  CompareSets(s21_set1.set_union(s21_set2),
+              std::set<int>{1, 2, 3, 4, 5, 6, 8, 13});
+  CompareSets(s21_set1.set_intersection(s21_set2), std::set<int>{2, 3, 5});
+  CompareSets(s21_set1.set_difference(s21_set2), std::set<int>{1, 8, 13});
+  CompareSets(s21_set1.set_symmetric_difference(s21_set2),
+              std::set<int>{1, 4, 6, 8, 13});
+  CompareSets(s21_set1.set_difference(s21_set1), std::set<int>{});
+  CompareSets(custom::Set<int>().set_union(s21_set2),
+              std::set<int>{2, 3, 4, 5, 6});
+
+  using pool_set = custom::Set<int, std::less<int>, custom::NodePool__>;
+  pool_set s21_pool1{5, 1, 3}, s21_pool2{3, 4};
+  pool_set s21_result = s21_pool1.set_union(s21_pool2, 4UL);
+  std::vector<int> expected{1, 3, 4, 5};
+  ASSERT_TRUE(
+      std::equal(s21_result.begin(), s21_result.end(), expected.begin(),
+                 expected.end()));
+}
+
+TEST(Set, set_algebra_parallel) {
+  custom::Set<int> s21_set1, s21_set2;
+  std::set<int> std_set1, std_set2;
+  for (int i = 0; i < 100000; ++i) {
+    s21_set1.insert(i * 2);
+    std_set1.insert(i * 2);
+    s21_set2.insert(i * 3);
+    std_set2.insert(i * 3);
+  }
+  for (std::size_t threads : {1UL, 2UL, 3UL, 8UL}) {
+    std::set<int> std_result;
+    std::set_intersection(std_set1.begin(), std_set1.end(), std_set2.begin(),
+                          std_set2.end(),
+                          std::inserter(std_result, std_result.end()));
+    custom::Set<int> s21_result = s21_set1.set_intersection(s21_set2, threads);
+    CompareSets(s21_result, std_result);
+    std_result.clear();
+    std::set_symmetric_difference(std_set1.begin(), std_set1.end(),
+                                  std_set2.begin(), std_set2.end(),
+                                  std::inserter(std_result, std_result.end()));
+    s21_result = s21_set2.set_symmetric_difference(s21_set1, threads);
+    CompareSets(s21_result, std_result);
+  }
+  custom::Set<int>::binary_tree tree1(std_set1.begin(), std_set1.end());
+  custom::Set<int>::binary_tree tree2(std_set2.begin(), std_set2.end());
+  custom::Set<int>::binary_tree tree;
+  tree.assign_set_operation(tree1, tree2, custom::SetOperation__::kUnion, 4UL);
+  CheckHeightBound(tree);
+  std_set1.merge(std_set2);
+  ASSERT_EQ(tree.size(), std_set1.size());
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), std_set1.begin()));
+}
+
+TEST(Set, emplace_single) {
+  custom::Set<std::string> s21_set;
+  std::set<std::string> std_set;
+  for (std::size_t i = 0; i < 50; ++i) {
+    auto s21_result = s21_set.emplace(i % 20, 'x');
+    auto std_result = std_set.emplace(i % 20, 'x');
+    ASSERT_EQ(s21_result.second, std_result.second);
+    ASSERT_EQ(*s21_result.first, *std_result.first);
+  }
+  auto s21_i = s21_set.emplace_hint(s21_set.end(), 25UL, 'x');
+  ASSERT_EQ((*s21_i).size(), 25UL);
+  s21_i = s21_set.emplace_hint(s21_set.begin(), 5UL, 'x');
+  ASSERT_EQ((*s21_i).size(), 5UL);
+  std_set.emplace(25UL, 'x');
+  CompareSets(s21_set, std_set);
+}
+
+TEST(Set, insert_move) {
+  custom::Set<std::vector<int>> s21_set;
+  std::vector<int> value(100, 1);
+  ASSERT_TRUE(s21_set.insert(std::move(value)).second);
+  ASSERT_TRUE(value.empty());
+  value.assign(100, 1);
+  ASSERT_FALSE(s21_set.insert(std::move(value)).second);
+  ASSERT_EQ(value.size(), 100UL);
+  value.assign(200, 2);
+  auto s21_i = s21_set.insert(s21_set.end(), std::move(value));
+  ASSERT_TRUE(value.empty());
+  ASSERT_EQ((*s21_i).size(), 200UL);
+  ASSERT_EQ(s21_set.size(), 2UL);
+}
+
+TEST(Set, move_only) {
+  {
+    custom::Set<MoveOnlyCounter> s21_set;
+    for (int i = 0; i < 100; ++i)
+      ASSERT_TRUE(s21_set.insert(MoveOnlyCounter(i)).second);
+    ASSERT_FALSE(s21_set.insert(MoveOnlyCounter(5)).second);
+    ASSERT_FALSE(s21_set.emplace(7).second);
+    s21_set.emplace_hint(s21_set.end(), 100);
+    s21_set.insert(s21_set.begin(), MoveOnlyCounter(-1));
+    s21_set.erase(s21_set.find(MoveOnlyCounter(50)));
+    ASSERT_EQ(MoveOnlyCounter::instances, 101);
+    ASSERT_EQ(s21_set.size(), 101UL);
+    ASSERT_EQ((*s21_set.begin()).value, -1);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(Set, insert_range) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 1000; ++i) {
+    s21_set.insert(i * 4);
+    std_set.insert(i * 4);
+  }
+  // few keys are linked one by one, some of them fall between the same
+  // neighbours and some are already in the set
+  std::vector<int> batch{2001, 8, 2003, -5, 4500, 2002, 8, 3999};
+  ASSERT_EQ(s21_set.insert(batch.begin(), batch.end()), 6UL);
+  std_set.insert(batch.begin(), batch.end());
+  CompareSets(s21_set, std_set);
+  // many keys are merged with the set
+  batch.clear();
+  for (int i = 5000; i >= 0; i -= 3)
+    batch.push_back(i);
+  std::size_t old_size = std_set.size();
+  std_set.insert(batch.begin(), batch.end());
+  ASSERT_EQ(s21_set.insert(batch.begin(), batch.end()),
+            std_set.size() - old_size);
+  CompareSets(s21_set, std_set);
+  custom::Set<int>::binary_tree tree(s21_set.begin(), s21_set.end());
+  tree.insert(batch.begin(), batch.end());
+  CheckHeightBound(tree);
+
+  ASSERT_EQ(s21_set.insert({-1, -2, 0}), 2UL);
+  ASSERT_EQ(s21_set.insert(batch.begin(), batch.begin()), 0UL);
+  custom::Set<int> s21_empty;
+  ASSERT_EQ(s21_empty.insert({3, 1, 2, 1}), 3UL);
+  CompareSets(s21_empty, std::set<int>{1, 2, 3});
+
+  using pool_set = custom::Set<int, std::less<int>, custom::NodePool__>;
+  pool_set s21_pool{1, 5};
+  std::istringstream stream("4 3 5 2");
+  ASSERT_EQ(s21_pool.insert(std::istream_iterator<int>(stream),
+                            std::istream_iterator<int>()),
+            3UL);
+  std::vector<int> expected{1, 2, 3, 4, 5};
+  ASSERT_TRUE(std::equal(s21_pool.begin(), s21_pool.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(Set, erase_range) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 3000; ++i) {
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+  // both ends of the range are cut out and the rest is joined back
+  auto s21_i = s21_set.erase(s21_set.find(100), s21_set.find(110));
+  std_set.erase(std_set.find(100), std_set.find(110));
+  ASSERT_EQ(*s21_i, 110);
+  CompareSets(s21_set, std_set);
+  s21_i = s21_set.erase(s21_set.find(500), s21_set.find(2500));
+  std_set.erase(std_set.find(500), std_set.find(2500));
+  ASSERT_EQ(*s21_i, 2500);
+  CompareSets(s21_set, std_set);
+  s21_i = s21_set.erase(s21_set.find(2700), s21_set.end());
+  std_set.erase(std_set.find(2700), std_set.end());
+  ASSERT_EQ(s21_i, s21_set.end());
+  CompareSets(s21_set, std_set);
+  s21_i = s21_set.erase(s21_set.begin(), s21_set.begin());
+  ASSERT_EQ(*s21_i, 0);
+  ASSERT_EQ(s21_set.size(), std_set.size());
+
+  custom::Set<int>::binary_tree tree(std_set.begin(), std_set.end());
+  tree.erase(tree.begin(), tree.lower_bound(1000));
+  CheckHeightBound(tree);
+  ASSERT_EQ(*tree.begin(), 2500);
+  tree.erase(tree.begin(), tree.end());
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.begin(), tree.end());
+}
+
+TEST(Set, erase_random_ranges) {
+  using ranked_set = custom::Set<int, std::less<int>, custom::NodePool__, true>;
+  ranked_set s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 5000; ++i) {
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+  std::mt19937 generator(17);
+  while (!std_set.empty()) {
+    int first = static_cast<int>(generator() % 5000U);
+    int last = first + static_cast<int>(generator() % 300U);
+    auto s21_i = s21_set.erase(s21_set.lower_bound(first),
+                               s21_set.lower_bound(last));
+    auto std_i =
+        std_set.erase(std_set.lower_bound(first), std_set.lower_bound(last));
+    ASSERT_EQ(s21_i == s21_set.end(), std_i == std_set.end());
+    if (std_i != std_set.end()) {
+      ASSERT_EQ(*s21_i, *std_i);
+    }
+    ASSERT_EQ(s21_set.size(), std_set.size());
+    if (std_set.empty())
+      break;
+    ASSERT_EQ(*s21_set.begin(), *std_set.begin());
+    ASSERT_EQ(*--s21_set.end(), *std_set.rbegin());
+    // subtree sizes are checked through the ranks
+    std::size_t middle = std_set.size() / 2UL;
+    ASSERT_EQ(*s21_set.nth(middle), *std::next(std_set.begin(), middle));
+    ASSERT_EQ(s21_set.rank(last), static_cast<std::size_t>(std::distance(
+                                      std_set.begin(),
+                                      std_set.lower_bound(last))));
+  }
+  ASSERT_TRUE(s21_set.empty());
+
+  custom::Set<int>::binary_tree tree;
+  for (int i = 0; i < 5000; ++i) {
+    tree.insert(i);
+    std_set.insert(i);
+  }
+  for (int i = 0; i < 5000; i += 10) {
+    tree.erase(tree.lower_bound(i + 3), tree.lower_bound(i + 7));
+    std_set.erase(std_set.lower_bound(i + 3), std_set.lower_bound(i + 7));
+    CheckHeightBound(tree);
+  }
+  ASSERT_EQ(tree.size(), std_set.size());
+  ASSERT_TRUE(
+      std::equal(tree.begin(), tree.end(), std_set.begin(), std_set.end()));
+}
+
+TEST(Set, erase_key) {
+  custom::Set<int> s21_set{1, 2, 3};
+  ASSERT_EQ(s21_set.erase(2), 1UL);
+  ASSERT_EQ(s21_set.erase(2), 0UL);
+  CompareSets(s21_set, std::set<int>{1, 3});
+}
+
+TEST(Set, erase_if) {
+  custom::Set<int, std::less<int>, custom::NodeAllocator__, true> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 1000; ++i) {
+    s21_set.insert(i);
+    std_set.insert(i);
+  }
+  auto is_odd = [](int value) { return value % 2 != 0; };
+  ASSERT_EQ(erase_if(s21_set, is_odd), 500UL);
+  ASSERT_EQ(custom::erase_if(s21_set, is_odd), 0UL);
+  for (auto i = std_set.begin(); i != std_set.end();)
+    i = is_odd(*i) ? std_set.erase(i) : std::next(i);
+  ASSERT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                         std_set.end()));
+  ASSERT_EQ(*s21_set.nth(100), 200);
+  ASSERT_EQ(s21_set.rank(500), 250UL);
+
+  // the set is not changed if the predicate throws
+  auto throwing = [](int value) {
+    if (value > 900)
+      throw std::runtime_error("predicate failure");
+    return value < 100;
+  };
+  ASSERT_THROW(custom::erase_if(s21_set, throwing), std::runtime_error);
+  ASSERT_EQ(s21_set.size(), 500UL);
+  ASSERT_EQ(custom::erase_if(s21_set, [](int) { return true; }), 500UL);
+  ASSERT_TRUE(s21_set.empty());
+}
+
+TEST(Set, split_and_join) {
+  custom::Set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 5000; ++i) {
+    s21_set.insert(i * 2);
+    std_set.insert(i * 2);
+  }
+  custom::Set<int> s21_greater = s21_set.split(3001);
+  std::set<int> std_greater(std_set.lower_bound(3001), std_set.end());
+  std_set.erase(std_set.lower_bound(3001), std_set.end());
+  CompareSets(s21_set, std_set);
+  CompareSets(s21_greater, std_greater);
+  ASSERT_TRUE(s21_set.split(100000).empty());
+  ASSERT_EQ(s21_set.size(), 1501UL);
+
+  // pieces are valid trees that can be changed further
+  s21_greater.insert(3001);
+  s21_greater.erase(s21_greater.find(9998));
+  custom::Set<int>::binary_tree tree(std_set.begin(), std_set.end());
+  custom::Set<int>::binary_tree tree_greater;
+  tree.split(1000, tree_greater);
+  CheckHeightBound(tree);
+  CheckHeightBound(tree_greater);
+  ASSERT_EQ(*--tree.end(), 998);
+  ASSERT_EQ(*tree_greater.begin(), 1000);
+
+  ASSERT_THROW(s21_greater.join(s21_set), std::invalid_argument);
+  s21_set.join(s21_greater);
+  ASSERT_TRUE(s21_greater.empty());
+  ASSERT_EQ(s21_set.size(), 5000UL);
+  ASSERT_TRUE(s21_set.contains(3001));
+  ASSERT_FALSE(s21_set.contains(9998));
+  custom::Set<int> s21_everything = s21_set.split(-1);
+  ASSERT_TRUE(s21_set.empty());
+  s21_set.join(s21_everything);
+  ASSERT_EQ(s21_set.size(), 5000UL);
+
+  using pool_set = custom::Set<int, std::less<int>, custom::NodePool__>;
+  pool_set s21_pool{1, 2, 3, 4, 5};
+  pool_set s21_pool_greater = s21_pool.split(3);
+  pool_set s21_pool_last{7, 8};
+  s21_pool_greater.join(s21_pool_last);
+  std::vector<int> expected{3, 4, 5, 7, 8};
+  ASSERT_TRUE(std::equal(s21_pool_greater.begin(), s21_pool_greater.end(),
+                         expected.begin(), expected.end()));
+  ASSERT_EQ(s21_pool.size(), 2UL);
+}
+
+// Key without the equality operators, only the comparator orders it
+struct OrderedOnlyKey {
+  int value;
+};
+
+struct OrderedOnlyLess {
+  using is_transparent = void;
+  bool operator()(const OrderedOnlyKey &a, const OrderedOnlyKey &b) const {
+    return a.value < b.value;
+  }
+  bool operator()(const OrderedOnlyKey &a, int b) const { return a.value < b; }
+  bool operator()(int a, const OrderedOnlyKey &b) const { return a < b.value; }
+};
+
+TEST(Set, lookup_by_comparator_only) {
+  custom::Set<OrderedOnlyKey, OrderedOnlyLess> s21_set;
+  for (int i = 0; i < 100; ++i)
+    ASSERT_TRUE(s21_set.insert(OrderedOnlyKey{(i * 37) % 100}).second);
+  ASSERT_FALSE(s21_set.insert(OrderedOnlyKey{42}).second);
+  ASSERT_EQ(s21_set.size(), 100UL);
+  ASSERT_EQ((*s21_set.find(OrderedOnlyKey{42})).value, 42);
+  ASSERT_EQ((*s21_set.find(17)).value, 17);
+  ASSERT_EQ(s21_set.find(100), s21_set.end());
+  ASSERT_TRUE(s21_set.contains(99));
+  ASSERT_FALSE(s21_set.contains(-1));
+  ASSERT_EQ((*s21_set.lower_bound(50)).value, 50);
+  ASSERT_EQ((*s21_set.upper_bound(50)).value, 51);
+  ASSERT_EQ(s21_set.erase(OrderedOnlyKey{50}), 1UL);
+  ASSERT_EQ(s21_set.equal_range(50).first, s21_set.equal_range(50).second);
+  int expected = 0;
+  for (const auto &key : s21_set) {
+    if (expected == 50)
+      ++expected;
+    ASSERT_EQ(key.value, expected++);
+  }
+}
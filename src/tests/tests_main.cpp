@@ -1,10 +1,17 @@
 #include <gtest/gtest.h>
 
 #include "array/array_tests.h"
+#include "btree_map/btree_map_tests.h"
+#include "btree_multiset/btree_multiset_tests.h"
+#include "btree_set/btree_set_tests.h"
+#include "flat_map/flat_map_tests.h"
+#include "flat_set/flat_set_tests.h"
 #include "list/list_tests.h"
 #include "map/map_tests.h"
 #include "multiset/multiset_tests.h"
 #include "queue/queue_tests.h"
 #include "set/set_tests.h"
 #include "stack/stack_tests.h"
+#include "unordered_map/unordered_map_tests.h"
+#include "unordered_set/unordered_set_tests.h"
 #include "vector/vector_tests.h"
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../associative_containers/unordered_map/custom_unordered_map.h"
+#include "../move_only_counter.h"
+
+template <class K, class V, class H, class E>
+void CompareUnorderedMaps(const std::unordered_map<K, V> &std_map,
+                          const custom::UnorderedMap<K, V, H, E> &s21_map) {
+  ASSERT_EQ(std_map.size(), s21_map.size());
+  ASSERT_EQ(std_map.empty(), s21_map.empty());
+  // the orders differ, so every pair is looked up in the other container
+  std::size_t visited = 0;
+  for (auto s21_i = s21_map.begin(); s21_i != s21_map.end(); ++s21_i) {
+    auto std_i = std_map.find((*s21_i).first);
+    ASSERT_NE(std_i, std_map.end());
+    ASSERT_EQ((*std_i).second, (*s21_i).second);
+    ++visited;
+  }
+  ASSERT_EQ(visited, std_map.size());
+}
+
+// Sends all the keys into the same few chains of slots
+struct CollidingHash {
+  std::size_t operator()(int key) const {
+    return static_cast<std::size_t>(key % 3);
+  }
+};
+
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view key) const {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+TEST(UnorderedMap, constructors) {
+  std::unordered_map<int, std::string> std_map{
+      {5, "five"}, {1, "one"}, {3, "three"}};
+  custom::UnorderedMap<int, std::string> s21_map{
+      {5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}};
+  CompareUnorderedMaps(std_map, s21_map);
+  custom::UnorderedMap<int, std::string> s21_range(std_map.begin(),
+                                                   std_map.end());
+  CompareUnorderedMaps(std_map, s21_range);
+  custom::UnorderedMap<int, std::string> s21_copy(s21_map);
+  CompareUnorderedMaps(std_map, s21_copy);
+  custom::UnorderedMap<int, std::string> s21_moved(std::move(s21_copy));
+  CompareUnorderedMaps(std_map, s21_moved);
+  ASSERT_TRUE(s21_copy.empty());
+  ASSERT_EQ(s21_copy.begin(), s21_copy.end());
+  s21_copy = s21_moved;
+  CompareUnorderedMaps(std_map, s21_copy);
+}
+
+TEST(UnorderedMap, element_access) {
+  custom::UnorderedMap<std::string, int> s21_map;
+  s21_map["b"] = 2;
+  s21_map["a"] += 1;
+  ASSERT_EQ(s21_map.at("a"), 1);
+  ASSERT_EQ(s21_map.at("b"), 2);
+  ASSERT_THROW(s21_map.at("c"), std::exception);
+  const auto &s21_const = s21_map;
+  ASSERT_EQ(s21_const.at("b"), 2);
+  ASSERT_EQ(s21_const.count("a"), 1UL);
+  ASSERT_EQ(s21_const.count("c"), 0UL);
+}
+
+TEST(UnorderedMap, insert_variants) {
+  custom::UnorderedMap<int, std::string> s21_map;
+  ASSERT_TRUE(s21_map.insert({1, "one"}).second);
+  ASSERT_FALSE(s21_map.insert(1, "uno").second);
+  ASSERT_TRUE(s21_map.insert(2, "two").second);
+  ASSERT_FALSE(s21_map.insert_or_assign(2, "dos").second);
+  ASSERT_TRUE(s21_map.insert_or_assign(4, "four").second);
+  ASSERT_TRUE(s21_map.try_emplace(3, 5UL, 'x').second);
+  ASSERT_FALSE(s21_map.try_emplace(3, 2UL, 'y').second);
+  ASSERT_FALSE(s21_map.emplace(3, "three").second);
+  auto it = s21_map.emplace(10, "ten").first;
+  (*it).second += "!";
+  ASSERT_EQ(s21_map.insert({{20, "a"}, {1, "b"}, {21, "c"}}), 2UL);
+  std::unordered_map<int, std::string> std_map{
+      {1, "one"}, {2, "dos"},  {3, "xxxxx"}, {4, "four"},
+      {10, "ten!"}, {20, "a"}, {21, "c"}};
+  CompareUnorderedMaps(std_map, s21_map);
+}
+
+TEST(UnorderedMap, random_operations) {
+  std::mt19937 generator(11);
+  std::unordered_map<int, int> std_map;
+  custom::UnorderedMap<int, int> s21_map;
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(generator() % 3000);
+    switch (generator() % 4) {
+    case 0:
+      ASSERT_EQ(std_map.insert({key, i}).second,
+                s21_map.insert({key, i}).second);
+      break;
+    case 1:
+      ASSERT_EQ(std_map.erase(key), s21_map.erase(key));
+      break;
+    case 2:
+      std_map[key] = i;
+      s21_map[key] = i;
+      break;
+    default:
+      ASSERT_EQ(std_map.count(key) == 1UL, s21_map.contains(key));
+    }
+  }
+  CompareUnorderedMaps(std_map, s21_map);
+}
+
+TEST(UnorderedMap, colliding_hashes) {
+  std::unordered_map<int, int> std_map;
+  custom::UnorderedMap<int, int, CollidingHash> s21_map;
+  for (int i = 0; i < 500; ++i) {
+    std_map[i] = i;
+    s21_map[i] = i;
+  }
+  for (int i = 0; i < 500; i += 2) {
+    std_map.erase(i);
+    s21_map.erase(i);
+  }
+  // the new pairs go through the tombstones of the erased ones
+  for (int i = 1000; i < 1100; ++i) {
+    std_map[i] = -i;
+    s21_map[i] = -i;
+  }
+  CompareUnorderedMaps(std_map, s21_map);
+  for (int i = 0; i < 500; i += 2)
+    ASSERT_EQ(s21_map.find(i), s21_map.end());
+}
+
+TEST(UnorderedMap, erase_keeps_iterators) {
+  custom::UnorderedMap<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i)
+    s21_map[i] = i;
+  auto kept = s21_map.find(777);
+  std::size_t erased = 0;
+  // erasure returns the next pair, so the whole map is walked once
+  for (auto i = s21_map.begin(); i != s21_map.end();) {
+    if ((*i).first % 2 == 0) {
+      i = s21_map.erase(i);
+      ++erased;
+    } else {
+      ++i;
+    }
+  }
+  ASSERT_EQ(erased, 500UL);
+  ASSERT_EQ((*kept).second, 777);
+  s21_map.erase(s21_map.begin(), s21_map.end());
+  ASSERT_TRUE(s21_map.empty());
+  ASSERT_EQ(s21_map.begin(), s21_map.end());
+}
+
+TEST(UnorderedMap, erase_if_and_clear) {
+  std::unordered_map<int, int> std_map;
+  custom::UnorderedMap<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) {
+    std_map.insert({i, -i});
+    s21_map.insert({i, -i});
+  }
+  auto is_odd = [](const auto &item) { return item.first % 2 == 1; };
+  ASSERT_EQ(custom::erase_if(s21_map, is_odd), 500UL);
+  for (auto i = std_map.begin(); i != std_map.end();)
+    i = is_odd(*i) ? std_map.erase(i) : std::next(i);
+  CompareUnorderedMaps(std_map, s21_map);
+  std::size_t capacity = s21_map.capacity();
+  s21_map.clear();
+  ASSERT_TRUE(s21_map.empty());
+  ASSERT_EQ(s21_map.capacity(), capacity);
+  ASSERT_FALSE(s21_map.contains(0));
+}
+
+TEST(UnorderedMap, reserve) {
+  custom::UnorderedMap<int, int> s21_map;
+  ASSERT_EQ(s21_map.capacity(), 0UL);
+  ASSERT_EQ(s21_map.memory_usage(), 0UL);
+  s21_map.reserve(1000);
+  std::size_t capacity = s21_map.capacity();
+  ASSERT_GE(capacity, 1000UL);
+  // capacity is one less than the power of two
+  ASSERT_EQ(capacity & (capacity + 1UL), 0UL);
+  auto first = s21_map.insert({0, 0}).first;
+  for (int i = 1; i < 1000; ++i)
+    s21_map[i] = i;
+  ASSERT_EQ(s21_map.capacity(), capacity);
+  ASSERT_EQ((*first).first, 0);
+  ASSERT_LE(s21_map.load_factor(), 0.875F);
+  s21_map.reserve(10);
+  ASSERT_EQ(s21_map.capacity(), capacity);
+}
+
+TEST(UnorderedMap, swap_and_merge) {
+  custom::UnorderedMap<int, int> s21_map1{{1, 1}, {3, 3}, {5, 5}};
+  custom::UnorderedMap<int, int> s21_map2{{2, 2}, {3, 30}, {4, 4}};
+  s21_map1.merge(s21_map2);
+  CompareUnorderedMaps(
+      std::unordered_map<int, int>{{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}},
+      s21_map1);
+  CompareUnorderedMaps(std::unordered_map<int, int>{{3, 30}}, s21_map2);
+  s21_map1.swap(s21_map2);
+  ASSERT_EQ(s21_map1.size(), 1UL);
+  ASSERT_EQ(s21_map2.size(), 5UL);
+}
+
+TEST(UnorderedMap, move_only) {
+  MoveOnlyCounter::instances = 0;
+  {
+    custom::UnorderedMap<int, MoveOnlyCounter> s21_map;
+    for (int i = 0; i < 300; ++i)
+      s21_map.try_emplace(i * 7 % 300, i);
+    for (int i = 0; i < 300; i += 3)
+      s21_map.erase(i);
+    ASSERT_EQ(MoveOnlyCounter::instances, static_cast<int>(s21_map.size()));
+    ASSERT_EQ(s21_map.at(1).value, 43);
+    custom::UnorderedMap<int, MoveOnlyCounter> s21_moved;
+    s21_moved = std::move(s21_map);
+    ASSERT_EQ(MoveOnlyCounter::instances, 200);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+}
+
+TEST(UnorderedMap, transparent_lookup) {
+  custom::UnorderedMap<std::string, int, StringHash, std::equal_to<>> s21_map{
+      {"apple", 1}, {"banana", 2}, {"cherry", 3}};
+  std::string_view key = "banana";
+  ASSERT_EQ((*s21_map.find(key)).second, 2);
+  ASSERT_TRUE(s21_map.contains(std::string_view("cherry")));
+  ASSERT_EQ(s21_map.count(std::string_view("durian")), 0UL);
+  ASSERT_EQ(s21_map.find("durian"), s21_map.end());
+  const auto &s21_const = s21_map;
+  ASSERT_EQ((*s21_const.find(std::string_view("apple"))).second, 1);
+}
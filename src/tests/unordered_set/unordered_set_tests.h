@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "../../associative_containers/unordered_set/custom_unordered_set.h"
+
+template <class K, class H, class E>
+void CompareUnorderedSets(const std::unordered_set<K> &std_set,
+                          const custom::UnorderedSet<K, H, E> &s21_set) {
+  ASSERT_EQ(std_set.size(), s21_set.size());
+  ASSERT_EQ(std_set.empty(), s21_set.empty());
+  std::size_t visited = 0;
+  for (auto s21_i = s21_set.begin(); s21_i != s21_set.end(); ++s21_i) {
+    ASSERT_EQ(std_set.count(*s21_i), 1UL);
+    ++visited;
+  }
+  ASSERT_EQ(visited, std_set.size());
+}
+
+TEST(UnorderedSet, constructors) {
+  std::unordered_set<int> std_set{5, 1, 3};
+  custom::UnorderedSet<int> s21_set{5, 1, 3, 1, 5};
+  CompareUnorderedSets(std_set, s21_set);
+  custom::UnorderedSet<int> s21_copy(s21_set);
+  CompareUnorderedSets(std_set, s21_copy);
+  custom::UnorderedSet<int> s21_moved(std::move(s21_copy));
+  CompareUnorderedSets(std_set, s21_moved);
+  ASSERT_TRUE(s21_copy.empty());
+  custom::UnorderedSet<int> s21_range(std_set.begin(), std_set.end());
+  CompareUnorderedSets(std_set, s21_range);
+}
+
+TEST(UnorderedSet, random_operations) {
+  std::mt19937 generator(13);
+  std::unordered_set<int> std_set;
+  custom::UnorderedSet<int> s21_set;
+  for (int i = 0; i < 50000; ++i) {
+    int value = static_cast<int>(generator() % 5000);
+    switch (generator() % 3) {
+    case 0:
+      ASSERT_EQ(std_set.insert(value).second, s21_set.insert(value).second);
+      break;
+    case 1:
+      ASSERT_EQ(std_set.erase(value), s21_set.erase(value));
+      break;
+    default:
+      ASSERT_EQ(std_set.count(value), s21_set.count(value));
+    }
+  }
+  CompareUnorderedSets(std_set, s21_set);
+}
+
+TEST(UnorderedSet, erase_and_merge) {
+  custom::UnorderedSet<int> s21_set;
+  for (int i = 0; i < 100; ++i)
+    s21_set.emplace(i);
+  for (auto i = s21_set.begin(); i != s21_set.end();)
+    i = *i % 10 ? std::next(i) : s21_set.erase(i);
+  ASSERT_EQ(s21_set.size(), 90UL);
+  ASSERT_EQ(custom::erase_if(s21_set, [](int value) { return value > 49; }),
+            45UL);
+  custom::UnorderedSet<int> s21_other{0, 1, 2, 100};
+  s21_set.merge(s21_other);
+  CompareUnorderedSets(std::unordered_set<int>{1, 2}, s21_other);
+  ASSERT_EQ(s21_set.size(), 47UL);
+  ASSERT_TRUE(s21_set.contains(100));
+  s21_set.erase(s21_set.begin(), s21_set.end());
+  ASSERT_TRUE(s21_set.empty());
+}
+
+TEST(UnorderedSet, transparent_lookup) {
+  struct Hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view key) const {
+      return std::hash<std::string_view>()(key);
+    }
+  };
+  custom::UnorderedSet<std::string, Hash, std::equal_to<>> s21_set{
+      "apple", "banana", "cherry"};
+  ASSERT_EQ(*s21_set.find(std::string_view("banana")), "banana");
+  ASSERT_TRUE(s21_set.contains(std::string_view("cherry")));
+  ASSERT_EQ(s21_set.count(std::string_view("durian")), 0UL);
+  s21_set.reserve(100);
+  ASSERT_GE(s21_set.capacity(), 100UL);
+  ASSERT_TRUE(s21_set.contains(std::string_view("apple")));
+}
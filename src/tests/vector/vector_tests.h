@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <vector>
 
 #include "../../sequence_containers/vector/custom_vector.h"
+#include "../move_only_counter.h"
 
 template <class T>
 void CompareTwoVectors(const custom::Vector<T> &s21_v,
@@ -559,4 +561,30 @@ TEST(Vector, emplace_back) {
   v1 = {1.0, 2.2};
   v1.emplace_back(3.0, 4.4, 5.0);
   CompareTwoVectors(v1, v2, true);
-}
\ No newline at end of file
+}
+
+TEST(Vector, move_only) {
+  {
+    custom::Vector<MoveOnlyCounter> s21_v;
+    for (int i = 0; i < 100; ++i)
+      s21_v.push_back(MoveOnlyCounter(i));
+    s21_v.emplace_back(MoveOnlyCounter(100), MoveOnlyCounter(101));
+    s21_v.insert(s21_v.begin(), MoveOnlyCounter(-1));
+    s21_v.emplace(s21_v.begin() + 1, MoveOnlyCounter(-2));
+    s21_v.erase(s21_v.begin() + 2);
+    s21_v.shrink_to_fit();
+    ASSERT_EQ(MoveOnlyCounter::instances, 103);
+    custom::Vector<MoveOnlyCounter> s21_moved(std::move(s21_v));
+    ASSERT_EQ(s21_moved.size(), 103UL);
+    ASSERT_EQ(s21_moved.front().value, -1);
+    ASSERT_EQ(s21_moved[1].value, -2);
+    ASSERT_EQ(s21_moved[2].value, 1);
+    ASSERT_EQ(s21_moved.back().value, 101);
+  }
+  ASSERT_EQ(MoveOnlyCounter::instances, 0);
+
+  custom::Vector<std::unique_ptr<int>> s21_pointers;
+  s21_pointers.push_back(std::make_unique<int>(5));
+  s21_pointers.emplace_back(std::make_unique<int>(6));
+  ASSERT_EQ(*s21_pointers[0] + *s21_pointers[1], 11);
+}